@@ -52,11 +52,15 @@ typedef double          float64_t;
 typedef unsigned char	byte;
 typedef char            sbyte;
 
+#if defined(_MSC_VER)
 #ifdef _WIN64
 #define ssize_t __int64
 #else
 #define ssize_t long
 #endif
+#else
+#include <sys/types.h>
+#endif
 
 #define U16_MAX  0xFFFF
 #define U32_MAX  0xFFFFFFFF
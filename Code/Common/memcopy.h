@@ -0,0 +1,206 @@
+﻿/*****************************************************************************
+ *  @file     Common/memcopy.h                                               *
+ *  @brief    Memory copy kernels used by the ring buffers.                  *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+#ifndef _INC_COMMON_memcopy_H
+#define _INC_COMMON_memcopy_H
+
+#include <string.h>
+#include "Common/datatypes.h"
+#include "Common/platform.h"
+
+/** @brief Largest copy (bytes) handled by the inline kernels; longer copies call `memcpy`. */
+#ifndef STARB_MEMCOPY_INLINE_MAX
+#define STARB_MEMCOPY_INLINE_MAX    256
+#endif
+
+/** @brief   Copy 0 ~ 16 bytes with (at most) two overlapping scalar moves.
+ *  @details Fixed-size `memcpy` calls compile to plain load / store instructions.
+ */
+static inline void STARB_MemCopy_Small(byte* dst, const byte* src, const size_t count)
+{
+    if (count >= 8)
+    {
+        uint64_t head, tail;
+        memcpy(&head, src, 8);
+        memcpy(&tail, src + count - 8, 8);
+        memcpy(dst, &head, 8);
+        memcpy(dst + count - 8, &tail, 8);
+    }
+    else if (count >= 4)
+    {
+        uint32_t head, tail;
+        memcpy(&head, src, 4);
+        memcpy(&tail, src + count - 4, 4);
+        memcpy(dst, &head, 4);
+        memcpy(dst + count - 4, &tail, 4);
+    }
+    else if (count >= 2)
+    {
+        uint16_t head, tail;
+        memcpy(&head, src, 2);
+        memcpy(&tail, src + count - 2, 2);
+        memcpy(dst, &head, 2);
+        memcpy(dst + count - 2, &tail, 2);
+    }
+    else if (count == 1)
+    {
+        *dst = *src;
+    }
+}
+
+/** @brief   Copy memory, specialized by size class.
+ *  @details - 0 ~ 16 bytes: overlapping scalar moves
+ *           - up to `STARB_MEMCOPY_INLINE_MAX` bytes: 16-byte SSE2 (or 8-byte scalar)
+ *             moves, the last one overlapping the previous
+ *           - longer: `memcpy`
+ *           The regions MUST NOT overlap.
+ *
+ *  @param[out] dst     Destination address
+ *  @param[in] src      Source address
+ *  @param[in] count    Length to copy (bytes)
+ */
+static inline void STARB_MemCopy(void* dst, const void* src, size_t count)
+{
+    byte* d = (byte*)dst;
+    const byte* s = (const byte*)src;
+
+    if (count <= 16)
+    {
+        STARB_MemCopy_Small(d, s, count);
+    }
+    else if (count <= STARB_MEMCOPY_INLINE_MAX)
+    {
+#if STARB_HAS_SSE2
+        __m128i tail = _mm_loadu_si128((const __m128i*)(s + count - 16));
+        while (count > 16)
+        {
+            _mm_storeu_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+            d += 16;
+            s += 16;
+            count -= 16;
+        }
+        _mm_storeu_si128((__m128i*)(d + count - 16), tail);
+#else
+        uint64_t tail, word;
+        memcpy(&tail, s + count - 8, 8);
+        while (count > 8)
+        {
+            memcpy(&word, s, 8);
+            memcpy(d, &word, 8);
+            d += 8;
+            s += 8;
+            count -= 8;
+        }
+        memcpy(d + count - 8, &tail, 8);
+#endif
+    }
+    else
+    {
+        memcpy(d, s, count);
+    }
+}
+
+/** @brief   Copy memory byte by byte, without any library call.
+ *  @details For interrupt / async-signal context: the compiler barrier in the
+ *           loop keeps the optimizer from turning it into a `memcpy` call.
+ *           Intended for short copies only.
+ *
+ *  @param[out] dst     Destination address
+ *  @param[in] src      Source address
+ *  @param[in] count    Length to copy (bytes)
+ */
+static inline void STARB_MemCopy_Isr(byte* dst, const byte* src, size_t count)
+{
+    while (count > 0)
+    {
+        *dst++ = *src++;
+        count--;
+        STARB_COMPILER_BARRIER();
+    }
+}
+
+/** @brief   Copy memory with non-temporal (cache bypassing) stores.
+ *  @details The destination head is copied with regular stores up to the
+ *           next 16-byte boundary, the aligned body is streamed, and the
+ *           remaining tail is copied with regular stores again.
+ *           The caller MUST issue `STARB_STORE_FENCE()` before publishing
+ *           the copied data to another agent.
+ *           Falls back to `memcpy` on targets without SSE2.
+ *
+ *  @param[out] dst     Destination address
+ *  @param[in] src      Source address
+ *  @param[in] count    Length to copy (bytes)
+ */
+static inline void STARB_MemCopy_Stream(void* dst, const void* src, size_t count)
+{
+#if STARB_HAS_SSE2
+    byte* d = (byte*)dst;
+    const byte* s = (const byte*)src;
+    size_t head = (size_t)(0 - (uintptr_t)d) & 15;
+
+    if (head > count)
+    {
+        head = count;
+    }
+
+    STARB_MemCopy_Small(d, s, head);
+    d += head;
+    s += head;
+    count -= head;
+
+    while (count >= 64)
+    {
+        __m128i x0 = _mm_loadu_si128((const __m128i*)(s + 0));
+        __m128i x1 = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i x2 = _mm_loadu_si128((const __m128i*)(s + 32));
+        __m128i x3 = _mm_loadu_si128((const __m128i*)(s + 48));
+        _mm_stream_si128((__m128i*)(d + 0), x0);
+        _mm_stream_si128((__m128i*)(d + 16), x1);
+        _mm_stream_si128((__m128i*)(d + 32), x2);
+        _mm_stream_si128((__m128i*)(d + 48), x3);
+        d += 64;
+        s += 64;
+        count -= 64;
+    }
+
+    while (count >= 16)
+    {
+        _mm_stream_si128((__m128i*)d, _mm_loadu_si128((const __m128i*)s));
+        d += 16;
+        s += 16;
+        count -= 16;
+    }
+
+    STARB_MemCopy_Small(d, s, count);
+#else
+    memcpy(dst, src, count);
+#endif
+}
+
+#endif // !_INC_COMMON_memcopy_H
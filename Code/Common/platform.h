@@ -0,0 +1,191 @@
+﻿/*****************************************************************************
+ *  @file     Common/platform.h                                              *
+ *  @brief    Compiler and CPU abstraction helpers.                          *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *  2026/10/19 | 0.1.1.0   | agent      | Add spin lock                      *
+ *  2026/10/19 | 0.1.2.0   | agent      | Add count trailing zeros           *
+ *  2026/10/19 | 0.1.3.0   | agent      | Add acquire / release fences       *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+#ifndef _INC_COMMON_platform_H
+#define _INC_COMMON_platform_H
+
+#include "Common/datatypes.h"
+
+/** @brief   Cache line size (bytes) used to isolate producer / consumer state.
+ *  @details Use 128 on targets whose prefetcher fetches cache lines in pairs
+ *           (e.g. recent Intel cores, Apple silicon).
+ */
+#ifndef STARB_CACHELINE
+#define STARB_CACHELINE     64
+#endif
+
+/** @brief Alignment specifier for variable declarations. */
+#if defined(_MSC_VER)
+#define STARB_ALIGNAS(n)    __declspec(align(n))
+#elif defined(__GNUC__) || defined(__clang__)
+#define STARB_ALIGNAS(n)    __attribute__((aligned(n)))
+#else
+#define STARB_ALIGNAS(n)
+#endif
+
+/** @brief SSE2 instruction set availability (x86 / x64 targets) */
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define STARB_HAS_SSE2      1
+#include <emmintrin.h>
+#else
+#define STARB_HAS_SSE2      0
+#endif
+
+/** @brief Compiler barrier: prevent the compiler from reordering memory accesses. */
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STARB_COMPILER_BARRIER()    _ReadWriteBarrier()
+#elif defined(__GNUC__) || defined(__clang__)
+#define STARB_COMPILER_BARRIER()    __asm__ __volatile__("" ::: "memory")
+#else
+#define STARB_COMPILER_BARRIER()
+#endif
+
+/** @brief Store fence: order all prior stores (including non-temporal stores)
+ *         before the following stores.
+ */
+#if STARB_HAS_SSE2
+#define STARB_STORE_FENCE()         _mm_sfence()
+#else
+#define STARB_STORE_FENCE()         STARB_COMPILER_BARRIER()
+#endif
+
+/** @brief Load with acquire semantics: later memory accesses are not hoisted above it. */
+static inline uint32_t STARB_LoadAcquire32(const volatile uint32_t* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    return __ldar32((volatile unsigned __int32*)ptr);
+#else
+    /* x86 / x64 are TSO: a compiler barrier is sufficient. */
+    uint32_t value = *ptr;
+    STARB_COMPILER_BARRIER();
+    return value;
+#endif
+}
+
+/** @brief Store with release semantics: earlier memory accesses are not sunk below it. */
+static inline void STARB_StoreRelease32(volatile uint32_t* ptr, const uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __stlr32((volatile unsigned __int32*)ptr, value);
+#else
+    /* x86 / x64 are TSO: a compiler barrier is sufficient. */
+    STARB_COMPILER_BARRIER();
+    *ptr = value;
+#endif
+}
+
+/** @brief Release fence: earlier memory accesses are ordered before later stores. */
+static inline void STARB_FenceRelease(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __dmb(_ARM64_BARRIER_ISH);
+#else
+    /* x86 / x64 are TSO: a compiler barrier is sufficient. */
+    STARB_COMPILER_BARRIER();
+#endif
+}
+
+/** @brief Acquire fence: earlier loads are ordered before later memory accesses. */
+static inline void STARB_FenceAcquire(void)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    __dmb(_ARM64_BARRIER_ISHLD);
+#else
+    /* x86 / x64 are TSO: a compiler barrier is sufficient. */
+    STARB_COMPILER_BARRIER();
+#endif
+}
+
+/** @brief Spin-wait hint for busy loops. */
+#if STARB_HAS_SSE2
+#define STARB_CPU_PAUSE()           _mm_pause()
+#else
+#define STARB_CPU_PAUSE()           STARB_COMPILER_BARRIER()
+#endif
+
+/** @brief Spin lock (0: free, 1: taken) for short critical sections. */
+typedef volatile uint32_t STARB_SpinLock;
+
+/** @brief Take the spin lock; acquire semantics. */
+static inline void STARB_SpinLock_Acquire(STARB_SpinLock* lock)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0)
+#elif defined(_MSC_VER)
+    while (_InterlockedExchange((volatile long*)lock, 1) != 0)
+#else
+#error "STARB_SpinLock: no atomic exchange for this compiler"
+#endif
+    {
+        while (STARB_LoadAcquire32(lock) != 0)
+        {
+            STARB_CPU_PAUSE();
+        }
+    }
+}
+
+/** @brief Give the spin lock back; release semantics. */
+static inline void STARB_SpinLock_Release(STARB_SpinLock* lock)
+{
+    STARB_StoreRelease32(lock, 0);
+}
+
+/** @brief Index of the lowest set bit (`value` must not be 0). */
+static inline uint32_t STARB_Ctz32(const uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(value);
+#elif defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, value);
+    return (uint32_t)index;
+#else
+    uint32_t index = 0;
+    while (((value >> index) & 1) == 0)
+    {
+        index++;
+    }
+    return index;
+#endif
+}
+
+#endif // !_INC_COMMON_platform_H
@@ -2,8 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include "StaticRingBuf.h"
+#include "Common/memcopy.h"
+
+#define STARB_MODE_MASK     (STARB_MODE_STREAM | STARB_MODE_NOMIRROR)
 
 static inline void StaticRingBuf_WriteItems_Core(StaticRingBuf* rbuf, byte* srcbuf, const STARB_CAPTYPE writecount);
+static inline void StaticRingBuf_WriteItems_Stream(StaticRingBuf* rbuf, byte* srcbuf, const STARB_CAPTYPE writecount);
+static inline void StaticRingBuf_ReadItems_Core(StaticRingBuf* rbuf, byte* outbuf, const STARB_CAPTYPE readcount);
+static void StaticRingBuf_Notify(StaticRingBuf* rbuf, const uint8_t event, const STARB_CAPTYPE pos, const STARB_CAPTYPE count);
 
 /** @brief   Initialize the StaticRingBuf instance.
  *  @details Initialize the StaticRingBuf instance, and link `buffer` to the given existent `_buffer` pointer.
@@ -42,6 +48,106 @@ uint8_t StaticRingBuf_Init(StaticRingBuf* rbuf, const STARB_STOSZTP total_buffer
     rbuf->rpos = 0;
     rbuf->flag.zeros = 0;
     rbuf->flag.cycle = 0;
+    rbuf->mode = STARB_MODE_DEFAULT;
+    rbuf->observer = NULL;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Initialize the StaticRingBuf instance with the given mode bits.
+ *  @details Without `STARB_MODE_NOMIRROR` this is StaticRingBuf_Init() followed by
+ *           StaticRingBuf_SetMode().
+ *           With `STARB_MODE_NOMIRROR` the logical capacity equals `total_buffer_size`
+ *           (1 ~ 0xFFFF bytes): no mirror region is kept, reads and writes crossing
+ *           the end of the storage are split in two copies, and zero-copy readers
+ *           use StaticRingBuf_GetReadSpans().
+ *
+ *  @param[out] rbuf             The StaticRingBuf instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *  @param[in] mode              Combination of STARB_MODE_xxx bits
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t StaticRingBuf_InitMode(StaticRingBuf* rbuf, const STARB_STOSZTP total_buffer_size, byte* _buffer, const uint8_t mode)
+{
+    uint8_t rc = STARB_OK;
+
+    if ((mode & ~STARB_MODE_MASK) != 0)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if ((mode & STARB_MODE_NOMIRROR) == 0)
+    {
+        rc = StaticRingBuf_Init(rbuf, total_buffer_size, _buffer);
+        if (rc == STARB_OK)
+        {
+            rbuf->mode = mode;
+        }
+        goto EXIT;
+    }
+
+    if (rbuf == NULL || _buffer == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (total_buffer_size < 1 || total_buffer_size > UINT16_MAX)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rbuf->buffer = _buffer;
+    rbuf->capacity = (STARB_CAPTYPE)total_buffer_size;
+    rbuf->wpos = 0;
+    rbuf->rpos = 0;
+    rbuf->flag.zeros = 0;
+    rbuf->flag.cycle = 0;
+    rbuf->mode = mode;
+    rbuf->observer = NULL;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Set the mode bits of the StaticRingBuf instance.
+ *  @details `STARB_MODE_STREAM`: writes of at least `STARB_STREAM_THRESHOLD` bytes
+ *           use non-temporal stores for both the main and the mirror region, so
+ *           bulk ingest does not evict the hot working set from the cache.
+ *           `STARB_MODE_NOMIRROR` is fixed at StaticRingBuf_InitMode() and cannot be changed.
+ *
+ *  @param[in] rbuf The StaticRingBuf instance
+ *  @param[in] mode Combination of STARB_MODE_xxx bits
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t StaticRingBuf_SetMode(StaticRingBuf* rbuf, const uint8_t mode)
+{
+    uint8_t rc = STARB_OK;
+
+    if (rbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if ((mode & ~STARB_MODE_MASK) != 0 ||
+        (mode & STARB_MODE_NOMIRROR) != (rbuf->mode & STARB_MODE_NOMIRROR))
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rbuf->mode = mode;
 
 EXIT:
     return rc;
@@ -126,11 +232,15 @@ uint8_t StaticRingBuf_Write(StaticRingBuf* rbuf, const byte _elem)
         goto EXIT;
     }
 
-    rbuf->buffer[rbuf->wpos] = _elem;
-    size_t mirror_offset = (size_t)rbuf->wpos + (size_t)rbuf->capacity;
-    rbuf->buffer[mirror_offset] = _elem;
+    STARB_CAPTYPE wpos = rbuf->wpos;
+    rbuf->buffer[wpos] = _elem;
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) == 0)
+    {
+        size_t mirror_offset = (size_t)wpos + (size_t)rbuf->capacity;
+        rbuf->buffer[mirror_offset] = _elem;
+    }
 
-    if (rbuf->flag.cycle == 0 && (rbuf->wpos + 1) >= rbuf->capacity)
+    if (rbuf->flag.cycle == 0 && (wpos + 1) >= rbuf->capacity)
     {
         rbuf->flag.cycle = 1;
         rbuf->wpos = 0;
@@ -140,6 +250,11 @@ uint8_t StaticRingBuf_Write(StaticRingBuf* rbuf, const byte _elem)
         rbuf->wpos++;
     }
 
+    if (rbuf->observer != NULL)
+    {
+        StaticRingBuf_Notify(rbuf, STARB_EVENT_ENTER, wpos, 1);
+    }
+
 EXIT:
     return rc;
 }
@@ -201,7 +316,47 @@ EXIT:
  */
 uint8_t StaticRingBuf_Read(StaticRingBuf* rbuf, byte* _elem)
 {
-    return StaticRingBuf_ReadItems(rbuf, _elem, 1);
+    uint8_t rc = STARB_OK;
+
+    if (rbuf == NULL || _elem == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE read_capacity = StaticRingBuf_GetReadCapacity(rbuf);
+    if (read_capacity <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE rpos = rbuf->rpos;
+    if (rpos >= rbuf->capacity - 1)
+    {
+        if (rbuf->flag.cycle == 0)
+        {
+            rc = STARB_DATAINVALID;
+            goto EXIT;
+        }
+
+        *_elem = rbuf->buffer[rbuf->rpos];
+        rbuf->rpos = 0;
+        rbuf->flag.cycle = 0;
+    }
+    else
+    {
+        *_elem = rbuf->buffer[rbuf->rpos];
+        rbuf->rpos++;
+    }
+
+    if (rbuf->observer != NULL)
+    {
+        StaticRingBuf_Notify(rbuf, STARB_EVENT_LEAVE, rpos, 1);
+    }
+
+EXIT:
+    return rc;
 }
 
 /** @brief Read bytes from the StaticRingBuf instance's storage buffer.
@@ -263,9 +418,15 @@ uint8_t StaticRingBuf_ReadItems(StaticRingBuf* rbuf, byte* outbuf, const STARB_C
         rpos_next = rbuf->rpos + readcount;
     }
 
-    memcpy(outbuf, (rbuf->buffer + rbuf->rpos), readcount);
+    StaticRingBuf_ReadItems_Core(rbuf, outbuf, readcount);
+    STARB_CAPTYPE rpos = rbuf->rpos;
     rbuf->rpos = rpos_next;
 
+    if (rbuf->observer != NULL)
+    {
+        StaticRingBuf_Notify(rbuf, STARB_EVENT_LEAVE, rpos, readcount);
+    }
+
 EXIT:
     return rc;
 }
@@ -316,24 +477,106 @@ uint8_t StaticRingBuf_PeekItems(StaticRingBuf* rbuf, byte* outbuf, const STARB_C
         goto EXIT;
     }
 
-    memcpy(outbuf, (rbuf->buffer + rbuf->rpos), readcount);
+    StaticRingBuf_ReadItems_Core(rbuf, outbuf, readcount);
 
 EXIT:
     return rc;
 }
 
-/** @brief Get reading pointer of the StaticRingBuf instance. */
+/** @brief Get reading pointer of the StaticRingBuf instance.
+ *  @note  With `STARB_MODE_NOMIRROR` only `capacity - rpos` bytes are contiguous.
+ */
 byte* StaticRingBuf_GetReadPtr(StaticRingBuf* rbuf)
 {
     return rbuf->buffer + rbuf->rpos;
 }
 
+/** @brief   Get the readable data of the StaticRingBuf instance as contiguous spans.
+ *  @details Mirrored storage always yields 1 span; `STARB_MODE_NOMIRROR` yields
+ *           2 spans when the data wraps around the end of the storage.
+ *
+ *  @param[in] rbuf    The StaticRingBuf instance
+ *  @param[out] spans  Array of 2 spans to receive the readable regions
+ *  @return Count of spans filled (0 ~ 2)
+ */
+uint8_t StaticRingBuf_GetReadSpans(StaticRingBuf* rbuf, STARB_Span spans[2])
+{
+    uint8_t count = 0;
+
+    if (rbuf == NULL || spans == NULL)
+    {
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE read_capacity = StaticRingBuf_GetReadCapacity(rbuf);
+    if (read_capacity <= 0)
+    {
+        goto EXIT;
+    }
+
+    spans[0].ptr = rbuf->buffer + rbuf->rpos;
+    spans[0].len = read_capacity;
+    count = 1;
+
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) && read_capacity > rbuf->capacity - rbuf->rpos)
+    {
+        spans[0].len = rbuf->capacity - rbuf->rpos;
+        spans[1].ptr = rbuf->buffer;
+        spans[1].len = read_capacity - spans[0].len;
+        count = 2;
+    }
+
+EXIT:
+    return count;
+}
+
 /** @brief Get writing pointer of the StaticRingBuf instance. */
 byte* StaticRingBuf_GetWritePtr(StaticRingBuf* rbuf)
 {
     return rbuf->buffer + rbuf->wpos;
 }
 
+/** @brief   Get the most recently written `windowsize` bytes as one contiguous array.
+ *  @details Sliding-window view for filters and detectors: the window ends at the
+ *           write position and covers consumed and unread bytes alike; nothing is
+ *           copied and no index moves. The mirror keeps the window contiguous
+ *           (`buffer + wpos + capacity - windowsize`); it stays valid until the
+ *           next write. Bytes not written since init read as the initial storage
+ *           contents (zero history for a zeroed buffer).
+ *
+ *  @param[in] rbuf       The StaticRingBuf instance
+ *  @param[in] windowsize Window length (1 ~ capacity)
+ *  @return Pointer to the oldest byte of the window; NULL on invalid parameters,
+ *          or with `STARB_MODE_NOMIRROR` when the window wraps around the end
+ *          of the storage.
+ */
+byte* StaticRingBuf_GetWindow(StaticRingBuf* rbuf, const STARB_CAPTYPE windowsize)
+{
+    byte* window = NULL;
+
+    if (rbuf == NULL || windowsize <= 0 || windowsize > rbuf->capacity)
+    {
+        goto EXIT;
+    }
+
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) == 0)
+    {
+        window = rbuf->buffer + ((size_t)rbuf->wpos + rbuf->capacity - windowsize);
+    }
+    else if (rbuf->wpos == 0)
+    {
+        /* The last write ended exactly at the end of the storage. */
+        window = rbuf->buffer + (rbuf->capacity - windowsize);
+    }
+    else if (windowsize <= rbuf->wpos)
+    {
+        window = rbuf->buffer + (rbuf->wpos - windowsize);
+    }
+
+EXIT:
+    return window;
+}
+
 /** @brief Move reading pointer forward (skip bytes) for the StaticRingBuf instance.
  *
  *  @param[in] rbuf      The StaticRingBuf instance
@@ -373,7 +616,8 @@ uint8_t StaticRingBuf_Forward(StaticRingBuf* rbuf, const STARB_CAPTYPE skipcount
         goto EXIT;
     }
 
-    if (rbuf->rpos >= rbuf->capacity - skipcount)
+    STARB_CAPTYPE rpos = rbuf->rpos;
+    if (rpos >= rbuf->capacity - skipcount)
     {
         if (rbuf->flag.cycle == 0)
         {
@@ -391,6 +635,11 @@ uint8_t StaticRingBuf_Forward(StaticRingBuf* rbuf, const STARB_CAPTYPE skipcount
         rbuf->rpos += skipcount;
     }
 
+    if (rbuf->observer != NULL)
+    {
+        StaticRingBuf_Notify(rbuf, STARB_EVENT_LEAVE, rpos, skipcount);
+    }
+
 EXIT:
     return rc;
 }
@@ -446,9 +695,19 @@ uint8_t StaticRingBuf_ForceWriteItemsWithLog(
     pOverwrite->count = forcelength;
     pOverwrite->pos = rbuf->rpos;
     pOverwrite->dataptr = &rbuf->buffer[rbuf->rpos];
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) && forcelength > rbuf->capacity - rbuf->rpos)
+    {
+        /* No mirror: the lost data wraps, log it as two contiguous pieces. */
+        pOverwrite->count = rbuf->capacity - rbuf->rpos;
+        logcallback(pOverwrite);
+        pOverwrite->count = forcelength - pOverwrite->count;
+        pOverwrite->pos = 0;
+        pOverwrite->dataptr = rbuf->buffer;
+    }
     logcallback(pOverwrite);
 
-    if (rbuf->rpos >= rbuf->capacity - forcelength)
+    STARB_CAPTYPE rpos = rbuf->rpos;
+    if (rpos >= rbuf->capacity - forcelength)
     {
         rbuf->rpos -= (rbuf->capacity - forcelength);
         rbuf->flag.cycle = 0;
@@ -458,6 +717,11 @@ uint8_t StaticRingBuf_ForceWriteItemsWithLog(
         rbuf->rpos += forcelength;
     }
 
+    if (rbuf->observer != NULL)
+    {
+        StaticRingBuf_Notify(rbuf, STARB_EVENT_LEAVE, rpos, forcelength);
+    }
+
 WriteItems_Core:
     StaticRingBuf_WriteItems_Core(rbuf, srcbuf, writecount);
 
@@ -465,23 +729,124 @@ EXIT:
     return rc;
 }
 
+/** @brief   Attach an observer to the StaticRingBuf instance.
+ *  @details The observer's `notify` is called with `STARB_EVENT_ENTER` for bytes
+ *           written (Write, WriteItems, ForceWriteItemsWithLog) and with
+ *           `STARB_EVENT_LEAVE` for bytes read, skipped or overwritten (Read,
+ *           ReadItems, Forward, ForceWriteItemsWithLog), once per contiguous
+ *           piece, after the indexes have moved. Overwritten bytes are reported
+ *           before the new data replaces them. Observers are called in attach
+ *           order; a callback must not move the indexes of the same instance.
+ *           StaticRingBuf_Init() / InitMode() detach all observers.
+ *
+ *  @param[in] rbuf     The StaticRingBuf instance
+ *  @param[in] observer The observer (`notify` set, not attached elsewhere)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (already attached).
+ */
+uint8_t StaticRingBuf_AddObserver(StaticRingBuf* rbuf, STARB_Observer* observer)
+{
+    uint8_t rc = STARB_OK;
+
+    if (rbuf == NULL || observer == NULL || observer->notify == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    STARB_Observer** link = &rbuf->observer;
+    while (*link != NULL)
+    {
+        if (*link == observer)
+        {
+            rc = STARB_PARAMOUTRANGE;
+            goto EXIT;
+        }
+        link = &(*link)->next;
+    }
+
+    observer->next = NULL;
+    *link = observer;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Detach an observer from the StaticRingBuf instance.
+ *
+ *  @param[in] rbuf     The StaticRingBuf instance
+ *  @param[in] observer The observer
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+ */
+uint8_t StaticRingBuf_RemoveObserver(StaticRingBuf* rbuf, STARB_Observer* observer)
+{
+    uint8_t rc = STARB_PARAMOUTRANGE;
+
+    if (rbuf == NULL || observer == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    for (STARB_Observer** link = &rbuf->observer; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == observer)
+        {
+            *link = observer->next;
+            observer->next = NULL;
+            rc = STARB_OK;
+            break;
+        }
+    }
+
+EXIT:
+    return rc;
+}
+
 static inline void StaticRingBuf_WriteItems_Core(StaticRingBuf* rbuf, byte* srcbuf, const STARB_CAPTYPE writecount)
 {
-    byte* dst = rbuf->buffer + rbuf->wpos;
-    memcpy((void*)dst, srcbuf, writecount);
-    if (rbuf->wpos <= rbuf->capacity - writecount)
+    STARB_CAPTYPE wpos = rbuf->wpos;
+
+    if ((rbuf->mode & STARB_MODE_STREAM) && writecount >= STARB_STREAM_THRESHOLD)
     {
-        dst += rbuf->capacity;
-        memcpy((void*)dst, srcbuf, writecount);
+        StaticRingBuf_WriteItems_Stream(rbuf, srcbuf, writecount);
     }
-    else
+    else if (rbuf->mode & STARB_MODE_NOMIRROR)
     {
         STARB_CAPTYPE countL = rbuf->capacity - rbuf->wpos;
-        dst += rbuf->capacity;
-        memcpy((void*)dst, srcbuf, countL);
-        size_t countR = (size_t)rbuf->wpos + (size_t)writecount - (size_t)rbuf->capacity;
-        byte* src = rbuf->buffer + rbuf->capacity;
-        memcpy((void*)rbuf->buffer, src, countR);
+        if (countL >= writecount)
+        {
+            STARB_MemCopy(rbuf->buffer + rbuf->wpos, srcbuf, writecount);
+        }
+        else
+        {
+            STARB_MemCopy(rbuf->buffer + rbuf->wpos, srcbuf, countL);
+            STARB_MemCopy(rbuf->buffer, srcbuf + countL, (STARB_CAPTYPE)(writecount - countL));
+        }
+    }
+    else
+    {
+        byte* dst = rbuf->buffer + rbuf->wpos;
+        STARB_MemCopy((void*)dst, srcbuf, writecount);
+        if (rbuf->wpos <= rbuf->capacity - writecount)
+        {
+            dst += rbuf->capacity;
+            STARB_MemCopy((void*)dst, srcbuf, writecount);
+        }
+        else
+        {
+            STARB_CAPTYPE countL = rbuf->capacity - rbuf->wpos;
+            dst += rbuf->capacity;
+            STARB_MemCopy((void*)dst, srcbuf, countL);
+            size_t countR = (size_t)rbuf->wpos + (size_t)writecount - (size_t)rbuf->capacity;
+            byte* src = rbuf->buffer + rbuf->capacity;
+            STARB_MemCopy((void*)rbuf->buffer, src, countR);
+        }
     }
 
     if (rbuf->wpos >= rbuf->capacity - writecount)
@@ -493,4 +858,76 @@ static inline void StaticRingBuf_WriteItems_Core(StaticRingBuf* rbuf, byte* srcb
     {
         rbuf->wpos = rbuf->wpos + writecount;
     }
+
+    if (rbuf->observer != NULL)
+    {
+        StaticRingBuf_Notify(rbuf, STARB_EVENT_ENTER, wpos, writecount);
+    }
 }
+
+/** @brief Streaming variant of the main + mirror copy.
+ *  @note  The wrapped part is copied from `srcbuf` rather than from the mirror region:
+ *         reading back freshly streamed lines would pull them into the cache again.
+ *         The store fence orders the non-temporal stores before `wpos` is published.
+ */
+static inline void StaticRingBuf_WriteItems_Stream(StaticRingBuf* rbuf, byte* srcbuf, const STARB_CAPTYPE writecount)
+{
+    byte* dst = rbuf->buffer + rbuf->wpos;
+    STARB_CAPTYPE countL = rbuf->capacity - rbuf->wpos;
+
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) == 0)
+    {
+        STARB_MemCopy_Stream(dst, srcbuf, writecount);
+        dst += rbuf->capacity;
+    }
+
+    if (countL >= writecount)
+    {
+        STARB_MemCopy_Stream(dst, srcbuf, writecount);
+    }
+    else
+    {
+        STARB_MemCopy_Stream(dst, srcbuf, countL);
+        STARB_MemCopy_Stream(rbuf->buffer, srcbuf + countL, (size_t)writecount - countL);
+    }
+    STARB_STORE_FENCE();
+}
+
+/** @brief Copy `readcount` bytes from the read position; split in two without the mirror. */
+static inline void StaticRingBuf_ReadItems_Core(StaticRingBuf* rbuf, byte* outbuf, const STARB_CAPTYPE readcount)
+{
+    STARB_CAPTYPE countL = rbuf->capacity - rbuf->rpos;
+
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) == 0 || countL >= readcount)
+    {
+        STARB_MemCopy(outbuf, (rbuf->buffer + rbuf->rpos), readcount);
+    }
+    else
+    {
+        STARB_MemCopy(outbuf, (rbuf->buffer + rbuf->rpos), countL);
+        STARB_MemCopy(outbuf + countL, rbuf->buffer, (STARB_CAPTYPE)(readcount - countL));
+    }
+}
+
+/** @brief   Report `count` bytes from index `pos` to the attached observers.
+ *  @details Mirrored storage keeps them contiguous; without the mirror a
+ *           wrapped range is reported as two pieces.
+ */
+static void StaticRingBuf_Notify(StaticRingBuf* rbuf, const uint8_t event, const STARB_CAPTYPE pos, const STARB_CAPTYPE count)
+{
+    STARB_CAPTYPE countL = count;
+
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) && count > rbuf->capacity - pos)
+    {
+        countL = rbuf->capacity - pos;
+    }
+
+    for (STARB_Observer* observer = rbuf->observer; observer != NULL; observer = observer->next)
+    {
+        observer->notify(rbuf, observer, event, rbuf->buffer + pos, countL);
+        if (countL < count)
+        {
+            observer->notify(rbuf, observer, event, rbuf->buffer, (STARB_CAPTYPE)(count - countL));
+        }
+    }
+}
\ No newline at end of file
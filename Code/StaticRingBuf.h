@@ -51,12 +51,28 @@ typedef uint32_t STARB_STOSZTP;
 
 /** @brief Tech Decision Macros */
 
+/** @brief Minimum write length (bytes) to use non-temporal stores in streaming mode */
+#ifndef STARB_STREAM_THRESHOLD
+#define STARB_STREAM_THRESHOLD  4096
+#endif
+
+/** @brief Ring buffer mode bits */
+#define STARB_MODE_DEFAULT  0x00
+#define STARB_MODE_STREAM   0x01    // Large writes bypass the cache (non-temporal stores)
+#define STARB_MODE_NOMIRROR 0x02    // Physical buffer == capacity, wrapped data is split in two spans
+
+/** @brief Observer events */
+#define STARB_EVENT_ENTER   0x01    // Bytes were written
+#define STARB_EVENT_LEAVE   0x02    // Bytes were read, skipped or overwritten
+
 /** @brief Ring buffer flag structure */
 typedef struct _STARB_Flag_t {
     uint8_t zeros  : 7;
     uint8_t cycle  : 1;
 } STARB_Flag;
 
+typedef struct _STARB_Observer_t STARB_Observer;
+
 /** \brief  Struct definition for the Static Ring Buffer.
  * \details The Static Ring Buffer is a kind of circular buffer.
  */
@@ -67,9 +83,29 @@ typedef struct _StaticRingBuf_t
     volatile STARB_CAPTYPE wpos;    // Write position index (base 0)
     volatile STARB_CAPTYPE rpos;    // Read  position index (base 0)
     volatile STARB_Flag    flag;    // The flag (status)
+    uint8_t mode;                   // Mode bits (STARB_MODE_xxx)
+    STARB_Observer* observer;       // First attached observer (NULL: none)
 
 } StaticRingBuf;
 
+/** @brief Observer callback: `count` bytes at `data` entered or left `rbuf` (`event`: STARB_EVENT_xxx). */
+typedef void (*STARB_ObserverFunc)(StaticRingBuf* rbuf, STARB_Observer* observer,
+    const uint8_t event, const byte* data, const STARB_CAPTYPE count);
+
+/** @brief   Observer of the bytes entering and leaving a StaticRingBuf instance.
+ *  @details Embed it as the first member of the observer's own state.
+ */
+struct _STARB_Observer_t {
+    STARB_ObserverFunc notify;      // Callback
+    STARB_Observer* next;           // Next attached observer (managed by the ring)
+};
+
+/** @brief Contiguous memory span of the ring buffer storage */
+typedef struct _STARB_Span_t {
+    byte* ptr;
+    STARB_CAPTYPE len;
+} STARB_Span;
+
 /** @brief Ring buffer lost data structure */
 typedef struct _STARB_Lostdata_t {
     byte* dataptr;
@@ -101,6 +137,41 @@ extern "C" {
      */
     uint8_t StaticRingBuf_Init(StaticRingBuf* rbuf, const STARB_STOSZTP total_buffer_size, byte* _buffer);
 
+    /** @brief   Initialize the StaticRingBuf instance with the given mode bits.
+     *  @details Without `STARB_MODE_NOMIRROR` this is StaticRingBuf_Init() followed by
+     *           StaticRingBuf_SetMode().
+     *           With `STARB_MODE_NOMIRROR` the logical capacity equals `total_buffer_size`
+     *           (1 ~ 0xFFFF bytes): no mirror region is kept, reads and writes crossing
+     *           the end of the storage are split in two copies, and zero-copy readers
+     *           use StaticRingBuf_GetReadSpans().
+     *
+     *  @param[out] rbuf             The StaticRingBuf instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *  @param[in] mode              Combination of STARB_MODE_xxx bits
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t StaticRingBuf_InitMode(StaticRingBuf* rbuf, const STARB_STOSZTP total_buffer_size, byte* _buffer, const uint8_t mode);
+
+    /** @brief   Set the mode bits of the StaticRingBuf instance.
+     *  @details `STARB_MODE_STREAM`: writes of at least `STARB_STREAM_THRESHOLD` bytes
+     *           use non-temporal stores for both the main and the mirror region, so
+     *           bulk ingest does not evict the hot working set from the cache.
+     *
+     *           `STARB_MODE_NOMIRROR` is fixed at StaticRingBuf_InitMode() and cannot be changed.
+     *
+     *  @param[in] rbuf The StaticRingBuf instance
+     *  @param[in] mode Combination of STARB_MODE_xxx bits
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t StaticRingBuf_SetMode(StaticRingBuf* rbuf, const uint8_t mode);
+
     /** @brief Get writing capacity of the StaticRingBuf instance.
      *
      *  @param[in] rbuf The StaticRingBuf instance
@@ -179,12 +250,40 @@ extern "C" {
      */
     uint8_t StaticRingBuf_PeekItems(StaticRingBuf* rbuf, byte* outbuf, const STARB_CAPTYPE readcount);
 
-    /** @brief Get reading pointer of the StaticRingBuf instance. */
+    /** @brief Get reading pointer of the StaticRingBuf instance.
+     *  @note  With `STARB_MODE_NOMIRROR` only `capacity - rpos` bytes are contiguous.
+     */
     byte* StaticRingBuf_GetReadPtr(StaticRingBuf* rbuf);
 
+    /** @brief   Get the readable data of the StaticRingBuf instance as contiguous spans.
+     *  @details Mirrored storage always yields 1 span; `STARB_MODE_NOMIRROR` yields
+     *           2 spans when the data wraps around the end of the storage.
+     *
+     *  @param[in] rbuf    The StaticRingBuf instance
+     *  @param[out] spans  Array of 2 spans to receive the readable regions
+     *  @return Count of spans filled (0 ~ 2)
+     */
+    uint8_t StaticRingBuf_GetReadSpans(StaticRingBuf* rbuf, STARB_Span spans[2]);
+
     /** @brief Get writing pointer of the StaticRingBuf instance. */
     byte* StaticRingBuf_GetWritePtr(StaticRingBuf* rbuf);
 
+    /** @brief   Get the most recently written `windowsize` bytes as one contiguous array.
+     *  @details Sliding-window view for filters and detectors: the window ends at the
+     *           write position and covers consumed and unread bytes alike; nothing is
+     *           copied and no index moves. The mirror keeps the window contiguous
+     *           (`buffer + wpos + capacity - windowsize`); it stays valid until the
+     *           next write. Bytes not written since init read as the initial storage
+     *           contents (zero history for a zeroed buffer).
+     *
+     *  @param[in] rbuf       The StaticRingBuf instance
+     *  @param[in] windowsize Window length (1 ~ capacity)
+     *  @return Pointer to the oldest byte of the window; NULL on invalid parameters,
+     *          or with `STARB_MODE_NOMIRROR` when the window wraps around the end
+     *          of the storage.
+     */
+    byte* StaticRingBuf_GetWindow(StaticRingBuf* rbuf, const STARB_CAPTYPE windowsize);
+
     /** @brief Move reading pointer forward (skip bytes) for the StaticRingBuf instance.
      *
      *  @param[in] rbuf      The StaticRingBuf instance
@@ -202,6 +301,36 @@ extern "C" {
         StaticRingBuf* rbuf, byte* srcbuf, const STARB_CAPTYPE writecount,
         STARB_Lostdata* pOverwrite, STARB_LostdataLogFunc logcallback);
 
+    /** @brief   Attach an observer to the StaticRingBuf instance.
+     *  @details The observer's `notify` is called with `STARB_EVENT_ENTER` for bytes
+     *           written (Write, WriteItems, ForceWriteItemsWithLog) and with
+     *           `STARB_EVENT_LEAVE` for bytes read, skipped or overwritten (Read,
+     *           ReadItems, Forward, ForceWriteItemsWithLog), once per contiguous
+     *           piece, after the indexes have moved. Overwritten bytes are reported
+     *           before the new data replaces them. Observers are called in attach
+     *           order; a callback must not move the indexes of the same instance.
+     *           StaticRingBuf_Init() / InitMode() detach all observers.
+     *
+     *  @param[in] rbuf     The StaticRingBuf instance
+     *  @param[in] observer The observer (`notify` set, not attached elsewhere)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (already attached).
+     */
+    uint8_t StaticRingBuf_AddObserver(StaticRingBuf* rbuf, STARB_Observer* observer);
+
+    /** @brief Detach an observer from the StaticRingBuf instance.
+     *
+     *  @param[in] rbuf     The StaticRingBuf instance
+     *  @param[in] observer The observer
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+     */
+    uint8_t StaticRingBuf_RemoveObserver(StaticRingBuf* rbuf, STARB_Observer* observer);
+
 #ifdef __cplusplus
 } // ! extern "C"
 #endif
@@ -0,0 +1,326 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf.hpp                                              *
+ *  @brief    C++20 coroutine awaitables for StaticRingBuf                   *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_HPP
+#define _INC_GH2025_StaticRingBuf_HPP
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <span>
+#include "StaticRingBuf.h"
+
+namespace starb
+{
+    /** @brief   Executor hook: queue `handle` to be resumed by the executor.
+     *  @details Called from inside the ring's commit path, so it must only queue
+     *           the handle, never resume it inline.
+     */
+    using PostFunc = void (*)(void* context, std::coroutine_handle<> handle);
+
+    /** \brief  Coroutine adapter over a StaticRingBuf instance.
+     * \details `co_await ring.read(outbuf)` / `co_await ring.write(srcbuf)` transfer
+     *          the whole buffer at once (StaticRingBuf_ReadItems() / WriteItems())
+     *          and suspend while there is not enough data / space. The adapter is
+     *          a ring observer: every commit on the other side (through the
+     *          adapter or through the C API) re-checks the first waiter and posts
+     *          it to the executor once its transfer fits. No thread blocks and
+     *          nothing polls; a suspended transfer costs a few words in the
+     *          coroutine frame.
+     *
+     *          Waiters on each side are served in FIFO order; space / data
+     *          promised to posted waiters is reserved until they run, so a later
+     *          `co_await` cannot take it. Reads (writes) that bypass the adapter
+     *          can still take it, in which case the woken transfer reports
+     *          0xE5 (0xE4) and the next waiter is re-checked against what is
+     *          left.
+     *
+     *          Not thread-safe: a Ring and its StaticRingBuf are used from one
+     *          executor thread (or strand) at a time. The Ring must outlive its
+     *          suspended transfers.
+     */
+    class Ring
+    {
+    private:
+        /** @brief Suspended transfer (lives in the awaiter, in the coroutine frame) */
+        struct Waiter
+        {
+            Waiter* next = nullptr;                 // Next waiter of the same side
+            std::coroutine_handle<> handle;         // Coroutine to resume
+            STARB_CAPTYPE count = 0;                // Bytes the transfer needs
+            bool posted = false;                    // Handed to the executor
+        };
+
+        /** @brief FIFO of the waiters of one side */
+        struct Queue
+        {
+            Waiter* head = nullptr;
+            Waiter* tail = nullptr;
+            STARB_CAPTYPE reserved = 0;             // Bytes promised to posted waiters
+        };
+
+        /** @brief Observer registered with the ring */
+        struct Hook
+        {
+            STARB_Observer observer;                // First member
+            Ring* owner;
+        };
+
+    public:
+        /** @brief Awaitable read of `outbuf.size()` bytes; resumes with the STARB_xxx status. */
+        class ReadAwaiter
+        {
+        public:
+            bool await_ready() const noexcept
+            {
+                return ring_.Ready(ring_.readers_, StaticRingBuf_GetReadCapacity(ring_.rbuf_), size_);
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                ring_.Suspend(ring_.readers_, waiter_, handle, size_);
+            }
+
+            uint8_t await_resume() noexcept
+            {
+                uint8_t rc = STARB_PARAMOUTRANGE;
+
+                ring_.Resumed(ring_.readers_, waiter_);
+                if (size_ <= ring_.rbuf_->capacity)
+                {
+                    rc = StaticRingBuf_ReadItems(ring_.rbuf_, outbuf_, static_cast<STARB_CAPTYPE>(size_));
+                }
+
+                if (rc != STARB_OK)
+                {
+                    /* No commit, no notification: hand the released reservation on. */
+                    ring_.Wake(ring_.readers_, StaticRingBuf_GetReadCapacity(ring_.rbuf_));
+                }
+
+                return rc;
+            }
+
+        private:
+            friend class Ring;
+
+            ReadAwaiter(Ring& ring, std::span<byte> outbuf) noexcept
+                : ring_(ring), outbuf_(outbuf.data()), size_(outbuf.size())
+            {
+            }
+
+            Ring& ring_;
+            byte* outbuf_;
+            std::size_t size_;
+            Waiter waiter_;
+        };
+
+        /** @brief Awaitable write of `srcbuf.size()` bytes; resumes with the STARB_xxx status. */
+        class WriteAwaiter
+        {
+        public:
+            bool await_ready() const noexcept
+            {
+                return ring_.Ready(ring_.writers_, StaticRingBuf_GetWriteCapacity(ring_.rbuf_), size_);
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                ring_.Suspend(ring_.writers_, waiter_, handle, size_);
+            }
+
+            uint8_t await_resume() noexcept
+            {
+                uint8_t rc = STARB_PARAMOUTRANGE;
+
+                ring_.Resumed(ring_.writers_, waiter_);
+                if (size_ <= ring_.rbuf_->capacity)
+                {
+                    rc = StaticRingBuf_WriteItems(ring_.rbuf_, const_cast<byte*>(srcbuf_), static_cast<STARB_CAPTYPE>(size_));
+                }
+
+                if (rc != STARB_OK)
+                {
+                    /* No commit, no notification: hand the released reservation on. */
+                    ring_.Wake(ring_.writers_, StaticRingBuf_GetWriteCapacity(ring_.rbuf_));
+                }
+
+                return rc;
+            }
+
+        private:
+            friend class Ring;
+
+            WriteAwaiter(Ring& ring, std::span<const byte> srcbuf) noexcept
+                : ring_(ring), srcbuf_(srcbuf.data()), size_(srcbuf.size())
+            {
+            }
+
+            Ring& ring_;
+            const byte* srcbuf_;
+            std::size_t size_;
+            Waiter waiter_;
+        };
+
+        /** @brief Attach the adapter to an initialized ring.
+         *
+         *  @param[in] rbuf    The StaticRingBuf instance
+         *  @param[in] post    Executor hook used to resume suspended transfers
+         *  @param[in] context Passed to `post`
+         */
+        Ring(StaticRingBuf& rbuf, PostFunc post, void* context) noexcept
+            : rbuf_(&rbuf), post_(post), context_(context)
+        {
+            hook_.observer.notify = &Ring::Notify;
+            hook_.observer.next = nullptr;
+            hook_.owner = this;
+
+            [[maybe_unused]] uint8_t rc = StaticRingBuf_AddObserver(rbuf_, &hook_.observer);
+            assert(rc == STARB_OK);
+        }
+
+        /** @brief Detach the adapter (no transfer may be suspended). */
+        ~Ring()
+        {
+            assert(readers_.head == nullptr && writers_.head == nullptr);
+            StaticRingBuf_RemoveObserver(rbuf_, &hook_.observer);
+        }
+
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+
+        /** @brief   Read exactly `outbuf.size()` bytes.
+         *  @details Suspends until that much data is there; sizes above the
+         *           capacity resume at once with 0xE2.
+         */
+        ReadAwaiter read(std::span<byte> outbuf) noexcept
+        {
+            return ReadAwaiter(*this, outbuf);
+        }
+
+        /** @brief   Write exactly `srcbuf.size()` bytes.
+         *  @details Suspends until that much space is free; sizes above the
+         *           capacity resume at once with 0xE2.
+         */
+        WriteAwaiter write(std::span<const byte> srcbuf) noexcept
+        {
+            return WriteAwaiter(*this, srcbuf);
+        }
+
+        /** @brief The underlying StaticRingBuf instance. */
+        StaticRingBuf& native() noexcept
+        {
+            return *rbuf_;
+        }
+
+    private:
+        /** @brief No waiter ahead and enough unreserved bytes (or a size that can never fit). */
+        bool Ready(const Queue& queue, const STARB_CAPTYPE available, const std::size_t size) const noexcept
+        {
+            return size > rbuf_->capacity ||
+                (queue.head == nullptr && Unreserved(queue, available) >= size);
+        }
+
+        /** @brief Queue a waiter at the back of its side. */
+        void Suspend(Queue& queue, Waiter& waiter, std::coroutine_handle<> handle, const std::size_t size) noexcept
+        {
+            waiter.handle = handle;
+            waiter.count = static_cast<STARB_CAPTYPE>(size);
+            waiter.next = nullptr;
+            if (queue.tail == nullptr)
+            {
+                queue.head = &waiter;
+            }
+            else
+            {
+                queue.tail->next = &waiter;
+            }
+            queue.tail = &waiter;
+        }
+
+        /** @brief A waiter runs again: release its reservation. */
+        void Resumed(Queue& queue, Waiter& waiter) noexcept
+        {
+            if (waiter.posted)
+            {
+                waiter.posted = false;
+                queue.reserved = static_cast<STARB_CAPTYPE>(queue.reserved - waiter.count);
+            }
+        }
+
+        /** @brief Post the leading waiters whose transfers now fit. */
+        void Wake(Queue& queue, const STARB_CAPTYPE available) noexcept
+        {
+            Waiter* waiter;
+
+            while ((waiter = queue.head) != nullptr && Unreserved(queue, available) >= waiter->count)
+            {
+                queue.head = waiter->next;
+                if (queue.head == nullptr)
+                {
+                    queue.tail = nullptr;
+                }
+
+                queue.reserved = static_cast<STARB_CAPTYPE>(queue.reserved + waiter->count);
+                waiter->posted = true;
+                post_(context_, waiter->handle);
+            }
+        }
+
+        static STARB_CAPTYPE Unreserved(const Queue& queue, const STARB_CAPTYPE available) noexcept
+        {
+            return (available > queue.reserved) ? static_cast<STARB_CAPTYPE>(available - queue.reserved) : 0;
+        }
+
+        /** @brief Observer callback: bytes entered or left, re-check both sides. */
+        static void Notify(StaticRingBuf* rbuf, STARB_Observer* observer,
+            const uint8_t event, const byte* data, const STARB_CAPTYPE count) noexcept
+        {
+            Ring* ring = reinterpret_cast<Hook*>(observer)->owner;
+
+            (void)event;
+            (void)data;
+            (void)count;
+
+            /* Both sides: a read frees space for writers, a write adds data for readers. */
+            ring->Wake(ring->readers_, StaticRingBuf_GetReadCapacity(rbuf));
+            ring->Wake(ring->writers_, StaticRingBuf_GetWriteCapacity(rbuf));
+        }
+
+        StaticRingBuf* rbuf_;
+        PostFunc post_;
+        void* context_;
+        Hook hook_;
+        Queue readers_;
+        Queue writers_;
+    };
+
+} // ! namespace starb
+
+#endif // !_INC_GH2025_StaticRingBuf_HPP
@@ -0,0 +1,489 @@
+﻿#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE     // MAP_ANONYMOUS, MAP_HUGETLB, MADV_HUGEPAGE, syscall()
+#endif
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "StaticRingBuf_Arena.h"
+
+#if !defined(_WIN32)
+/* Memory policy ABI (linux/mempolicy.h), used through raw syscalls. */
+#define STARB_MPOL_PREFERRED        1
+#define STARB_MPOL_INTERLEAVE       3
+#define STARB_MPOL_F_MEMS_ALLOWED   (1 << 2)
+#define STARB_NUMA_MAXNODES         1024
+#endif
+
+static inline size_t STARB_Arena_RoundUp(const size_t size, const size_t unit);
+static byte* STARB_Arena_Map(STARB_Arena* arena, const size_t size, const uint8_t flags, const uint8_t policy, const uint32_t node);
+static void STARB_Arena_Unmap(STARB_Arena* arena);
+#if defined(_WIN32)
+static inline byte* STARB_Arena_VirtualAlloc(const size_t size, const DWORD type, const bool onnode, const uint32_t node);
+#else
+static void STARB_Arena_Place(STARB_Arena* arena, const uint8_t policy, const uint32_t node);
+#endif
+
+/** @brief Map an arena from the OS.
+ *
+ *  @param[out] arena The STARB_Arena instance to be initialized
+ *  @param[in] size   Requested size (bytes)
+ *  @param[in] flags  STARB_ARENA_HUGEPAGE | STARB_ARENA_PREFAULT | STARB_ARENA_LOCK
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (the OS could not map the memory).
+ */
+uint8_t STARB_Arena_Create(STARB_Arena* arena, const size_t size, const uint8_t flags)
+{
+    return STARB_Arena_CreateOnNode(arena, size, flags, STARB_NUMA_NONE, 0);
+}
+
+/** @brief Map an arena from the OS, placed on a NUMA node.
+ *
+ *  @param[out] arena The STARB_Arena instance to be initialized
+ *  @param[in] size   Requested size (bytes)
+ *  @param[in] flags  STARB_ARENA_HUGEPAGE | STARB_ARENA_PREFAULT | STARB_ARENA_LOCK
+ *  @param[in] policy STARB_NUMA_xxx
+ *  @param[in] node   Node for STARB_NUMA_PRODUCER / STARB_NUMA_CONSUMER (ignored otherwise)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (the OS could not map the memory).
+ */
+uint8_t STARB_Arena_CreateOnNode(STARB_Arena* arena, const size_t size, const uint8_t flags,
+    const uint8_t policy, const uint32_t node)
+{
+    uint8_t rc = STARB_OK;
+
+    if (arena == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    memset(arena, 0, sizeof(STARB_Arena));
+
+    if (size <= 0 || size > SIZE_MAX - STARB_ARENA_HUGESIZE || policy > STARB_NUMA_INTERLEAVE)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (STARB_Arena_Map(arena, size, flags, policy, node) == NULL)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+#if !defined(_WIN32)
+    /* The policy must be in place before the first touch. */
+    STARB_Arena_Place(arena, policy, node);
+#endif
+
+    /* Write one byte per page: the pages are really allocated, not mapped to the zero page. */
+    if (flags & STARB_ARENA_PREFAULT)
+    {
+        volatile byte* p = arena->base;
+        for (size_t offset = 0; offset < arena->size; offset += arena->pagesize)
+        {
+            p[offset] = 0;
+        }
+        arena->flags |= STARB_ARENA_PREFAULT;
+    }
+
+    if ((flags & STARB_ARENA_LOCK) && (arena->flags & STARB_ARENA_LOCK) == 0)
+    {
+#if defined(_WIN32)
+        if (VirtualLock(arena->base, arena->size))
+#else
+        if (mlock(arena->base, arena->size) == 0)
+#endif
+        {
+            arena->flags |= STARB_ARENA_LOCK;
+        }
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get the NUMA node of the CPU the calling thread runs on (0 if unknown). */
+uint32_t STARB_Arena_CurrentNode(void)
+{
+    uint32_t node = 0;
+
+#if defined(_WIN32)
+    PROCESSOR_NUMBER cpu;
+    USHORT winnode = 0;
+    GetCurrentProcessorNumberEx(&cpu);
+    if (GetNumaProcessorNodeEx(&cpu, &winnode))
+    {
+        node = winnode;
+    }
+#elif defined(SYS_getcpu)
+    unsigned int cpu = 0;
+    unsigned int linuxnode = 0;
+    if (syscall(SYS_getcpu, &cpu, &linuxnode, NULL) == 0)
+    {
+        node = linuxnode;
+    }
+#endif
+
+    return node;
+}
+
+/** @brief Use an existing buffer as the arena.
+ *
+ *  @param[out] arena The STARB_Arena instance to be initialized
+ *  @param[in] buffer Arena memory
+ *  @param[in] size   Size of `buffer` (bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Arena_Attach(STARB_Arena* arena, byte* buffer, const size_t size)
+{
+    uint8_t rc = STARB_OK;
+
+    if (arena == NULL || buffer == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (size <= 0)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(arena, 0, sizeof(STARB_Arena));
+    arena->base = buffer;
+    arena->size = size;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Take a cache line aligned block from the arena.
+ *
+ *  @param[in] arena The STARB_Arena instance
+ *  @param[in] size  Size of the block (bytes)
+ *  @return Pointer to the block, or NULL when the arena is exhausted
+ */
+byte* STARB_Arena_Alloc(STARB_Arena* arena, const size_t size)
+{
+    byte* block = NULL;
+
+    if (arena == NULL || arena->base == NULL || size <= 0)
+    {
+        goto EXIT;
+    }
+
+    uintptr_t start = (uintptr_t)(arena->base + arena->used);
+    size_t padding = STARB_Arena_RoundUp(start, STARB_CACHELINE) - start;
+    size_t avail = arena->size - arena->used;
+    if (padding > avail || size > avail - padding)
+    {
+        goto EXIT;
+    }
+
+    block = arena->base + arena->used + padding;
+    arena->used += padding + size;
+
+EXIT:
+    return block;
+}
+
+/** @brief Initialize a StaticRingBuf with storage taken from the arena.
+ *
+ *  @param[in] arena             The STARB_Arena instance
+ *  @param[out] rbuf             The StaticRingBuf instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer
+ *  @param[in] mode              Ring buffer mode bits (STARB_MODE_xxx)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (the arena is exhausted).
+ */
+uint8_t STARB_Arena_InitRing(STARB_Arena* arena, StaticRingBuf* rbuf, const STARB_STOSZTP total_buffer_size, const uint8_t mode)
+{
+    uint8_t rc = STARB_OK;
+
+    if (arena == NULL || rbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (total_buffer_size < 2 || total_buffer_size > STARB_MAXCAP)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    byte* buffer = STARB_Arena_Alloc(arena, total_buffer_size);
+    if (buffer == NULL)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_InitMode(rbuf, total_buffer_size, buffer, mode);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Hand all blocks back at once; the memory stays mapped (and faulted in). */
+void STARB_Arena_Reset(STARB_Arena* arena)
+{
+    assert(arena != NULL);
+
+    arena->used = 0;
+}
+
+/** @brief Unmap an arena from STARB_Arena_Create(), or detach a buffer. */
+void STARB_Arena_Destroy(STARB_Arena* arena)
+{
+    assert(arena != NULL);
+
+    if (arena->flags & STARB_ARENA_OWNED)
+    {
+        STARB_Arena_Unmap(arena);
+    }
+
+    memset(arena, 0, sizeof(STARB_Arena));
+}
+
+/** @brief Round `size` up to a multiple of `unit` (power of 2). */
+static inline size_t STARB_Arena_RoundUp(const size_t size, const size_t unit)
+{
+    return (size + unit - 1) & ~(unit - 1);
+}
+
+/** @brief   Map the arena memory: huge pages first, then regular pages.
+ *  @details Fills `base`, `size`, `pagesize` and `flags`; returns NULL when
+ *           not even regular pages can be mapped.
+ */
+static byte* STARB_Arena_Map(STARB_Arena* arena, const size_t size, const uint8_t flags, const uint8_t policy, const uint32_t node)
+{
+    byte* base = NULL;
+
+#if defined(_WIN32)
+    ULONG highest = 0;
+    bool onnode = (policy == STARB_NUMA_PRODUCER || policy == STARB_NUMA_CONSUMER) &&
+        GetNumaHighestNodeNumber(&highest) && highest > 0 && node <= highest;
+
+    SIZE_T large = GetLargePageMinimum();
+    if ((flags & STARB_ARENA_HUGEPAGE) && large > 0)
+    {
+        /* Needs the "Lock pages in memory" privilege; large pages are never paged out. */
+        size_t mapsize = STARB_Arena_RoundUp(size, large);
+        base = STARB_Arena_VirtualAlloc(mapsize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, onnode, node);
+        if (base != NULL)
+        {
+            arena->size = mapsize;
+            arena->pagesize = large;
+            arena->flags = STARB_ARENA_HUGEPAGE | STARB_ARENA_LOCK;
+        }
+    }
+
+    if (base == NULL)
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        size_t mapsize = STARB_Arena_RoundUp(size, info.dwPageSize);
+        base = STARB_Arena_VirtualAlloc(mapsize, MEM_RESERVE | MEM_COMMIT, onnode, node);
+        if (base == NULL)
+        {
+            goto EXIT;
+        }
+
+        arena->size = mapsize;
+        arena->pagesize = info.dwPageSize;
+        arena->flags = 0;
+    }
+
+    arena->numa = onnode ? policy : STARB_NUMA_NONE;
+#else
+    /* NUMA placement is applied after mapping, by STARB_Arena_Place(). */
+    (void)policy;
+    (void)node;
+
+    size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+    void* p = MAP_FAILED;
+
+#if defined(MAP_HUGETLB)
+    if (flags & STARB_ARENA_HUGEPAGE)
+    {
+        size_t mapsize = STARB_Arena_RoundUp(size, STARB_ARENA_HUGESIZE);
+        p = mmap(NULL, mapsize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+        {
+            arena->size = mapsize;
+            arena->pagesize = STARB_ARENA_HUGESIZE;
+            arena->flags = STARB_ARENA_HUGEPAGE;
+        }
+    }
+#endif
+
+    if (p == MAP_FAILED)
+    {
+        size_t mapsize = STARB_Arena_RoundUp(size, pagesize);
+        size_t slack = 0;
+
+        /* Transparent huge pages need a huge page aligned range: over-map and trim. */
+        if ((flags & STARB_ARENA_HUGEPAGE) && mapsize >= STARB_ARENA_HUGESIZE)
+        {
+            slack = STARB_ARENA_HUGESIZE;
+        }
+
+        p = mmap(NULL, mapsize + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            goto EXIT;
+        }
+
+        if (slack > 0)
+        {
+            uintptr_t start = (uintptr_t)p;
+            size_t head = STARB_Arena_RoundUp(start, STARB_ARENA_HUGESIZE) - start;
+            if (head > 0)
+            {
+                munmap(p, head);
+            }
+            if (slack - head > 0)
+            {
+                munmap((byte*)p + head + mapsize, slack - head);
+            }
+            p = (byte*)p + head;
+        }
+
+        arena->size = mapsize;
+        arena->pagesize = pagesize;
+        arena->flags = 0;
+
+#if defined(MADV_HUGEPAGE)
+        if ((flags & STARB_ARENA_HUGEPAGE) && madvise(p, mapsize, MADV_HUGEPAGE) == 0)
+        {
+            arena->flags |= STARB_ARENA_THP;
+        }
+#endif
+    }
+
+    base = (byte*)p;
+#endif
+
+    arena->base = base;
+    arena->flags |= STARB_ARENA_OWNED;
+
+EXIT:
+    return base;
+}
+
+/** @brief Give the arena memory back to the OS (unlocks it as well). */
+static void STARB_Arena_Unmap(STARB_Arena* arena)
+{
+#if defined(_WIN32)
+    VirtualFree(arena->base, 0, MEM_RELEASE);
+#else
+    munmap(arena->base, arena->size);
+#endif
+}
+
+#if defined(_WIN32)
+/** @brief VirtualAlloc(), on the given NUMA node when `onnode` is set. */
+static inline byte* STARB_Arena_VirtualAlloc(const size_t size, const DWORD type, const bool onnode, const uint32_t node)
+{
+    byte* base = NULL;
+
+    if (onnode)
+    {
+        base = (byte*)VirtualAllocExNuma(GetCurrentProcess(), NULL, size, type, PAGE_READWRITE, node);
+    }
+    else
+    {
+        base = (byte*)VirtualAlloc(NULL, size, type, PAGE_READWRITE);
+    }
+
+    return base;
+}
+#else
+/** @brief   Set the NUMA memory policy of the (not yet touched) arena pages.
+ *  @details No-op when the policy is STARB_NUMA_NONE, fewer than 2 nodes are
+ *           allowed, the node is not allowed, or the kernel refuses mbind().
+ *           Node-local placement uses MPOL_PREFERRED: pages fall back to
+ *           another node instead of failing when the node runs out of memory.
+ */
+static void STARB_Arena_Place(STARB_Arena* arena, const uint8_t policy, const uint32_t node)
+{
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    const size_t bits = 8 * sizeof(unsigned long);
+    unsigned long allowed[STARB_NUMA_MAXNODES / (8 * sizeof(unsigned long))] = { 0 };
+    unsigned long mask[STARB_NUMA_MAXNODES / (8 * sizeof(unsigned long))] = { 0 };
+    uint32_t nodes = 0;
+    int mode = STARB_MPOL_PREFERRED;
+
+    if (policy == STARB_NUMA_NONE)
+    {
+        goto EXIT;
+    }
+
+    if (syscall(SYS_get_mempolicy, NULL, allowed, STARB_NUMA_MAXNODES, NULL, STARB_MPOL_F_MEMS_ALLOWED) != 0)
+    {
+        goto EXIT;
+    }
+
+    for (uint32_t i = 0; i < STARB_NUMA_MAXNODES; i++)
+    {
+        nodes += (allowed[i / bits] >> (i % bits)) & 1;
+    }
+
+    if (nodes < 2)
+    {
+        goto EXIT;
+    }
+
+    if (policy == STARB_NUMA_INTERLEAVE)
+    {
+        memcpy(mask, allowed, sizeof(mask));
+        mode = STARB_MPOL_INTERLEAVE;
+    }
+    else
+    {
+        if (node >= STARB_NUMA_MAXNODES || ((allowed[node / bits] >> (node % bits)) & 1) == 0)
+        {
+            goto EXIT;
+        }
+
+        mask[node / bits] = 1UL << (node % bits);
+    }
+
+    /* mbind() reads maxnode - 1 bits. */
+    if (syscall(SYS_mbind, arena->base, arena->size, mode, mask, STARB_NUMA_MAXNODES + 1, 0) == 0)
+    {
+        arena->numa = policy;
+    }
+
+EXIT:
+    return;
+#else
+    (void)arena;
+    (void)policy;
+    (void)node;
+#endif
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Arena.h                                          *
+ *  @brief    Storage provider: (huge) page backed arena for rings.          *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *  2026/10/19 | 0.1.1.0   | agent      | Add NUMA placement policies        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Arena_H
+#define _INC_GH2025_StaticRingBuf_Arena_H
+
+#include <stddef.h>
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief Tech Decision Macros */
+
+/** @brief Huge page size tried with MAP_HUGETLB, and alignment used for transparent huge pages */
+#ifndef STARB_ARENA_HUGESIZE
+#define STARB_ARENA_HUGESIZE    (2 * 1024 * 1024)
+#endif
+
+/** @brief Arena flags: requested at STARB_Arena_Create(), obtained ones reported in `flags` */
+#define STARB_ARENA_DEFAULT     0x00
+#define STARB_ARENA_HUGEPAGE    0x01    // Huge pages (MAP_HUGETLB / MEM_LARGE_PAGES)
+#define STARB_ARENA_PREFAULT    0x02    // Touch every page at create time
+#define STARB_ARENA_LOCK        0x04    // Lock the pages in RAM (mlock / VirtualLock)
+#define STARB_ARENA_THP         0x08    // Obtained only: regular pages advised for transparent huge pages
+#define STARB_ARENA_OWNED       0x80    // Obtained only: memory mapped by the arena
+
+/** @brief NUMA placement policies for STARB_Arena_CreateOnNode() */
+#define STARB_NUMA_NONE         0x00    // OS default (first touch)
+#define STARB_NUMA_PRODUCER     0x01    // Pages on the producer's node
+#define STARB_NUMA_CONSUMER     0x02    // Pages on the consumer's node
+#define STARB_NUMA_INTERLEAVE   0x03    // Pages spread round-robin over all allowed nodes
+
+/** \brief  Struct definition for the storage arena.
+ * \details A bump allocator that hands out cache line aligned storage buffers for
+ *          rings (StaticRingBuf_InitMode(), STARB_Table, ...).
+ *
+ *          STARB_Arena_Create() maps the memory from the OS and moves the page
+ *          costs to init time: huge pages are tried first, then regular pages
+ *          (advised for transparent huge pages where the OS supports it); the
+ *          pages can be pre-faulted and locked. Each step that is not available
+ *          falls back silently; `flags` tells what was obtained.
+ *
+ *          STARB_Arena_CreateOnNode() also places the pages on a NUMA node
+ *          before they are faulted in. Producer- and consumer-local placement
+ *          both bind to the given node (the one the producer or the consumer
+ *          thread runs on, see STARB_Arena_CurrentNode()); consumer-local
+ *          keeps the reads local, which usually matters most for rings read
+ *          in bulk. On Linux the policy is set with raw mbind() / get_mempolicy()
+ *          syscalls (no libnuma); on Windows node-local pages come from
+ *          VirtualAllocExNuma() and interleaving is not available. On single
+ *          node machines, or when the node is not allowed, placement is a
+ *          no-op and `numa` stays STARB_NUMA_NONE.
+ *
+ *          STARB_Arena_Attach() uses an existing buffer instead (static memory,
+ *          no OS calls).
+ */
+typedef struct _STARB_Arena_t
+{
+    byte* base;                     // Arena memory
+    size_t size;                    // Size of the arena (rounded up to the page size when mapped)
+    size_t used;                    // Bytes handed out, including alignment padding
+    size_t pagesize;                // Page size backing the arena (0: attached buffer)
+    uint8_t flags;                  // STARB_ARENA_xxx obtained
+    uint8_t numa;                   // STARB_NUMA_xxx applied
+
+} STARB_Arena;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Map an arena from the OS.
+     *
+     *  @param[out] arena The STARB_Arena instance to be initialized
+     *  @param[in] size   Requested size (bytes)
+     *  @param[in] flags  STARB_ARENA_HUGEPAGE | STARB_ARENA_PREFAULT | STARB_ARENA_LOCK
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (the OS could not map the memory).
+     */
+    uint8_t STARB_Arena_Create(STARB_Arena* arena, const size_t size, const uint8_t flags);
+
+    /** @brief Map an arena from the OS, placed on a NUMA node.
+     *
+     *  @param[out] arena The STARB_Arena instance to be initialized
+     *  @param[in] size   Requested size (bytes)
+     *  @param[in] flags  STARB_ARENA_HUGEPAGE | STARB_ARENA_PREFAULT | STARB_ARENA_LOCK
+     *  @param[in] policy STARB_NUMA_xxx
+     *  @param[in] node   Node for STARB_NUMA_PRODUCER / STARB_NUMA_CONSUMER (ignored otherwise)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (the OS could not map the memory).
+     */
+    uint8_t STARB_Arena_CreateOnNode(STARB_Arena* arena, const size_t size, const uint8_t flags,
+        const uint8_t policy, const uint32_t node);
+
+    /** @brief Get the NUMA node of the CPU the calling thread runs on (0 if unknown). */
+    uint32_t STARB_Arena_CurrentNode(void);
+
+    /** @brief Use an existing buffer as the arena.
+     *
+     *  @param[out] arena The STARB_Arena instance to be initialized
+     *  @param[in] buffer Arena memory
+     *  @param[in] size   Size of `buffer` (bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Arena_Attach(STARB_Arena* arena, byte* buffer, const size_t size);
+
+    /** @brief Take a cache line aligned block from the arena.
+     *
+     *  @param[in] arena The STARB_Arena instance
+     *  @param[in] size  Size of the block (bytes)
+     *  @return Pointer to the block, or NULL when the arena is exhausted
+     */
+    byte* STARB_Arena_Alloc(STARB_Arena* arena, const size_t size);
+
+    /** @brief Initialize a StaticRingBuf with storage taken from the arena.
+     *
+     *  @param[in] arena             The STARB_Arena instance
+     *  @param[out] rbuf             The StaticRingBuf instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer
+     *  @param[in] mode              Ring buffer mode bits (STARB_MODE_xxx)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (the arena is exhausted).
+     */
+    uint8_t STARB_Arena_InitRing(STARB_Arena* arena, StaticRingBuf* rbuf, const STARB_STOSZTP total_buffer_size, const uint8_t mode);
+
+    /** @brief Hand all blocks back at once; the memory stays mapped (and faulted in). */
+    void STARB_Arena_Reset(STARB_Arena* arena);
+
+    /** @brief Unmap an arena from STARB_Arena_Create(), or detach a buffer. */
+    void STARB_Arena_Destroy(STARB_Arena* arena);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Arena_H
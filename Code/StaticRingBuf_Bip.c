@@ -0,0 +1,280 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Bip.h"
+
+static inline void STARB_Bip_Skip(STARB_Bip* bip);
+
+/** @brief   Initialize the STARB_Bip instance.
+ *  @details The logical capacity equals `total_buffer_size` (1 ~ 0xFFFF bytes).
+ *
+ *  @param[out] bip              The STARB_Bip instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Bip_Init(STARB_Bip* bip, const STARB_STOSZTP total_buffer_size, byte* _buffer)
+{
+    uint8_t rc = STARB_OK;
+
+    if (bip == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_InitMode(&bip->rbuf, total_buffer_size, _buffer, STARB_MODE_NOMIRROR);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    bip->watermark = bip->rbuf.capacity;
+    bip->rsvpos = 0;
+    bip->reserved = 0;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Reserve a contiguous block for writing.
+ *  @details The block is taken at `wpos` if it fits before the end of the storage
+ *           (or before `rpos` after a wrap), otherwise at offset 0 if it fits before
+ *           `rpos`. A new reservation replaces a pending one.
+ *
+ *  @param[in] bip    The STARB_Bip instance
+ *  @param[in] count  Length of the block (bytes)
+ *  @param[out] ptr   Pointer to receive the start of the block
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (no contiguous block of `count` bytes).
+ */
+uint8_t STARB_Bip_Reserve(STARB_Bip* bip, const STARB_CAPTYPE count, byte** ptr)
+{
+    uint8_t rc = STARB_OK;
+
+    if (bip == NULL || ptr == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    StaticRingBuf* rbuf = &bip->rbuf;
+    if (count <= 0 || count > rbuf->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    bip->reserved = 0;
+
+    if (rbuf->flag.cycle == 0 && rbuf->rpos == rbuf->wpos)
+    {
+        /* Empty: restart at offset 0 to offer the largest contiguous block. */
+        rbuf->wpos = 0;
+        rbuf->rpos = 0;
+    }
+
+    if (rbuf->flag.cycle == 0)
+    {
+        if (count <= rbuf->capacity - rbuf->wpos)
+        {
+            bip->rsvpos = rbuf->wpos;
+        }
+        else if (count <= rbuf->rpos)
+        {
+            bip->rsvpos = 0;
+        }
+        else
+        {
+            rc = STARB_BUFOVERFLOW;
+            goto EXIT;
+        }
+    }
+    else
+    {
+        if (count <= rbuf->rpos - rbuf->wpos)
+        {
+            bip->rsvpos = rbuf->wpos;
+        }
+        else
+        {
+            rc = STARB_BUFOVERFLOW;
+            goto EXIT;
+        }
+    }
+
+    bip->reserved = count;
+    *ptr = rbuf->buffer + bip->rsvpos;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Make the first `count` bytes of the pending reservation readable.
+ *  @details `count` may be shorter than the reservation; 0 cancels it.
+ *
+ *  @param[in] bip    The STARB_Bip instance
+ *  @param[in] count  Length actually written (bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Bip_Commit(STARB_Bip* bip, const STARB_CAPTYPE count)
+{
+    uint8_t rc = STARB_OK;
+
+    if (bip == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (count > bip->reserved)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    StaticRingBuf* rbuf = &bip->rbuf;
+    bip->reserved = 0;
+    if (count <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (bip->rsvpos != rbuf->wpos)
+    {
+        /* The block was placed at offset 0: the tail after `wpos` is skipped by the reader. */
+        bip->watermark = rbuf->wpos;
+        rbuf->wpos = count;
+        rbuf->flag.cycle = 1;
+    }
+    else if (rbuf->wpos >= rbuf->capacity - count)
+    {
+        bip->watermark = rbuf->capacity;
+        rbuf->wpos = 0;
+        rbuf->flag.cycle = 1;
+    }
+    else
+    {
+        rbuf->wpos += count;
+    }
+
+    STARB_Bip_Skip(bip);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get reading capacity of the STARB_Bip instance (both blocks, tail excluded).
+ *
+ *  @param[in] bip The STARB_Bip instance
+ *  @return Reading capacity (bytes)
+ */
+STARB_CAPTYPE STARB_Bip_GetReadCapacity(STARB_Bip* bip)
+{
+    assert(bip != NULL);
+
+    StaticRingBuf* rbuf = &bip->rbuf;
+    return (rbuf->flag.cycle == 0) ?
+        rbuf->wpos - rbuf->rpos :
+        bip->watermark - rbuf->rpos + rbuf->wpos;
+}
+
+/** @brief   Get the contiguous block to read next.
+ *  @details Committed reservations are never split: a block always starts on a
+ *           reservation boundary and holds whole reservations.
+ *
+ *  @param[in] bip    The STARB_Bip instance
+ *  @param[out] block Span to receive the readable block
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Bip_GetReadBlock(STARB_Bip* bip, STARB_Span* block)
+{
+    uint8_t rc = STARB_OK;
+
+    if (bip == NULL || block == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    StaticRingBuf* rbuf = &bip->rbuf;
+    block->ptr = rbuf->buffer + rbuf->rpos;
+    block->len = (rbuf->flag.cycle == 0) ?
+        rbuf->wpos - rbuf->rpos :
+        bip->watermark - rbuf->rpos;
+
+    if (block->len <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Release `count` bytes at the start of the read block.
+ *
+ *  @param[in] bip    The STARB_Bip instance
+ *  @param[in] count  Length to release (bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Bip_Release(STARB_Bip* bip, const STARB_CAPTYPE count)
+{
+    uint8_t rc = STARB_OK;
+    STARB_Span block;
+
+    if (bip == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (count <= 0)
+    {
+        goto EXIT;
+    }
+
+    rc = STARB_Bip_GetReadBlock(bip, &block);
+    if (rc != STARB_OK || count > block.len)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    bip->rbuf.rpos += count;
+    STARB_Bip_Skip(bip);
+
+EXIT:
+    return rc;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Move the reader past the unused tail once the upper block is consumed. */
+static inline void STARB_Bip_Skip(STARB_Bip* bip)
+{
+    StaticRingBuf* rbuf = &bip->rbuf;
+
+    if (rbuf->flag.cycle != 0 && rbuf->rpos >= bip->watermark)
+    {
+        rbuf->rpos = 0;
+        rbuf->flag.cycle = 0;
+        bip->watermark = rbuf->capacity;
+    }
+}
@@ -0,0 +1,139 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Bip.h                                            *
+ *  @brief    Bipartite Static Ring Buffer (contiguous reservations).        *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Bip_H
+#define _INC_GH2025_StaticRingBuf_Bip_H
+
+#include "StaticRingBuf.h"
+
+/** \brief  Struct definition for the bipartite Static Ring Buffer.
+ * \details Every reservation is one contiguous block of the storage, without the
+ *          mirror region: `rbuf` is a `STARB_MODE_NOMIRROR` ring (1x memory).
+ *
+ *          A reservation that does not fit between `wpos` and the end of the
+ *          storage is placed at offset 0 instead. On commit, the end of the valid
+ *          data in the upper part is recorded in `watermark`, and the reader skips
+ *          the unused tail `[watermark, capacity)` when it gets there.
+ *
+ *          `wpos` / `rpos` / `flag.cycle` keep the StaticRingBuf meaning: with
+ *          `cycle` set, the readable data is `[rpos, watermark)` then `[0, wpos)`.
+ *
+ *          Do not call the StaticRingBuf read / write functions on `rbuf`.
+ */
+typedef struct _STARB_Bip_t
+{
+    StaticRingBuf rbuf;             // Ring buffer (mirror-less storage)
+    STARB_CAPTYPE watermark;        // End of the valid data before the wrap (capacity: no tail skipped)
+    STARB_CAPTYPE rsvpos;           // Offset of the pending reservation
+    STARB_CAPTYPE reserved;         // Length of the pending reservation, 0: none
+
+} STARB_Bip;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief   Initialize the STARB_Bip instance.
+     *  @details The logical capacity equals `total_buffer_size` (1 ~ 0xFFFF bytes).
+     *
+     *  @param[out] bip              The STARB_Bip instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Bip_Init(STARB_Bip* bip, const STARB_STOSZTP total_buffer_size, byte* _buffer);
+
+    /** @brief   Reserve a contiguous block for writing.
+     *  @details The block is taken at `wpos` if it fits before the end of the storage
+     *           (or before `rpos` after a wrap), otherwise at offset 0 if it fits before
+     *           `rpos`. A new reservation replaces a pending one.
+     *
+     *  @param[in] bip    The STARB_Bip instance
+     *  @param[in] count  Length of the block (bytes)
+     *  @param[out] ptr   Pointer to receive the start of the block
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (no contiguous block of `count` bytes).
+     */
+    uint8_t STARB_Bip_Reserve(STARB_Bip* bip, const STARB_CAPTYPE count, byte** ptr);
+
+    /** @brief   Make the first `count` bytes of the pending reservation readable.
+     *  @details `count` may be shorter than the reservation; 0 cancels it.
+     *
+     *  @param[in] bip    The STARB_Bip instance
+     *  @param[in] count  Length actually written (bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Bip_Commit(STARB_Bip* bip, const STARB_CAPTYPE count);
+
+    /** @brief Get reading capacity of the STARB_Bip instance (both blocks, tail excluded).
+     *
+     *  @param[in] bip The STARB_Bip instance
+     *  @return Reading capacity (bytes)
+     */
+    STARB_CAPTYPE STARB_Bip_GetReadCapacity(STARB_Bip* bip);
+
+    /** @brief   Get the contiguous block to read next.
+     *  @details Committed reservations are never split: a block always starts on a
+     *           reservation boundary and holds whole reservations.
+     *
+     *  @param[in] bip    The STARB_Bip instance
+     *  @param[out] block Span to receive the readable block
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Bip_GetReadBlock(STARB_Bip* bip, STARB_Span* block);
+
+    /** @brief Release `count` bytes at the start of the read block.
+     *
+     *  @param[in] bip    The STARB_Bip instance
+     *  @param[in] count  Length to release (bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Bip_Release(STARB_Bip* bip, const STARB_CAPTYPE count);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Bip_H
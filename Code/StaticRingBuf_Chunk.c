@@ -0,0 +1,398 @@
+﻿#include <string.h>
+#include "StaticRingBuf_Chunk.h"
+
+static void STARB_Chunk_Notify(StaticRingBuf* rbuf, STARB_Observer* observer, const uint8_t event, const byte* data, const STARB_CAPTYPE count);
+static void STARB_Chunk_Scan(STARB_Chunk* chunk, const byte* data, uint32_t count);
+static inline void STARB_Chunk_Cut(STARB_Chunk* chunk, const uint32_t pos);
+static inline uint32_t STARB_Chunk_TopMask(const uint32_t bits);
+
+/** @brief Gear table: one pseudo-random 32-bit value per byte value (splitmix64, high halves). */
+static const uint32_t STARB_Chunk_Gear[256] = {
+    0x6B273531U, 0xDFD30BDDU, 0x4EBC149DU, 0x997337B8U, 0xC78EF0C5U, 0x863D6B7DU,
+    0xAC898CDBU, 0x5F8E8438U, 0x09C7C0E0U, 0x97D18EB6U, 0x55EE12A1U, 0xF402162BU,
+    0x88E6A89AU, 0xEFC57DFEU, 0x6DCFCD13U, 0x45668F93U, 0x604ED210U, 0x6FD6A7AAU,
+    0x212A17FEU, 0x568B3A04U, 0x03066FCEU, 0x0DAD03B7U, 0x09E325F8U, 0xB14799BFU,
+    0xA58C069EU, 0xF403837AU, 0xCACBDC69U, 0xFC412F95U, 0xC56970B6U, 0xEDA359E3U,
+    0xE1828A7BU, 0xBB93694EU, 0x0AF2F692U, 0xC2CD2367U, 0x5D906983U, 0x8ABDCB32U,
+    0xA531FDDBU, 0x4B51B88DU, 0xA31A1186U, 0x01CC33D3U, 0x051A64B6U, 0x5F70EAF3U,
+    0x0610303FU, 0x0B7F307AU, 0xFF13F4DCU, 0xDCC3E183U, 0x2DB71D5EU, 0x6831A2E2U,
+    0x5AF7FB6EU, 0x7570B923U, 0x45608A05U, 0x57AC2EDFU, 0xD42C2C12U, 0x7553F582U,
+    0x5F0540AFU, 0xF8F18923U, 0x2C47CBACU, 0x1E968D59U, 0x20E74459U, 0x6BA6E632U,
+    0x67DEC1EFU, 0x14B72A08U, 0xB5685A8CU, 0x6D7E108DU, 0x878E458EU, 0x084B98A6U,
+    0xCA85A5A1U, 0x0CA3A439U, 0xAC69BE7AU, 0x8D1FAA46U, 0x9B5D5F41U, 0x860783DCU,
+    0xD53226DDU, 0x3FA5B7E5U, 0xDAB47641U, 0x5F78D0E8U, 0xC9019274U, 0xAD16D5BDU,
+    0x101BAB3EU, 0x3058D642U, 0x45088979U, 0xD38880DBU, 0x9EC771B2U, 0x38326B96U,
+    0xF7321AF3U, 0x043AA3C5U, 0x6677690DU, 0x92C56CC7U, 0xD0C71A75U, 0xC22FA144U,
+    0x8EDD7EE1U, 0x4E51FB38U, 0xA7907671U, 0x3A64B768U, 0x535960ABU, 0x406AA6E6U,
+    0x2EBA1DF4U, 0x6376D8E9U, 0xBA4082A6U, 0xA892C6EFU, 0x013000A7U, 0xAA8BC7EAU,
+    0xF1261818U, 0x0F82F5C2U, 0x5F84D4BEU, 0x67271F56U, 0x1107A763U, 0x1DB95331U,
+    0x9E510801U, 0xAC5EDE78U, 0x93D2D6E4U, 0xEED33F52U, 0xB553C432U, 0x111ABDE9U,
+    0x7CB181FBU, 0x0C449626U, 0xC6EAFA3DU, 0xF2EB55DBU, 0x3B792F58U, 0x566316E5U,
+    0x235D4B96U, 0x180373E7U, 0xC3F5097AU, 0xD542CB29U, 0xB91C9F0DU, 0x4BBFE438U,
+    0x45DF5C0DU, 0x76F4C459U, 0xADC8FE48U, 0xE09F3031U, 0x9817654FU, 0x4DA33F3CU,
+    0x01059DECU, 0xE6E73974U, 0xEE3C9568U, 0x1512F40EU, 0x39E4834AU, 0x5AAF0AF8U,
+    0x0E6EF988U, 0x6BB935C7U, 0x36884F49U, 0xE9D0A111U, 0x46E2BB79U, 0x2066DF99U,
+    0x8EC79F87U, 0x5EA064E8U, 0x58A44586U, 0xC866D1DDU, 0xF7446381U, 0xF9BB64FAU,
+    0x97898A7EU, 0xEBE198B4U, 0x3BA43D50U, 0xF552002BU, 0x3BC50BD0U, 0x21321E83U,
+    0x16C023B3U, 0x59CB067EU, 0x469EBE6AU, 0x26997F7AU, 0x60192AE2U, 0x7905C1EFU,
+    0x9F1520C1U, 0x16279678U, 0x40CF5544U, 0x89687C06U, 0xA7BC7F6CU, 0x936308C6U,
+    0x6EDDA5B5U, 0xEA6C6F82U, 0xBB97117AU, 0x22427E6BU, 0x5F2A320DU, 0xCCE43EDAU,
+    0x13991658U, 0x48142F36U, 0x4AB5A99DU, 0xD1EC7AC5U, 0x396A4074U, 0x4B5A08CBU,
+    0xA5C8C491U, 0x612848EBU, 0xA7F17B3EU, 0xF66D38B6U, 0x5E0FCF8DU, 0x31D3706BU,
+    0x6BBFF801U, 0xFEC69127U, 0x920ADD37U, 0x659B7997U, 0x46FC2E4DU, 0x17BF7942U,
+    0x7CD99F73U, 0x98EEF655U, 0x2F7EFFE3U, 0x71EC5BF2U, 0x831953B7U, 0xB2D4C4E9U,
+    0x06C04CEDU, 0x3175CE61U, 0x96B6FA36U, 0xA6C127D9U, 0xA6DEE5E3U, 0x1BEC2F99U,
+    0x7C938E17U, 0xA6E9094DU, 0x0FE8990EU, 0x548A8692U, 0x5153F41AU, 0x5EDC268FU,
+    0xE2352AD6U, 0xBE60C22AU, 0xC60993B3U, 0x8459F5B3U, 0x1EBBE7BDU, 0x297DB8B8U,
+    0x270468EFU, 0x29EC096AU, 0xF484C5BDU, 0x3293BA1FU, 0x6A0C1CB9U, 0x303D781BU,
+    0xAD6FE9E2U, 0xB33F8E13U, 0xE4BA87A7U, 0xDF85F8A3U, 0x4C355FEDU, 0x0864C67DU,
+    0x9CA60C64U, 0xEEF363CFU, 0xE92969C2U, 0x7DA3D4DDU, 0x34B560EAU, 0x3A54FDCBU,
+    0xDC5EF9D1U, 0xBDA85522U, 0xA4645B91U, 0x65503B1DU, 0x01424A3EU, 0x23CA7FBDU,
+    0x042A8EC1U, 0xA10D5260U, 0x7BFF800EU, 0x87566CDDU, 0xFFEF9B77U, 0xEAD2150DU,
+    0xD130E0F5U, 0x783E1503U, 0x040F013DU, 0x92A11D4DU, 0xF6AF22CEU, 0xCA22497BU,
+    0xCD475335U, 0x920D1CD7U, 0x5909F140U, 0xAB898D31U
+};
+
+/** @brief   Initialize the STARB_Chunk instance and attach it to a ring.
+ *  @details Data already in the ring is chunked starting at the read position.
+ *           Each chunk is at least `minsize` bytes (except flushed ones), so
+ *           `cutcount` >= capacity / minsize + 1 boundaries always fit; a
+ *           boundary found while the queue is full is dropped and its two
+ *           chunks are reported as one.
+ *
+ *  @param[out] chunk   The STARB_Chunk instance to be initialized
+ *  @param[in] rbuf     The StaticRingBuf instance to observe
+ *  @param[in] minsize  Minimum chunk size (1 ~ avgsize)
+ *  @param[in] avgsize  Normal chunk size (power of 2, 4 ~ maxsize)
+ *  @param[in] maxsize  Maximum chunk size (avgsize ~ capacity)
+ *  @param[in] cuts     Boundary queue entries
+ *  @param[in] cutcount Count of entries of `cuts` (>= capacity / minsize + 1)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Chunk_Init(STARB_Chunk* chunk, StaticRingBuf* rbuf, const uint32_t minsize,
+    const uint32_t avgsize, const uint32_t maxsize, uint32_t* cuts, const uint32_t cutcount)
+{
+    uint8_t rc = STARB_OK;
+    STARB_Span spans[2];
+    uint32_t bits = 0;
+
+    if (chunk == NULL || rbuf == NULL || cuts == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (minsize == 0 || minsize > avgsize || avgsize < 4 || (avgsize & (avgsize - 1)) != 0 ||
+        avgsize > maxsize || maxsize > rbuf->capacity || cutcount < (uint32_t)rbuf->capacity / minsize + 1)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    while ((1U << bits) < avgsize)
+    {
+        bits++;
+    }
+
+    memset(chunk, 0, sizeof(STARB_Chunk));
+    chunk->observer.notify = STARB_Chunk_Notify;
+    chunk->rbuf = rbuf;
+    chunk->cuts = cuts;
+    chunk->cutcount = cutcount;
+    chunk->minsize = minsize;
+    chunk->avgsize = avgsize;
+    chunk->maxsize = maxsize;
+    chunk->masks = STARB_Chunk_TopMask(bits + 2);
+    chunk->maskl = STARB_Chunk_TopMask((bits > 3) ? bits - 2 : 1);
+
+    uint8_t count = StaticRingBuf_GetReadSpans(rbuf, spans);
+    for (uint8_t idx = 0; idx < count; idx++)
+    {
+        STARB_Chunk_Scan(chunk, spans[idx].ptr, spans[idx].len);
+    }
+
+    rc = StaticRingBuf_AddObserver(rbuf, &chunk->observer);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Detach the STARB_Chunk instance from its ring.
+ *
+ *  @param[in] chunk The STARB_Chunk instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+ */
+uint8_t STARB_Chunk_Detach(STARB_Chunk* chunk)
+{
+    uint8_t rc = STARB_OK;
+
+    if (chunk == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_RemoveObserver(chunk->rbuf, &chunk->observer);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   End the open chunk at the write position (end of stream / file).
+ *  @details Does nothing when the open chunk is empty.
+ *
+ *  @param[in] chunk The STARB_Chunk instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE4 Failed: Buffer overflow (boundary queue is full).
+ */
+uint8_t STARB_Chunk_Flush(STARB_Chunk* chunk)
+{
+    uint8_t rc = STARB_OK;
+
+    if (chunk == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (chunk->wrtotal == chunk->rdtotal)
+    {
+        /* Nothing of the open chunk is left in the ring: just restart there. */
+        chunk->start = chunk->wrtotal;
+        chunk->hash = 0;
+        goto EXIT;
+    }
+
+    if (chunk->wrtotal == chunk->start)
+    {
+        goto EXIT;
+    }
+
+    if (chunk->cutnum >= chunk->cutcount)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    STARB_Chunk_Cut(chunk, chunk->wrtotal);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get the count of complete chunks in the ring. */
+uint32_t STARB_Chunk_GetCount(STARB_Chunk* chunk)
+{
+    return (chunk == NULL) ? 0 : chunk->cutnum;
+}
+
+/** @brief Get the end of a complete chunk as an offset from the read position.
+ *
+ *  @param[in] chunk   The STARB_Chunk instance
+ *  @param[in] index   Chunk index (0: the chunk at the read position)
+ *  @param[out] offset Offset of the chunk end from the read position
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Chunk_GetBoundary(STARB_Chunk* chunk, const uint32_t index, STARB_CAPTYPE* offset)
+{
+    uint8_t rc = STARB_OK;
+
+    if (chunk == NULL || offset == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (index >= chunk->cutnum)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    uint32_t entry = chunk->cutfirst + index;
+    entry = (entry >= chunk->cutcount) ? entry - chunk->cutcount : entry;
+    *offset = (STARB_CAPTYPE)(chunk->cuts[entry] - chunk->rdtotal);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Get the complete chunk at the read position as zero-copy spans.
+ *  @details Mirrored storage always yields 1 span; `STARB_MODE_NOMIRROR` yields
+ *           2 spans when the chunk wraps around the end of the storage.
+ *
+ *  @param[in] chunk  The STARB_Chunk instance
+ *  @param[out] spans Array of 2 spans to receive the chunk
+ *  @return Count of spans filled (0: no complete chunk)
+ */
+uint8_t STARB_Chunk_Acquire(STARB_Chunk* chunk, STARB_Span spans[2])
+{
+    uint8_t count = 0;
+    STARB_CAPTYPE length = 0;
+
+    if (spans == NULL || STARB_Chunk_GetBoundary(chunk, 0, &length) != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    count = StaticRingBuf_GetReadSpans(chunk->rbuf, spans);
+    if (spans[0].len >= length)
+    {
+        spans[0].len = length;
+        count = 1;
+    }
+    else
+    {
+        spans[1].len = (STARB_CAPTYPE)(length - spans[0].len);
+    }
+
+EXIT:
+    return count;
+}
+
+/** @brief Consume the complete chunk at the read position (StaticRingBuf_Forward()).
+ *
+ *  @param[in] chunk The STARB_Chunk instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Chunk_Release(STARB_Chunk* chunk)
+{
+    uint8_t rc = STARB_OK;
+    STARB_CAPTYPE length = 0;
+
+    rc = STARB_Chunk_GetBoundary(chunk, 0, &length);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    /* The LEAVE notification pops the boundary. */
+    rc = StaticRingBuf_Forward(chunk->rbuf, length);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Observer callback: hash entering bytes, drop boundaries behind the read position.
+ *  @details With mirrored storage the entering bytes are one contiguous piece
+ *           at the old write position, so the hash never handles a wrap.
+ */
+static void STARB_Chunk_Notify(StaticRingBuf* rbuf, STARB_Observer* observer, const uint8_t event, const byte* data, const STARB_CAPTYPE count)
+{
+    STARB_Chunk* chunk = (STARB_Chunk*)observer;
+
+    (void)rbuf;
+
+    if (event == STARB_EVENT_ENTER)
+    {
+        STARB_Chunk_Scan(chunk, data, count);
+    }
+    else
+    {
+        chunk->rdtotal += count;
+        while (chunk->cutnum > 0 && (int32_t)(chunk->cuts[chunk->cutfirst] - chunk->rdtotal) <= 0)
+        {
+            chunk->cutfirst = (chunk->cutfirst + 1 < chunk->cutcount) ? chunk->cutfirst + 1 : 0;
+            chunk->cutnum--;
+        }
+    }
+}
+
+/** @brief   Run the rolling hash over entering bytes and queue the boundaries found.
+ *  @details The first `minsize` bytes of a chunk are skipped without hashing;
+ *           the inner loop only hashes and tests the mask.
+ */
+static void STARB_Chunk_Scan(STARB_Chunk* chunk, const byte* data, uint32_t count)
+{
+    uint32_t hash = chunk->hash;
+    uint32_t mask;
+    uint32_t limit;
+    uint32_t idx;
+    bool found;
+
+    while (count > 0)
+    {
+        uint32_t len = chunk->wrtotal - chunk->start;
+
+        if (len < chunk->minsize)
+        {
+            limit = chunk->minsize - len;
+            limit = (limit < count) ? limit : count;
+            chunk->wrtotal += limit;
+            data += limit;
+            count -= limit;
+            continue;
+        }
+
+        if (len < chunk->avgsize)
+        {
+            mask = chunk->masks;
+            limit = chunk->avgsize - len;
+        }
+        else
+        {
+            mask = chunk->maskl;
+            limit = chunk->maxsize - len;
+        }
+        limit = (limit < count) ? limit : count;
+
+        found = false;
+        for (idx = 0; idx < limit; idx++)
+        {
+            hash = (hash << 1) + STARB_Chunk_Gear[data[idx]];
+            if ((hash & mask) == 0)
+            {
+                found = true;
+                idx++;
+                break;
+            }
+        }
+
+        chunk->wrtotal += idx;
+        data += idx;
+        count -= idx;
+
+        if (found || len + idx == chunk->maxsize)
+        {
+            STARB_Chunk_Cut(chunk, chunk->wrtotal);
+            hash = 0;
+        }
+    }
+
+    chunk->hash = hash;
+}
+
+/** @brief Queue a boundary and start a new chunk there. */
+static inline void STARB_Chunk_Cut(STARB_Chunk* chunk, const uint32_t pos)
+{
+    if (chunk->cutnum < chunk->cutcount)
+    {
+        uint32_t entry = chunk->cutfirst + chunk->cutnum;
+        entry = (entry >= chunk->cutcount) ? entry - chunk->cutcount : entry;
+        chunk->cuts[entry] = pos;
+        chunk->cutnum++;
+    }
+
+    chunk->start = pos;
+    chunk->hash = 0;
+}
+
+/** @brief Mask of the top `bits` bits (the ones that depend on the most input bytes). */
+static inline uint32_t STARB_Chunk_TopMask(const uint32_t bits)
+{
+    return (bits >= 32) ? 0xFFFFFFFFU : ~(0xFFFFFFFFU >> bits);
+}
@@ -0,0 +1,161 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Chunk.h                                          *
+ *  @brief    Content-defined chunking over the ring stream                  *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Chunk_H
+#define _INC_GH2025_StaticRingBuf_Chunk_H
+
+#include "StaticRingBuf.h"
+
+/** \brief  Struct definition for the content-defined chunker.
+ * \details A StaticRingBuf observer that runs a Gear rolling hash (FastCDC
+ *          style) over the bytes as they are written, in place in the ring
+ *          storage, and queues the chunk boundaries it finds. The consumer
+ *          gets whole chunks as zero-copy spans at the read position and
+ *          releases them, so every byte is copied once (in) and hashed once.
+ *
+ *          Cut rules, with `len` the length of the open chunk:
+ *          - `len < minsize`: no boundary, the bytes are not hashed;
+ *          - `len < avgsize`: boundary when the top log2(avgsize) + 2 hash bits are 0;
+ *          - `len < maxsize`: boundary when the top log2(avgsize) - 2 hash bits are 0;
+ *          - `len == maxsize`: forced boundary.
+ *          The boundaries only depend on the byte stream, not on how it was
+ *          split into writes or on the ring size.
+ *
+ *          Boundaries are kept as stream positions and reported as offsets
+ *          from the read position, so reading, skipping or overwriting part of
+ *          a chunk just shortens it.
+ */
+typedef struct _STARB_Chunk_t
+{
+    STARB_Observer observer;        // Attached to `rbuf` (first member)
+    StaticRingBuf* rbuf;            // Observed ring
+    uint32_t* cuts;                 // Queue of boundary stream positions (`cutcount` entries)
+    uint32_t cutcount;              // Count of entries of `cuts`
+    uint32_t cutfirst;              // Front entry of `cuts`
+    uint32_t cutnum;                // Count of queued boundaries
+    uint32_t minsize;               // Minimum chunk size
+    uint32_t avgsize;               // Normal chunk size (power of 2)
+    uint32_t maxsize;               // Maximum chunk size
+    uint32_t masks;                 // Hash mask below `avgsize` (more bits: cut less likely)
+    uint32_t maskl;                 // Hash mask from `avgsize` on (fewer bits: cut more likely)
+    uint32_t hash;                  // Rolling hash of the open chunk
+    uint32_t start;                 // Stream position where the open chunk starts
+    uint32_t wrtotal;               // Stream position of the next entering byte
+    uint32_t rdtotal;               // Stream position of the next leaving byte (read position)
+
+} STARB_Chunk;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief   Initialize the STARB_Chunk instance and attach it to a ring.
+     *  @details Data already in the ring is chunked starting at the read position.
+     *           Each chunk is at least `minsize` bytes (except flushed ones), so
+     *           `cutcount` >= capacity / minsize + 1 boundaries always fit; a
+     *           boundary found while the queue is full is dropped and its two
+     *           chunks are reported as one.
+     *
+     *  @param[out] chunk   The STARB_Chunk instance to be initialized
+     *  @param[in] rbuf     The StaticRingBuf instance to observe
+     *  @param[in] minsize  Minimum chunk size (1 ~ avgsize)
+     *  @param[in] avgsize  Normal chunk size (power of 2, 4 ~ maxsize)
+     *  @param[in] maxsize  Maximum chunk size (avgsize ~ capacity)
+     *  @param[in] cuts     Boundary queue entries
+     *  @param[in] cutcount Count of entries of `cuts` (>= capacity / minsize + 1)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Chunk_Init(STARB_Chunk* chunk, StaticRingBuf* rbuf, const uint32_t minsize,
+        const uint32_t avgsize, const uint32_t maxsize, uint32_t* cuts, const uint32_t cutcount);
+
+    /** @brief Detach the STARB_Chunk instance from its ring.
+     *
+     *  @param[in] chunk The STARB_Chunk instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+     */
+    uint8_t STARB_Chunk_Detach(STARB_Chunk* chunk);
+
+    /** @brief   End the open chunk at the write position (end of stream / file).
+     *  @details Does nothing when the open chunk is empty.
+     *
+     *  @param[in] chunk The STARB_Chunk instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE4 Failed: Buffer overflow (boundary queue is full).
+     */
+    uint8_t STARB_Chunk_Flush(STARB_Chunk* chunk);
+
+    /** @brief Get the count of complete chunks in the ring. */
+    uint32_t STARB_Chunk_GetCount(STARB_Chunk* chunk);
+
+    /** @brief Get the end of a complete chunk as an offset from the read position.
+     *
+     *  @param[in] chunk   The STARB_Chunk instance
+     *  @param[in] index   Chunk index (0: the chunk at the read position)
+     *  @param[out] offset Offset of the chunk end from the read position
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Chunk_GetBoundary(STARB_Chunk* chunk, const uint32_t index, STARB_CAPTYPE* offset);
+
+    /** @brief   Get the complete chunk at the read position as zero-copy spans.
+     *  @details Mirrored storage always yields 1 span; `STARB_MODE_NOMIRROR` yields
+     *           2 spans when the chunk wraps around the end of the storage.
+     *
+     *  @param[in] chunk  The STARB_Chunk instance
+     *  @param[out] spans Array of 2 spans to receive the chunk
+     *  @return Count of spans filled (0: no complete chunk)
+     */
+    uint8_t STARB_Chunk_Acquire(STARB_Chunk* chunk, STARB_Span spans[2]);
+
+    /** @brief Consume the complete chunk at the read position (StaticRingBuf_Forward()).
+     *
+     *  @param[in] chunk The STARB_Chunk instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Chunk_Release(STARB_Chunk* chunk);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Chunk_H
@@ -0,0 +1,497 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Delta.h"
+
+#define STARB_DELTA_VARMAX  10      // Longest varint (64-bit value)
+#define STARB_DELTA_CHUNK   64      // Encode buffer of STARB_Delta_Write()
+
+static inline uint32_t STARB_Delta_PutVarint(byte* dst, uint64_t value);
+static inline uint32_t STARB_Delta_GetVarint(const byte* src, const uint32_t srclen, uint64_t* value);
+static inline uint64_t STARB_Delta_Unzigzag(const uint64_t value);
+static inline uint32_t STARB_Delta_ShortRun(const byte* src, const uint32_t srclen, const uint32_t maxcount);
+#if STARB_HAS_SSE2
+static inline __m128i STARB_Delta_PrefixSum4(__m128i deltas, __m128i* base);
+static void STARB_Delta_DecodeShort16(const byte* src, int32_t* out, uint64_t* prev);
+#endif
+static void STARB_Delta_AddKey(STARB_Delta* delta, const uint32_t seq, const uint32_t pos);
+static void STARB_Delta_RetireKeys(STARB_Delta* delta);
+static uint8_t STARB_Delta_Decode(STARB_Delta* delta, void* samples, const uint32_t count, uint32_t* readcount);
+
+/** @brief Initialize the STARB_Delta instance.
+ *
+ *  @param[out] delta            The STARB_Delta instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer (mirrored: 2x capacity)
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *  @param[in] type              STARB_DELTA_I32 or STARB_DELTA_I64
+ *  @param[in] keyint            Keyframe interval (>= 1 samples)
+ *  @param[in] keys              Keyframe index entries
+ *  @param[in] keycount          Count of keyframe index entries (>= 1)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Delta_Init(STARB_Delta* delta, const STARB_STOSZTP total_buffer_size, byte* _buffer,
+    const uint8_t type, const uint32_t keyint, STARB_DeltaKey* keys, const uint32_t keycount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (delta == NULL || _buffer == NULL || keys == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if ((type != STARB_DELTA_I32 && type != STARB_DELTA_I64) || keyint < 1 || keycount < 1)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_Init(&delta->rbuf, total_buffer_size, _buffer);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    delta->keys = keys;
+    delta->keycount = keycount;
+    delta->keyfirst = 0;
+    delta->keynum = 0;
+    delta->keyint = keyint;
+    delta->type = type;
+    delta->wrseq = 0;
+    delta->wrpos = 0;
+    delta->wrprev = 0;
+    delta->rdseq = 0;
+    delta->rdpos = 0;
+    delta->rdprev = 0;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Encode and append samples, as many as fit.
+ *
+ *  @param[in] delta    The STARB_Delta instance
+ *  @param[in] samples  Samples (int32_t or int64_t array)
+ *  @param[in] count    Count of samples
+ *  @param[out] written Count of samples written
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE4 Failed: Buffer overflow (only `written` samples fit).
+ */
+uint8_t STARB_Delta_Write(STARB_Delta* delta, const void* samples, const uint32_t count, uint32_t* written)
+{
+    uint8_t rc = STARB_OK;
+
+    if (delta == NULL || samples == NULL || written == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    byte chunk[STARB_DELTA_CHUNK];
+    uint32_t pending = 0;
+    uint32_t space = StaticRingBuf_GetWriteCapacity(&delta->rbuf);
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        uint64_t value = (delta->type == STARB_DELTA_I32)
+            ? (uint64_t)(int64_t)((const int32_t*)samples)[i]
+            : (uint64_t)((const int64_t*)samples)[i];
+
+        /* A keyframe is the difference to 0: the group decodes on its own. */
+        bool keyframe = (delta->wrseq % delta->keyint) == 0;
+        uint64_t diff = value - (keyframe ? 0 : delta->wrprev);
+        uint64_t zigzag = (diff << 1) ^ (uint64_t)((int64_t)diff >> 63);
+
+        if (pending + STARB_DELTA_VARMAX > STARB_DELTA_CHUNK)
+        {
+            StaticRingBuf_WriteItems(&delta->rbuf, chunk, (STARB_CAPTYPE)pending);
+            space -= pending;
+            pending = 0;
+        }
+
+        uint32_t len = STARB_Delta_PutVarint(chunk + pending, zigzag);
+        if (pending + len > space)
+        {
+            rc = STARB_BUFOVERFLOW;
+            break;
+        }
+
+        if (keyframe)
+        {
+            STARB_Delta_AddKey(delta, delta->wrseq, delta->wrpos);
+        }
+
+        pending += len;
+        delta->wrpos += len;
+        delta->wrprev = value;
+        delta->wrseq++;
+    }
+
+    if (pending > 0)
+    {
+        StaticRingBuf_WriteItems(&delta->rbuf, chunk, (STARB_CAPTYPE)pending);
+    }
+
+    *written = i;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Decode and remove up to `count` samples.
+ *
+ *  @param[in] delta      The STARB_Delta instance
+ *  @param[out] samples   Samples (int32_t or int64_t array)
+ *  @param[in] count      Maximum count of samples
+ *  @param[out] readcount Count of samples read
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ *  @retval 0xE6 Failed: Invalid data (malformed varint).
+ */
+uint8_t STARB_Delta_Read(STARB_Delta* delta, void* samples, const uint32_t count, uint32_t* readcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (delta == NULL || samples == NULL || readcount == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    *readcount = 0;
+    if (delta->rdseq == delta->wrseq)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    rc = STARB_Delta_Decode(delta, samples, count, readcount);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Move the reader to sample number `seq`.
+ *  @details Jumps to the last indexed keyframe at or before `seq`, then
+ *           decodes the rest of the way.
+ *
+ *  @param[in] delta The STARB_Delta instance
+ *  @param[in] seq   Sample number (between the next read and the next write)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE6 Failed: Invalid data (malformed varint).
+ */
+uint8_t STARB_Delta_Seek(STARB_Delta* delta, const uint32_t seq)
+{
+    uint8_t rc = STARB_OK;
+
+    if (delta == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    uint32_t target = seq - delta->rdseq;
+    if (target > delta->wrseq - delta->rdseq)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    /* Binary search for the last keyframe at or before `seq` (keys are in sample order). */
+    uint32_t lo = 0;
+    uint32_t hi = delta->keynum;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t index = delta->keyfirst + mid;
+        if (index >= delta->keycount)
+        {
+            index -= delta->keycount;
+        }
+
+        if (delta->keys[index].seq - delta->rdseq <= target)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if (lo > 0)
+    {
+        uint32_t index = delta->keyfirst + lo - 1;
+        if (index >= delta->keycount)
+        {
+            index -= delta->keycount;
+        }
+
+        const STARB_DeltaKey* key = &delta->keys[index];
+        StaticRingBuf_Forward(&delta->rbuf, (STARB_CAPTYPE)(key->pos - delta->rdpos));
+        delta->rdpos = key->pos;
+        delta->rdseq = key->seq;
+        delta->rdprev = 0;
+        STARB_Delta_RetireKeys(delta);
+    }
+
+    /* Decode the remainder of the way in small batches. */
+    int64_t discard[16];
+    while (rc == STARB_OK && delta->rdseq != seq)
+    {
+        uint32_t batch = seq - delta->rdseq;
+        uint32_t step = 0;
+        batch = (batch < 16) ? batch : 16;
+        rc = STARB_Delta_Decode(delta, discard, batch, &step);
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get the count of samples held. */
+uint32_t STARB_Delta_GetSampleCount(STARB_Delta* delta)
+{
+    assert(delta != NULL);
+
+    return delta->wrseq - delta->rdseq;
+}
+
+/** @brief LEB128 encode `value` into `dst` (room for STARB_DELTA_VARMAX bytes); returns the length. */
+static inline uint32_t STARB_Delta_PutVarint(byte* dst, uint64_t value)
+{
+    uint32_t len = 0;
+
+    while (value >= 0x80)
+    {
+        dst[len++] = (byte)(value | 0x80);
+        value >>= 7;
+    }
+    dst[len++] = (byte)value;
+
+    return len;
+}
+
+/** @brief LEB128 decode one value; returns the length, 0 when truncated or malformed. */
+static inline uint32_t STARB_Delta_GetVarint(const byte* src, const uint32_t srclen, uint64_t* value)
+{
+    uint64_t result = 0;
+    uint32_t len = 0;
+    uint32_t decoded = 0;
+
+    while (len < srclen && len < STARB_DELTA_VARMAX)
+    {
+        byte b = src[len];
+        result |= (uint64_t)(b & 0x7F) << (7 * len);
+        len++;
+        if ((b & 0x80) == 0)
+        {
+            *value = result;
+            decoded = len;
+            break;
+        }
+    }
+
+    return decoded;
+}
+
+/** @brief Zig-zag decode (0, 1, 2, 3, ... -> 0, -1, 1, -2, ...). */
+static inline uint64_t STARB_Delta_Unzigzag(const uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+/** @brief   Count of leading 1-byte varints in `src`, in whole blocks, at most `maxcount`.
+ *  @details 16-byte blocks with SSE2 (movemask of the continuation bits),
+ *           8-byte blocks with SWAR otherwise.
+ */
+static inline uint32_t STARB_Delta_ShortRun(const byte* src, const uint32_t srclen, const uint32_t maxcount)
+{
+    uint32_t run = 0;
+    uint32_t limit = (srclen < maxcount) ? srclen : maxcount;
+
+#if STARB_HAS_SSE2
+    while (run + 16 <= limit && _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(src + run))) == 0)
+    {
+        run += 16;
+    }
+#else
+    uint64_t word;
+    while (run + 8 <= limit)
+    {
+        memcpy(&word, src + run, sizeof(word));
+        if ((word & 0x8080808080808080ULL) != 0)
+        {
+            break;
+        }
+        run += 8;
+    }
+#endif
+
+    return run;
+}
+
+#if STARB_HAS_SSE2
+/** @brief Inclusive prefix sum of 4 int32 lanes plus `base`; `base` becomes the last lane (broadcast). */
+static inline __m128i STARB_Delta_PrefixSum4(__m128i deltas, __m128i* base)
+{
+    deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 4));
+    deltas = _mm_add_epi32(deltas, _mm_slli_si128(deltas, 8));
+    deltas = _mm_add_epi32(deltas, *base);
+    *base = _mm_shuffle_epi32(deltas, 0xFF);
+
+    return deltas;
+}
+
+/** @brief Decode 16 1-byte varints as int32 samples: unzig-zag, widen and prefix sum in SSE2 registers. */
+static void STARB_Delta_DecodeShort16(const byte* src, int32_t* out, uint64_t* prev)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bytes = _mm_loadu_si128((const __m128i*)src);
+
+    /* Per byte: (v >> 1) ^ -(v & 1), then sign extend 8 -> 16 -> 32 bits. */
+    __m128i magnitude = _mm_and_si128(_mm_srli_epi16(bytes, 1), _mm_set1_epi8(0x7F));
+    __m128i negative = _mm_sub_epi8(zero, _mm_and_si128(bytes, _mm_set1_epi8(1)));
+    __m128i d8 = _mm_xor_si128(magnitude, negative);
+    __m128i s8 = _mm_cmpgt_epi8(zero, d8);
+    __m128i d16lo = _mm_unpacklo_epi8(d8, s8);
+    __m128i d16hi = _mm_unpackhi_epi8(d8, s8);
+    __m128i s16lo = _mm_cmpgt_epi16(zero, d16lo);
+    __m128i s16hi = _mm_cmpgt_epi16(zero, d16hi);
+    __m128i base = _mm_set1_epi32((int32_t)*prev);
+
+    _mm_storeu_si128((__m128i*)(out + 0), STARB_Delta_PrefixSum4(_mm_unpacklo_epi16(d16lo, s16lo), &base));
+    _mm_storeu_si128((__m128i*)(out + 4), STARB_Delta_PrefixSum4(_mm_unpackhi_epi16(d16lo, s16lo), &base));
+    _mm_storeu_si128((__m128i*)(out + 8), STARB_Delta_PrefixSum4(_mm_unpacklo_epi16(d16hi, s16hi), &base));
+    _mm_storeu_si128((__m128i*)(out + 12), STARB_Delta_PrefixSum4(_mm_unpackhi_epi16(d16hi, s16hi), &base));
+
+    *prev = (uint64_t)(int64_t)_mm_cvtsi128_si32(base);
+}
+#endif
+
+/** @brief Append a keyframe to the index, dropping the oldest one when it is full. */
+static void STARB_Delta_AddKey(STARB_Delta* delta, const uint32_t seq, const uint32_t pos)
+{
+    if (delta->keynum >= delta->keycount)
+    {
+        delta->keyfirst = (delta->keyfirst + 1 < delta->keycount) ? delta->keyfirst + 1 : 0;
+        delta->keynum--;
+    }
+
+    uint32_t index = delta->keyfirst + delta->keynum;
+    if (index >= delta->keycount)
+    {
+        index -= delta->keycount;
+    }
+
+    delta->keys[index].seq = seq;
+    delta->keys[index].pos = pos;
+    delta->keynum++;
+}
+
+/** @brief Drop index entries of keyframes the reader has passed. */
+static void STARB_Delta_RetireKeys(STARB_Delta* delta)
+{
+    while (delta->keynum > 0 && (int32_t)(delta->keys[delta->keyfirst].seq - delta->rdseq) < 0)
+    {
+        delta->keyfirst = (delta->keyfirst + 1 < delta->keycount) ? delta->keyfirst + 1 : 0;
+        delta->keynum--;
+    }
+}
+
+/** @brief   Decode up to `count` samples from the read position and consume them.
+ *  @details Runs of 1-byte varints that do not cross a keyframe take the bulk
+ *           path; everything else is decoded one varint at a time.
+ */
+static uint8_t STARB_Delta_Decode(STARB_Delta* delta, void* samples, const uint32_t count, uint32_t* readcount)
+{
+    uint8_t rc = STARB_OK;
+    const byte* src = StaticRingBuf_GetReadPtr(&delta->rbuf);
+    uint32_t srclen = StaticRingBuf_GetReadCapacity(&delta->rbuf);
+    uint32_t avail = delta->wrseq - delta->rdseq;
+    uint32_t total = (count < avail) ? count : avail;
+    uint32_t ip = 0;
+    uint32_t i = 0;
+
+    while (i < total)
+    {
+        uint32_t phase = delta->rdseq % delta->keyint;
+        if (phase == 0)
+        {
+            delta->rdprev = 0;
+        }
+
+        uint32_t group = delta->keyint - phase;
+        uint32_t run = STARB_Delta_ShortRun(src + ip, srclen - ip, (total - i < group) ? total - i : group);
+        if (run > 0)
+        {
+            uint32_t k = 0;
+#if STARB_HAS_SSE2
+            if (delta->type == STARB_DELTA_I32)
+            {
+                for (; k < run; k += 16)
+                {
+                    STARB_Delta_DecodeShort16(src + ip + k, (int32_t*)samples + i + k, &delta->rdprev);
+                }
+            }
+#endif
+            for (; k < run; k++)
+            {
+                delta->rdprev += STARB_Delta_Unzigzag(src[ip + k]);
+                if (delta->type == STARB_DELTA_I32)
+                {
+                    ((int32_t*)samples)[i + k] = (int32_t)delta->rdprev;
+                }
+                else
+                {
+                    ((int64_t*)samples)[i + k] = (int64_t)delta->rdprev;
+                }
+            }
+
+            ip += run;
+            i += run;
+            delta->rdseq += run;
+            continue;
+        }
+
+        uint64_t zigzag = 0;
+        uint32_t len = STARB_Delta_GetVarint(src + ip, srclen - ip, &zigzag);
+        if (len == 0)
+        {
+            rc = STARB_DATAINVALID;
+            break;
+        }
+
+        delta->rdprev += STARB_Delta_Unzigzag(zigzag);
+        if (delta->type == STARB_DELTA_I32)
+        {
+            ((int32_t*)samples)[i] = (int32_t)delta->rdprev;
+        }
+        else
+        {
+            ((int64_t*)samples)[i] = (int64_t)delta->rdprev;
+        }
+
+        ip += len;
+        i++;
+        delta->rdseq++;
+    }
+
+    StaticRingBuf_Forward(&delta->rbuf, (STARB_CAPTYPE)ip);
+    delta->rdpos += ip;
+    STARB_Delta_RetireKeys(delta);
+    *readcount = i;
+
+    return rc;
+}
@@ -0,0 +1,151 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Delta.h                                          *
+ *  @brief    Delta / varint encoded numeric sample streams.                 *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Delta_H
+#define _INC_GH2025_StaticRingBuf_Delta_H
+
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief Sample types (value: sample size in bytes) */
+#define STARB_DELTA_I32     4       // int32_t samples
+#define STARB_DELTA_I64     8       // int64_t samples
+
+/** @brief Keyframe index entry */
+typedef struct _STARB_DeltaKey_t {
+    uint32_t seq;                   // Sample number of the keyframe
+    uint32_t pos;                   // Stream position of the keyframe
+} STARB_DeltaKey;
+
+/** \brief  Struct definition for the delta / varint sample stream.
+ * \details Samples are stored as the zig-zag encoded difference to the
+ *          previous sample, as LEB128 varints: slowly changing values take
+ *          1 byte per sample instead of 4 or 8. Every `keyint`-th sample is a
+ *          keyframe (difference to 0) and is entered in a small keyframe
+ *          index, so STARB_Delta_Seek() jumps over whole groups without
+ *          decoding them.
+ *
+ *          STARB_Delta_Read() decodes in bulk. Runs of 1-byte varints are
+ *          detected 16 at a time (SSE2 movemask, 8 at a time with SWAR
+ *          otherwise); int32 runs are then unzig-zagged, widened and prefix
+ *          summed in SSE2 registers.
+ *
+ *          Stream positions count bytes since init and wrap at 2^32. One
+ *          producer and one consumer, same thread (no internal locking).
+ */
+typedef struct _STARB_Delta_t
+{
+    StaticRingBuf rbuf;             // Encoded storage (mirrored)
+    STARB_DeltaKey* keys;           // Keyframe index (`keycount` entries)
+    uint32_t keycount;              // Count of index entries
+    uint32_t keyfirst;              // Index entry of the oldest keyframe
+    uint32_t keynum;                // Count of keyframes held
+    uint32_t keyint;                // Keyframe interval (samples)
+    uint8_t type;                   // STARB_DELTA_I32 or STARB_DELTA_I64
+    uint32_t wrseq;                 // Sample number of the next write
+    uint32_t wrpos;                 // Stream position of the next write
+    uint64_t wrprev;                // Last sample written
+    uint32_t rdseq;                 // Sample number of the next read
+    uint32_t rdpos;                 // Stream position of the next read
+    uint64_t rdprev;                // Last sample read
+
+} STARB_Delta;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_Delta instance.
+     *
+     *  @param[out] delta            The STARB_Delta instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer (mirrored: 2x capacity)
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *  @param[in] type              STARB_DELTA_I32 or STARB_DELTA_I64
+     *  @param[in] keyint            Keyframe interval (>= 1 samples)
+     *  @param[in] keys              Keyframe index entries
+     *  @param[in] keycount          Count of keyframe index entries (>= 1)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Delta_Init(STARB_Delta* delta, const STARB_STOSZTP total_buffer_size, byte* _buffer,
+        const uint8_t type, const uint32_t keyint, STARB_DeltaKey* keys, const uint32_t keycount);
+
+    /** @brief Encode and append samples, as many as fit.
+     *
+     *  @param[in] delta    The STARB_Delta instance
+     *  @param[in] samples  Samples (int32_t or int64_t array)
+     *  @param[in] count    Count of samples
+     *  @param[out] written Count of samples written
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE4 Failed: Buffer overflow (only `written` samples fit).
+     */
+    uint8_t STARB_Delta_Write(STARB_Delta* delta, const void* samples, const uint32_t count, uint32_t* written);
+
+    /** @brief Decode and remove up to `count` samples.
+     *
+     *  @param[in] delta      The STARB_Delta instance
+     *  @param[out] samples   Samples (int32_t or int64_t array)
+     *  @param[in] count      Maximum count of samples
+     *  @param[out] readcount Count of samples read
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     *  @retval 0xE6 Failed: Invalid data (malformed varint).
+     */
+    uint8_t STARB_Delta_Read(STARB_Delta* delta, void* samples, const uint32_t count, uint32_t* readcount);
+
+    /** @brief   Move the reader to sample number `seq`.
+     *  @details Jumps to the last indexed keyframe at or before `seq`, then
+     *           decodes the rest of the way.
+     *
+     *  @param[in] delta The STARB_Delta instance
+     *  @param[in] seq   Sample number (between the next read and the next write)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE6 Failed: Invalid data (malformed varint).
+     */
+    uint8_t STARB_Delta_Seek(STARB_Delta* delta, const uint32_t seq);
+
+    /** @brief Get the count of samples held. */
+    uint32_t STARB_Delta_GetSampleCount(STARB_Delta* delta);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Delta_H
@@ -0,0 +1,260 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Desc.h"
+
+static inline uint32_t STARB_DescRing_Distance(const STARB_DescRing* ring, const uint32_t head, const uint32_t tail);
+static inline uint32_t STARB_DescRing_Advance(const STARB_DescRing* ring, const uint32_t index);
+static inline uint32_t STARB_DescRing_Index(const STARB_DescRing* ring, const uint32_t index);
+
+/** @brief Initialize the STARB_DescRing instance.
+ *
+ *  @param[out] ring    The STARB_DescRing instance to be initialized
+ *  @param[in] descs    Descriptor storage
+ *  @param[in] count    Count of descriptors (1 ~ 0xFFFF)
+ *  @param[in] slab     Payload slab
+ *  @param[in] slabsize Size of the payload slab (bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_DescRing_Init(STARB_DescRing* ring, STARB_Desc* descs, const uint32_t count, byte* slab, const uint32_t slabsize)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL || descs == NULL || slab == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (count < 1 || count > UINT16_MAX || slabsize < 1)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(ring, 0, sizeof(STARB_DescRing));
+    ring->descs = descs;
+    ring->slab = slab;
+    ring->count = count;
+    ring->slabsize = slabsize;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Producer] Reserve a contiguous payload block in the slab.
+ *  @details Fails when no descriptor is free, or when no contiguous block of
+ *           `length` bytes is free. A new reservation replaces a pending one.
+ *
+ *  @param[in] ring     The STARB_DescRing instance
+ *  @param[in] length   Payload length (1 ~ 0xFFFF bytes)
+ *  @param[out] payload Pointer to receive the start of the payload block
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow.
+ */
+uint8_t STARB_DescRing_Reserve(STARB_DescRing* ring, const uint16_t length, byte** payload)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL || payload == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (length <= 0 || length > ring->slabsize)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    ring->reserved = 0;
+
+    uint32_t rpos = STARB_LoadAcquire32(&ring->rpos);
+    uint32_t used = STARB_DescRing_Distance(ring, ring->wpos, rpos);
+    if (used >= ring->count)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    if (used <= 0)
+    {
+        /* No live payload: restart at offset 0 to offer the largest block. */
+        ring->head = 0;
+        ring->rsvoffset = 0;
+    }
+    else
+    {
+        /* Live payloads run from the oldest one (`tail`) up to `head`, possibly wrapped. */
+        uint32_t tail = ring->descs[STARB_DescRing_Index(ring, rpos)].offset;
+        if (ring->head > tail && length <= ring->slabsize - ring->head)
+        {
+            ring->rsvoffset = ring->head;
+        }
+        else if (ring->head > tail && length <= tail)
+        {
+            ring->rsvoffset = 0;
+        }
+        else if (ring->head < tail && length <= tail - ring->head)
+        {
+            ring->rsvoffset = ring->head;
+        }
+        else
+        {
+            rc = STARB_BUFOVERFLOW;
+            goto EXIT;
+        }
+    }
+
+    ring->reserved = length;
+    *payload = ring->slab + ring->rsvoffset;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Producer] Publish the pending reservation as a message.
+ *  @details `length` may be shorter than the reservation, but not 0: an empty
+ *           message would make its slab position ambiguous. To drop a
+ *           reservation, just reserve again (or not at all).
+ *
+ *  @param[in] ring   The STARB_DescRing instance
+ *  @param[in] length Payload length actually written (1 ~ reserved bytes)
+ *  @param[in] flags  User defined flags stored in the descriptor
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (no such reservation, bad length).
+ */
+uint8_t STARB_DescRing_Commit(STARB_DescRing* ring, const uint16_t length, const uint16_t flags)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (ring->reserved <= 0 || length <= 0 || length > ring->reserved)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    STARB_Desc* desc = &ring->descs[STARB_DescRing_Index(ring, ring->wpos)];
+    desc->offset = ring->rsvoffset;
+    desc->length = length;
+    desc->flags = flags;
+
+    ring->head = ring->rsvoffset + length;
+    ring->reserved = 0;
+    STARB_StoreRelease32(&ring->wpos, STARB_DescRing_Advance(ring, ring->wpos));
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Consumer] Get count of messages ready to read.
+ *
+ *  @param[in] ring The STARB_DescRing instance
+ *  @return Count of messages
+ */
+uint32_t STARB_DescRing_GetReadCount(STARB_DescRing* ring)
+{
+    assert(ring != NULL);
+
+    return STARB_DescRing_Distance(ring, STARB_LoadAcquire32(&ring->wpos), ring->rpos);
+}
+
+/** @brief   [Consumer] Get the oldest message without releasing it.
+ *  @details The payload stays valid until STARB_DescRing_Release().
+ *
+ *  @param[in] ring     The STARB_DescRing instance
+ *  @param[out] desc    Descriptor of the message
+ *  @param[out] payload Pointer to receive the start of the payload (may be NULL)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_DescRing_Peek(STARB_DescRing* ring, STARB_Desc* desc, byte** payload)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL || desc == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (STARB_DescRing_GetReadCount(ring) <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    *desc = ring->descs[STARB_DescRing_Index(ring, ring->rpos)];
+    if (payload != NULL)
+    {
+        *payload = ring->slab + desc->offset;
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Consumer] Release the oldest message and its payload.
+ *
+ *  @param[in] ring The STARB_DescRing instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_DescRing_Release(STARB_DescRing* ring)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (STARB_DescRing_GetReadCount(ring) <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_StoreRelease32(&ring->rpos, STARB_DescRing_Advance(ring, ring->rpos));
+
+EXIT:
+    return rc;
+}
+
+/** @brief Count of descriptors from `tail` up to `head` (indexes in [0, 2 * count)). */
+static inline uint32_t STARB_DescRing_Distance(const STARB_DescRing* ring, const uint32_t head, const uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + 2 * ring->count - tail);
+}
+
+/** @brief Move an index forward by one descriptor, wrapping at 2 * count. */
+static inline uint32_t STARB_DescRing_Advance(const STARB_DescRing* ring, const uint32_t index)
+{
+    uint32_t next = index + 1;
+    return (next >= 2 * ring->count) ? 0 : next;
+}
+
+/** @brief Descriptor slot of an index. */
+static inline uint32_t STARB_DescRing_Index(const STARB_DescRing* ring, const uint32_t index)
+{
+    return (index >= ring->count) ? (index - ring->count) : index;
+}
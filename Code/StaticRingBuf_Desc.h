@@ -0,0 +1,156 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Desc.h                                           *
+ *  @brief    Descriptor ring over a FIFO payload slab.                      *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Desc_H
+#define _INC_GH2025_StaticRingBuf_Desc_H
+
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief Message descriptor: references one payload in the slab */
+typedef struct _STARB_Desc_t {
+    uint32_t offset;                // Payload offset in the slab
+    uint16_t length;                // Payload length (bytes)
+    uint16_t flags;                 // User defined flags
+} STARB_Desc;
+
+/** \brief  Struct definition for the descriptor ring.
+ * \details Large variable-size messages are handed over without copying: the
+ *          producer reserves the payload in place in the slab, writes it once and
+ *          commits a small descriptor; the consumer reads the payload in place and
+ *          releases the descriptor, which frees the payload.
+ *
+ *          Payloads are allocated and freed in FIFO order. Each payload is one
+ *          contiguous block of the slab: one that does not fit before the end of
+ *          the slab starts at offset 0, the unused tail is skipped.
+ *
+ *          One producer and one consumer may run concurrently: `wpos` / `rpos` are
+ *          published with release semantics, like STARB_Spsc (indexes run in
+ *          [0, 2 * count)).
+ */
+typedef struct _STARB_DescRing_t
+{
+    STARB_Desc* descs;              // Descriptor storage (`count` entries)
+    byte* slab;                     // Payload slab
+    uint32_t count;                 // Descriptor capacity
+    uint32_t slabsize;              // Slab size (bytes)
+
+    volatile uint32_t wpos;         // [Producer] Descriptor write index, published to the consumer
+    uint32_t head;                  // [Producer] Slab offset after the newest payload
+    uint32_t rsvoffset;             // [Producer] Offset of the pending reservation
+    uint32_t reserved;              // [Producer] Length of the pending reservation, 0: none
+
+    volatile uint32_t rpos;         // [Consumer] Descriptor read index, published to the producer
+
+} STARB_DescRing;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_DescRing instance.
+     *
+     *  @param[out] ring    The STARB_DescRing instance to be initialized
+     *  @param[in] descs    Descriptor storage
+     *  @param[in] count    Count of descriptors (1 ~ 0xFFFF)
+     *  @param[in] slab     Payload slab
+     *  @param[in] slabsize Size of the payload slab (bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_DescRing_Init(STARB_DescRing* ring, STARB_Desc* descs, const uint32_t count, byte* slab, const uint32_t slabsize);
+
+    /** @brief   [Producer] Reserve a contiguous payload block in the slab.
+     *  @details Fails when no descriptor is free, or when no contiguous block of
+     *           `length` bytes is free. A new reservation replaces a pending one.
+     *
+     *  @param[in] ring     The STARB_DescRing instance
+     *  @param[in] length   Payload length (1 ~ 0xFFFF bytes)
+     *  @param[out] payload Pointer to receive the start of the payload block
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow.
+     */
+    uint8_t STARB_DescRing_Reserve(STARB_DescRing* ring, const uint16_t length, byte** payload);
+
+    /** @brief   [Producer] Publish the pending reservation as a message.
+     *  @details `length` may be shorter than the reservation, but not 0: an empty
+     *           message would make its slab position ambiguous. To drop a
+     *           reservation, just reserve again (or not at all).
+     *
+     *  @param[in] ring   The STARB_DescRing instance
+     *  @param[in] length Payload length actually written (1 ~ reserved bytes)
+     *  @param[in] flags  User defined flags stored in the descriptor
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (no such reservation, bad length).
+     */
+    uint8_t STARB_DescRing_Commit(STARB_DescRing* ring, const uint16_t length, const uint16_t flags);
+
+    /** @brief [Consumer] Get count of messages ready to read.
+     *
+     *  @param[in] ring The STARB_DescRing instance
+     *  @return Count of messages
+     */
+    uint32_t STARB_DescRing_GetReadCount(STARB_DescRing* ring);
+
+    /** @brief   [Consumer] Get the oldest message without releasing it.
+     *  @details The payload stays valid until STARB_DescRing_Release().
+     *
+     *  @param[in] ring     The STARB_DescRing instance
+     *  @param[out] desc    Descriptor of the message
+     *  @param[out] payload Pointer to receive the start of the payload (may be NULL)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_DescRing_Peek(STARB_DescRing* ring, STARB_Desc* desc, byte** payload);
+
+    /** @brief [Consumer] Release the oldest message and its payload.
+     *
+     *  @param[in] ring The STARB_DescRing instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_DescRing_Release(STARB_DescRing* ring);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Desc_H
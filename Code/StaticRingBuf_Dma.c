@@ -0,0 +1,326 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Dma.h"
+#include "Common/memcopy.h"
+
+static inline void STARB_Dma_Repair(STARB_Dma* dma, const STARB_CAPTYPE count);
+static inline void STARB_Dma_Retire(STARB_Dma* dma);
+
+/** @brief   Initialize the STARB_Dma instance.
+ *  @details Same storage rules as StaticRingBuf_InitMode(); `mode` is either
+ *           `STARB_MODE_DEFAULT` (mirrored) or `STARB_MODE_NOMIRROR`.
+ *           Program the external producer to write circularly over the first
+ *           `rbuf.capacity` bytes of `_buffer`, starting at offset 0.
+ *
+ *  @param[out] dma              The STARB_Dma instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *  @param[in] mode              `STARB_MODE_DEFAULT` or `STARB_MODE_NOMIRROR`
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Dma_Init(STARB_Dma* dma, const STARB_STOSZTP total_buffer_size, byte* _buffer, const uint8_t mode)
+{
+    uint8_t rc = STARB_OK;
+
+    if (dma == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if ((mode & ~STARB_MODE_NOMIRROR) != 0)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_InitMode(&dma->rbuf, total_buffer_size, _buffer, mode);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    dma->mirrored = 0;
+    dma->overruns = 0;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Report the current write offset of the external producer.
+ *  @details Bytes between the previous and the new offset become readable.
+ *           If they exceed the free space, the producer has overwritten unread
+ *           data: the unread data is dropped (the ring restarts empty at `wpos`),
+ *           `overruns` is incremented and 0xE4 is returned.
+ *
+ *  @param[in] dma  The STARB_Dma instance
+ *  @param[in] wpos Producer write offset (0 ~ capacity - 1)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (producer overrun, unread data dropped).
+ */
+uint8_t STARB_Dma_Sync(STARB_Dma* dma, const STARB_CAPTYPE wpos)
+{
+    uint8_t rc = STARB_OK;
+
+    if (dma == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    StaticRingBuf* rbuf = &dma->rbuf;
+    if (wpos >= rbuf->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE arrived =
+        (wpos >= rbuf->wpos) ?
+        wpos - rbuf->wpos :
+        rbuf->capacity - rbuf->wpos + wpos;
+    if (arrived <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (arrived > StaticRingBuf_GetWriteCapacity(rbuf))
+    {
+        rbuf->wpos = wpos;
+        rbuf->rpos = wpos;
+        rbuf->flag.cycle = 0;
+        dma->mirrored = 0;
+        dma->overruns++;
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    if (wpos < rbuf->wpos)
+    {
+        rbuf->flag.cycle = 1;
+    }
+    rbuf->wpos = wpos;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Report the remaining transfer count of the external producer.
+ *  @details Down-counting DMA channels (NDTR / CNDTR style) expose the bytes left
+ *           in the current lap; the write offset is `capacity - remaining`.
+ *
+ *  @param[in] dma       The STARB_Dma instance
+ *  @param[in] remaining Remaining transfer count (0 ~ capacity)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (producer overrun, unread data dropped).
+ */
+uint8_t STARB_Dma_SyncRemaining(STARB_Dma* dma, const STARB_CAPTYPE remaining)
+{
+    uint8_t rc = STARB_OK;
+
+    if (dma == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (remaining > dma->rbuf.capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    /* The counter reads 0 for an instant before the channel reloads it: same offset as a reload. */
+    STARB_CAPTYPE wpos = (remaining <= 0) ? 0 : dma->rbuf.capacity - remaining;
+    rc = STARB_Dma_Sync(dma, wpos);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get reading capacity of the STARB_Dma instance.
+ *
+ *  @param[in] dma The STARB_Dma instance
+ *  @return Reading capacity (bytes)
+ */
+STARB_CAPTYPE STARB_Dma_GetReadCapacity(STARB_Dma* dma)
+{
+    assert(dma != NULL);
+
+    return StaticRingBuf_GetReadCapacity(&dma->rbuf);
+}
+
+/** @brief Read bytes from the STARB_Dma instance's storage buffer.
+ *
+ *  @param[in] dma       The STARB_Dma instance
+ *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+ *  @param[in] readcount The length to read (unit: bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ *  @retval 0xE6 Failed: Invalid data.
+ */
+uint8_t STARB_Dma_ReadItems(STARB_Dma* dma, byte* outbuf, const STARB_CAPTYPE readcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (dma == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    STARB_Dma_Repair(dma, readcount);
+    rc = StaticRingBuf_ReadItems(&dma->rbuf, outbuf, readcount);
+    STARB_Dma_Retire(dma);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Read bytes from the STARB_Dma instance's storage buffer without moving the read position.
+ *
+ *  @param[in] dma       The STARB_Dma instance
+ *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+ *  @param[in] readcount The length to read (unit: bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ *  @retval 0xE6 Failed: Invalid data.
+ */
+uint8_t STARB_Dma_PeekItems(STARB_Dma* dma, byte* outbuf, const STARB_CAPTYPE readcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (dma == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    STARB_Dma_Repair(dma, readcount);
+    rc = StaticRingBuf_PeekItems(&dma->rbuf, outbuf, readcount);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Get reading pointer of the STARB_Dma instance.
+ *  @details Mirrored storage: the whole readable data is contiguous from the
+ *           returned pointer (the mirror is repaired first).
+ *  @note    With `STARB_MODE_NOMIRROR` only `capacity - rpos` bytes are contiguous.
+ */
+byte* STARB_Dma_GetReadPtr(STARB_Dma* dma)
+{
+    STARB_Dma_Repair(dma, StaticRingBuf_GetReadCapacity(&dma->rbuf));
+    return StaticRingBuf_GetReadPtr(&dma->rbuf);
+}
+
+/** @brief Get the readable data of the STARB_Dma instance as contiguous spans.
+ *
+ *  @param[in] dma     The STARB_Dma instance
+ *  @param[out] spans  Array of 2 spans to receive the readable regions
+ *  @return Count of spans filled (0 ~ 2)
+ */
+uint8_t STARB_Dma_GetReadSpans(STARB_Dma* dma, STARB_Span spans[2])
+{
+    uint8_t count = 0;
+
+    if (dma == NULL)
+    {
+        goto EXIT;
+    }
+
+    STARB_Dma_Repair(dma, StaticRingBuf_GetReadCapacity(&dma->rbuf));
+    count = StaticRingBuf_GetReadSpans(&dma->rbuf, spans);
+
+EXIT:
+    return count;
+}
+
+/** @brief Move reading pointer forward (skip bytes) for the STARB_Dma instance.
+ *
+ *  @param[in] dma       The STARB_Dma instance
+ *  @param[in] skipcount The length to move forward (skip)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ *  @retval 0xE6 Failed: Invalid data.
+ */
+uint8_t STARB_Dma_Forward(STARB_Dma* dma, const STARB_CAPTYPE skipcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (dma == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_Forward(&dma->rbuf, skipcount);
+    STARB_Dma_Retire(dma);
+
+EXIT:
+    return rc;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief   Copy the wrapped bytes a read of `count` bytes needs into the mirror region.
+ *  @details The producer only fills `buffer[0, capacity)`. A read starting at `rpos`
+ *           and crossing `capacity` sees `buffer[capacity, ...)`, i.e. the mirror of
+ *           the wrapped bytes `[0, rpos + count - capacity)`. Bytes `[0, mirrored)`
+ *           are already there, so each wrapped byte is copied at most once per lap.
+ */
+static inline void STARB_Dma_Repair(STARB_Dma* dma, const STARB_CAPTYPE count)
+{
+    StaticRingBuf* rbuf = &dma->rbuf;
+
+    if (rbuf->mode & STARB_MODE_NOMIRROR)
+    {
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE readable = StaticRingBuf_GetReadCapacity(rbuf);
+    STARB_STOSZTP end = (STARB_STOSZTP)rbuf->rpos + (count < readable ? count : readable);
+    if (end <= rbuf->capacity)
+    {
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE needed = (STARB_CAPTYPE)(end - rbuf->capacity);
+    if (needed > dma->mirrored)
+    {
+        STARB_MemCopy(rbuf->buffer + rbuf->capacity + dma->mirrored,
+            rbuf->buffer + dma->mirrored, (size_t)needed - dma->mirrored);
+        dma->mirrored = needed;
+    }
+
+EXIT:
+    return;
+}
+
+/** @brief Forget the repaired mirror once no wrapped data is left (the reader left the lap). */
+static inline void STARB_Dma_Retire(STARB_Dma* dma)
+{
+    if (dma->rbuf.flag.cycle == 0)
+    {
+        dma->mirrored = 0;
+    }
+}
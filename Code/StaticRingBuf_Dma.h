@@ -0,0 +1,181 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Dma.h                                            *
+ *  @brief    Static Ring Buffer filled by an external (DMA) producer.       *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Dma_H
+#define _INC_GH2025_StaticRingBuf_Dma_H
+
+#include "StaticRingBuf.h"
+
+/** \brief  Struct definition for the externally fed Static Ring Buffer.
+ * \details The write side of `rbuf` is owned by an external agent, typically a DMA
+ *          channel in circular mode writing into `buffer[0, capacity)`. The agent
+ *          never touches the mirror region and never moves `wpos` by itself: the
+ *          application reports the agent's position (e.g. the NDTR counter) with
+ *          STARB_Dma_Sync() / STARB_Dma_SyncRemaining(), and the ring derives the
+ *          newly arrived bytes from the distance to the previous position.
+ *
+ *          Mirrored storage: the mirror region is repaired lazily, only for the
+ *          wrapped bytes a read actually needs to see contiguously.
+ *          `STARB_MODE_NOMIRROR` storage: nothing to repair, wrapped data is read
+ *          through StaticRingBuf_GetReadSpans() or the split copy of ReadItems.
+ *
+ *          Do not call the StaticRingBuf write functions on `rbuf`.
+ */
+typedef struct _STARB_Dma_t
+{
+    StaticRingBuf rbuf;             // Ring buffer, write side owned by the external producer
+    STARB_CAPTYPE mirrored;         // Wrapped bytes [0, mirrored) already copied to the mirror
+    uint32_t overruns;              // Count of overruns detected by the sync functions
+
+} STARB_Dma;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief   Initialize the STARB_Dma instance.
+     *  @details Same storage rules as StaticRingBuf_InitMode(); `mode` is either
+     *           `STARB_MODE_DEFAULT` (mirrored) or `STARB_MODE_NOMIRROR`.
+     *           Program the external producer to write circularly over the first
+     *           `rbuf.capacity` bytes of `_buffer`, starting at offset 0.
+     *
+     *  @param[out] dma              The STARB_Dma instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *  @param[in] mode              `STARB_MODE_DEFAULT` or `STARB_MODE_NOMIRROR`
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Dma_Init(STARB_Dma* dma, const STARB_STOSZTP total_buffer_size, byte* _buffer, const uint8_t mode);
+
+    /** @brief   Report the current write offset of the external producer.
+     *  @details Bytes between the previous and the new offset become readable.
+     *           If they exceed the free space, the producer has overwritten unread
+     *           data: the unread data is dropped (the ring restarts empty at `wpos`),
+     *           `overruns` is incremented and 0xE4 is returned.
+     *
+     *           A producer moving exactly N * capacity bytes between two calls cannot
+     *           be told apart from an idle one: sync at least twice per lap, e.g. from
+     *           the half-transfer and transfer-complete interrupts plus idle detection.
+     *
+     *  @param[in] dma  The STARB_Dma instance
+     *  @param[in] wpos Producer write offset (0 ~ capacity - 1)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (producer overrun, unread data dropped).
+     */
+    uint8_t STARB_Dma_Sync(STARB_Dma* dma, const STARB_CAPTYPE wpos);
+
+    /** @brief   Report the remaining transfer count of the external producer.
+     *  @details Down-counting DMA channels (NDTR / CNDTR style) expose the bytes left
+     *           in the current lap; the write offset is `capacity - remaining`.
+     *
+     *  @param[in] dma       The STARB_Dma instance
+     *  @param[in] remaining Remaining transfer count (0 ~ capacity)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (producer overrun, unread data dropped).
+     */
+    uint8_t STARB_Dma_SyncRemaining(STARB_Dma* dma, const STARB_CAPTYPE remaining);
+
+    /** @brief Get reading capacity of the STARB_Dma instance.
+     *
+     *  @param[in] dma The STARB_Dma instance
+     *  @return Reading capacity (bytes)
+     */
+    STARB_CAPTYPE STARB_Dma_GetReadCapacity(STARB_Dma* dma);
+
+    /** @brief Read bytes from the STARB_Dma instance's storage buffer.
+     *
+     *  @param[in] dma       The STARB_Dma instance
+     *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+     *  @param[in] readcount The length to read (unit: bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     *  @retval 0xE6 Failed: Invalid data.
+     */
+    uint8_t STARB_Dma_ReadItems(STARB_Dma* dma, byte* outbuf, const STARB_CAPTYPE readcount);
+
+    /** @brief Read bytes from the STARB_Dma instance's storage buffer without moving the read position.
+     *
+     *  @param[in] dma       The STARB_Dma instance
+     *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+     *  @param[in] readcount The length to read (unit: bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     *  @retval 0xE6 Failed: Invalid data.
+     */
+    uint8_t STARB_Dma_PeekItems(STARB_Dma* dma, byte* outbuf, const STARB_CAPTYPE readcount);
+
+    /** @brief   Get reading pointer of the STARB_Dma instance.
+     *  @details Mirrored storage: the whole readable data is contiguous from the
+     *           returned pointer (the mirror is repaired first).
+     *  @note    With `STARB_MODE_NOMIRROR` only `capacity - rpos` bytes are contiguous.
+     */
+    byte* STARB_Dma_GetReadPtr(STARB_Dma* dma);
+
+    /** @brief Get the readable data of the STARB_Dma instance as contiguous spans.
+     *
+     *  @param[in] dma     The STARB_Dma instance
+     *  @param[out] spans  Array of 2 spans to receive the readable regions
+     *  @return Count of spans filled (0 ~ 2)
+     */
+    uint8_t STARB_Dma_GetReadSpans(STARB_Dma* dma, STARB_Span spans[2]);
+
+    /** @brief Move reading pointer forward (skip bytes) for the STARB_Dma instance.
+     *
+     *  @param[in] dma       The STARB_Dma instance
+     *  @param[in] skipcount The length to move forward (skip)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     *  @retval 0xE6 Failed: Invalid data.
+     */
+    uint8_t STARB_Dma_Forward(STARB_Dma* dma, const STARB_CAPTYPE skipcount);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Dma_H
@@ -0,0 +1,171 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Inline.h                                         *
+ *  @brief    Unchecked inline hot-path API of the Static Ring Buffer.       *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *  2026/10/19 | 0.1.1.0   | agent      | Fall back when observers attached  *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+#ifndef _INC_GH2025_StaticRingBuf_Inline_H
+#define _INC_GH2025_StaticRingBuf_Inline_H
+
+#include <assert.h>
+#include "StaticRingBuf.h"
+#include "Common/memcopy.h"
+
+/** @brief   Unchecked inline API.
+ *  @details These functions are meant to be inlined into the caller's hot loop:
+ *           preconditions are asserted in debug builds only, nothing is re-checked
+ *           in release builds, and they return transferred counts (partial transfers
+ *           allowed) instead of status codes.
+ *           Instances with non-default mode bits or attached observers fall back
+ *           to the checked API.
+ *           MISRA-conformant callers keep using the checked functions in StaticRingBuf.h.
+ */
+
+/** @brief Write up to `count` bytes, as many as fit.
+ *
+ *  @param[in] rbuf     The StaticRingBuf instance (initialized)
+ *  @param[in] srcbuf   Pointer to source data buffer to be written
+ *  @param[in] count    Maximum data length to be written
+ *  @return Written length (bytes)
+ */
+static inline STARB_CAPTYPE StaticRingBuf_TryPush(StaticRingBuf* rbuf, const byte* srcbuf, const STARB_CAPTYPE count)
+{
+    STARB_CAPTYPE wpos, n;
+    byte* dst;
+
+    assert(rbuf != NULL && rbuf->buffer != NULL);
+    assert(srcbuf != NULL || count == 0);
+    assert(rbuf->flag.cycle ? (rbuf->rpos >= rbuf->wpos) : (rbuf->rpos <= rbuf->wpos));
+
+    wpos = rbuf->wpos;
+    n = rbuf->flag.cycle ? (STARB_CAPTYPE)(rbuf->rpos - wpos) : (STARB_CAPTYPE)(rbuf->capacity - wpos + rbuf->rpos);
+    if (n > count)
+    {
+        n = count;
+    }
+
+    if (rbuf->mode != STARB_MODE_DEFAULT || rbuf->observer != NULL)
+    {
+        n = (StaticRingBuf_WriteItems(rbuf, (byte*)srcbuf, n) == STARB_OK) ? n : 0;
+        goto EXIT;
+    }
+
+    dst = rbuf->buffer + wpos;
+    STARB_MemCopy(dst, srcbuf, n);
+    if ((size_t)wpos + n <= rbuf->capacity)
+    {
+        STARB_MemCopy(dst + rbuf->capacity, srcbuf, n);
+    }
+    else
+    {
+        STARB_CAPTYPE countL = rbuf->capacity - wpos;
+        STARB_CAPTYPE countR = n - countL;
+        STARB_MemCopy(dst + rbuf->capacity, srcbuf, countL);
+        STARB_MemCopy(rbuf->buffer, srcbuf + countL, countR);
+    }
+
+    if ((size_t)wpos + n >= rbuf->capacity)
+    {
+        rbuf->wpos = (STARB_CAPTYPE)((size_t)wpos + n - rbuf->capacity);
+        rbuf->flag.cycle = 1;
+    }
+    else
+    {
+        rbuf->wpos = wpos + n;
+    }
+
+EXIT:
+    return n;
+}
+
+/** @brief Read up to `count` bytes, as many as available.
+ *
+ *  @param[in] rbuf     The StaticRingBuf instance (initialized)
+ *  @param[out] outbuf  Pointer to the output buffer to hold the read result
+ *  @param[in] count    Maximum length to read (bytes)
+ *  @return Read length (bytes)
+ */
+static inline STARB_CAPTYPE StaticRingBuf_TryPop(StaticRingBuf* rbuf, byte* outbuf, const STARB_CAPTYPE count)
+{
+    STARB_CAPTYPE rpos, n;
+
+    assert(rbuf != NULL && rbuf->buffer != NULL);
+    assert(outbuf != NULL || count == 0);
+    assert(rbuf->flag.cycle ? (rbuf->rpos >= rbuf->wpos) : (rbuf->rpos <= rbuf->wpos));
+
+    rpos = rbuf->rpos;
+    n = rbuf->flag.cycle ? (STARB_CAPTYPE)(rbuf->capacity - rpos + rbuf->wpos) : (STARB_CAPTYPE)(rbuf->wpos - rpos);
+    if (n > count)
+    {
+        n = count;
+    }
+
+    if (rbuf->mode != STARB_MODE_DEFAULT || rbuf->observer != NULL)
+    {
+        n = (StaticRingBuf_ReadItems(rbuf, outbuf, n) == STARB_OK) ? n : 0;
+        goto EXIT;
+    }
+
+    STARB_MemCopy(outbuf, rbuf->buffer + rpos, n);
+
+    if ((size_t)rpos + n >= rbuf->capacity)
+    {
+        rbuf->rpos = (STARB_CAPTYPE)((size_t)rpos + n - rbuf->capacity);
+        rbuf->flag.cycle = 0;
+    }
+    else
+    {
+        rbuf->rpos = rpos + n;
+    }
+
+EXIT:
+    return n;
+}
+
+/** @brief Write 1 byte if there is space.
+ *
+ *  @param[in] rbuf     The StaticRingBuf instance (initialized)
+ *  @param[in] _elem    Content to be written
+ *  @return Written length (0 or 1)
+ */
+static inline STARB_CAPTYPE StaticRingBuf_TryPushByte(StaticRingBuf* rbuf, const byte _elem)
+{
+    return StaticRingBuf_TryPush(rbuf, &_elem, 1);
+}
+
+/** @brief Read 1 byte if there is data.
+ *
+ *  @param[in] rbuf     The StaticRingBuf instance (initialized)
+ *  @param[out] _elem   Pointer to output the read content
+ *  @return Read length (0 or 1)
+ */
+static inline STARB_CAPTYPE StaticRingBuf_TryPopByte(StaticRingBuf* rbuf, byte* _elem)
+{
+    return StaticRingBuf_TryPop(rbuf, _elem, 1);
+}
+
+#endif // !_INC_GH2025_StaticRingBuf_Inline_H
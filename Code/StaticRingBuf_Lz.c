@@ -0,0 +1,482 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Lz.h"
+
+#define STARB_LZ_MINMATCH   4       // Shortest match worth a sequence
+#define STARB_LZ_RUNMASK    15      // Length nibble value meaning "more length bytes follow"
+
+static inline uint32_t STARB_Lz_Read32(const byte* ptr);
+static inline uint32_t STARB_Lz_Hash(const uint32_t sequence);
+static inline byte* STARB_Lz_PutLength(byte* op, const byte* oend, uint32_t len);
+static byte* STARB_Lz_PutSequence(byte* op, const byte* oend, const byte* literals, const uint32_t litlen, const uint32_t offset, const uint32_t matchlen);
+static void STARB_Lz_DropOldest(STARB_Lz* lz);
+
+/** @brief Compress a block.
+ *
+ *  @param[in] src     Data to compress
+ *  @param[in] srclen  Length of `src`
+ *  @param[out] dst    Buffer for the compressed block
+ *  @param[in] dstmax  Size of `dst`
+ *  @param[in] table   Working memory, `1 << STARB_LZ_HASHLOG` entries
+ *  @return Compressed length, or 0 when it does not fit in `dstmax`
+ */
+STARB_CAPTYPE STARB_Lz_Compress(const byte* src, const STARB_CAPTYPE srclen, byte* dst, const STARB_CAPTYPE dstmax, uint16_t* table)
+{
+    STARB_CAPTYPE clen = 0;
+
+    if (src == NULL || dst == NULL || table == NULL || srclen <= 0)
+    {
+        goto EXIT;
+    }
+
+    memset(table, 0, sizeof(uint16_t) << STARB_LZ_HASHLOG);
+
+    byte* op = dst;
+    const byte* oend = dst + dstmax;
+    uint32_t ip = 0;
+    uint32_t anchor = 0;
+
+    /* Greedy parse: the last position seen with the same 4-byte hash is the match candidate. */
+    while (ip + STARB_LZ_MINMATCH <= srclen)
+    {
+        uint32_t sequence = STARB_Lz_Read32(src + ip);
+        uint32_t hash = STARB_Lz_Hash(sequence);
+        uint32_t ref = table[hash];
+        table[hash] = (uint16_t)ip;
+
+        if (ref >= ip || STARB_Lz_Read32(src + ref) != sequence)
+        {
+            ip++;
+            continue;
+        }
+
+        uint32_t matchlen = STARB_LZ_MINMATCH;
+        while (ip + matchlen < srclen && src[ref + matchlen] == src[ip + matchlen])
+        {
+            matchlen++;
+        }
+
+        op = STARB_Lz_PutSequence(op, oend, src + anchor, ip - anchor, ip - ref, matchlen);
+        if (op == NULL)
+        {
+            goto EXIT;
+        }
+
+        ip += matchlen;
+        anchor = ip;
+    }
+
+    /* Last sequence: literals only. */
+    op = STARB_Lz_PutSequence(op, oend, src + anchor, srclen - anchor, 0, 0);
+    if (op == NULL)
+    {
+        goto EXIT;
+    }
+
+    clen = (STARB_CAPTYPE)(op - dst);
+
+EXIT:
+    return clen;
+}
+
+/** @brief Decompress a block (all input is bounds checked).
+ *
+ *  @param[in] src     Compressed block
+ *  @param[in] srclen  Length of `src`
+ *  @param[out] dst    Buffer for the original data
+ *  @param[in] dstmax  Size of `dst`
+ *  @return Original length, or 0 when the block is corrupt or does not fit
+ */
+STARB_CAPTYPE STARB_Lz_Decompress(const byte* src, const STARB_CAPTYPE srclen, byte* dst, const STARB_CAPTYPE dstmax)
+{
+    STARB_CAPTYPE dlen = 0;
+
+    if (src == NULL || dst == NULL || srclen <= 0)
+    {
+        goto EXIT;
+    }
+
+    const byte* ip = src;
+    const byte* iend = src + srclen;
+    byte* op = dst;
+    const byte* oend = dst + dstmax;
+
+    while (ip < iend)
+    {
+        uint32_t token = *ip++;
+        uint32_t len = token >> 4;
+        uint32_t extra = 0;
+
+        if (len == STARB_LZ_RUNMASK)
+        {
+            do
+            {
+                if (ip >= iend)
+                {
+                    goto EXIT;
+                }
+                extra = *ip++;
+                len += extra;
+            } while (extra == 255);
+        }
+
+        if (len > (size_t)(iend - ip) || len > (size_t)(oend - op))
+        {
+            goto EXIT;
+        }
+
+        memcpy(op, ip, len);
+        ip += len;
+        op += len;
+
+        /* Only the last sequence ends after its literals: input that runs
+         * out right after a match is a truncated block. */
+        if (ip == iend)
+        {
+            dlen = (STARB_CAPTYPE)(op - dst);
+            goto EXIT;
+        }
+
+        if (iend - ip < 2)
+        {
+            goto EXIT;
+        }
+
+        uint32_t offset = (uint32_t)ip[0] | ((uint32_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst))
+        {
+            goto EXIT;
+        }
+
+        len = (token & STARB_LZ_RUNMASK) + STARB_LZ_MINMATCH;
+        if ((token & STARB_LZ_RUNMASK) == STARB_LZ_RUNMASK)
+        {
+            do
+            {
+                if (ip >= iend)
+                {
+                    goto EXIT;
+                }
+                extra = *ip++;
+                len += extra;
+            } while (extra == 255);
+        }
+
+        if (len > (size_t)(oend - op))
+        {
+            goto EXIT;
+        }
+
+        /* Byte copy: the match may overlap the bytes it produces (runs). */
+        const byte* match = op - offset;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            op[i] = match[i];
+        }
+        op += len;
+    }
+
+EXIT:
+    return dlen;
+}
+
+/** @brief Initialize the STARB_Lz instance.
+ *
+ *  @param[out] lz               The STARB_Lz instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer (mirrored: 2x capacity)
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *  @param[in] blocks            Block index entries
+ *  @param[in] blockcount        Count of block index entries (>= 1)
+ *  @param[in] scratch           Compression scratch buffer (`blockmax` bytes)
+ *  @param[in] blockmax          Maximum block length (1 ~ capacity)
+ *  @param[in] mode              STARB_LZ_DEFAULT or STARB_LZ_OVERWRITE
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Lz_Init(STARB_Lz* lz, const STARB_STOSZTP total_buffer_size, byte* _buffer,
+    STARB_LzBlock* blocks, const uint32_t blockcount, byte* scratch, const STARB_CAPTYPE blockmax, const uint8_t mode)
+{
+    uint8_t rc = STARB_OK;
+
+    if (lz == NULL || _buffer == NULL || blocks == NULL || scratch == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (blockcount < 1 || blockmax < 1 || blockmax > total_buffer_size / 2 || (mode & ~STARB_LZ_OVERWRITE))
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_Init(&lz->rbuf, total_buffer_size, _buffer);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    lz->blocks = blocks;
+    lz->blockcount = blockcount;
+    lz->first = 0;
+    lz->num = 0;
+    lz->rawbytes = 0;
+    lz->scratch = scratch;
+    lz->blockmax = blockmax;
+    lz->mode = mode;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Compress and commit one block.
+ *
+ *  @param[in] lz     The STARB_Lz instance
+ *  @param[in] srcbuf Block data
+ *  @param[in] rawlen Block length (1 ~ `blockmax`)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (ring or index full, STARB_LZ_DEFAULT mode).
+ */
+uint8_t STARB_Lz_Write(STARB_Lz* lz, const byte* srcbuf, const STARB_CAPTYPE rawlen)
+{
+    uint8_t rc = STARB_OK;
+
+    if (lz == NULL || srcbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (rawlen < 1 || rawlen > lz->blockmax)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    /* Keep the compressed form only when it is shorter. */
+    const byte* data = lz->scratch;
+    STARB_CAPTYPE clen = STARB_Lz_Compress(srcbuf, rawlen, lz->scratch, rawlen - 1, lz->table);
+    if (clen <= 0)
+    {
+        data = srcbuf;
+        clen = rawlen;
+    }
+
+    while (lz->num >= lz->blockcount || StaticRingBuf_GetWriteCapacity(&lz->rbuf) < clen)
+    {
+        if ((lz->mode & STARB_LZ_OVERWRITE) == 0)
+        {
+            rc = STARB_BUFOVERFLOW;
+            goto EXIT;
+        }
+
+        STARB_Lz_DropOldest(lz);
+    }
+
+    StaticRingBuf_WriteItems(&lz->rbuf, (byte*)data, clen);
+
+    uint32_t index = lz->first + lz->num;
+    if (index >= lz->blockcount)
+    {
+        index -= lz->blockcount;
+    }
+
+    lz->blocks[index].clen = clen;
+    lz->blocks[index].rawlen = rawlen;
+    lz->num++;
+    lz->rawbytes += rawlen;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Decompress and remove the oldest block.
+ *
+ *  @param[in] lz      The STARB_Lz instance
+ *  @param[out] outbuf Buffer for the block data
+ *  @param[in] outmax  Size of `outbuf`
+ *  @param[out] rawlen Block length
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (`outbuf` too small).
+ *  @retval 0xE5 Failed: No (enough) data.
+ *  @retval 0xE6 Failed: Invalid data (corrupt block; it is removed).
+ */
+uint8_t STARB_Lz_Read(STARB_Lz* lz, byte* outbuf, const STARB_CAPTYPE outmax, STARB_CAPTYPE* rawlen)
+{
+    uint8_t rc = STARB_OK;
+
+    if (lz == NULL || outbuf == NULL || rawlen == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (lz->num <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    const STARB_LzBlock* block = &lz->blocks[lz->first];
+    if (outmax < block->rawlen)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    const byte* stored = StaticRingBuf_GetReadPtr(&lz->rbuf);
+    if (block->clen == block->rawlen)
+    {
+        memcpy(outbuf, stored, block->rawlen);
+    }
+    else if (STARB_Lz_Decompress(stored, block->clen, outbuf, block->rawlen) != block->rawlen)
+    {
+        rc = STARB_DATAINVALID;
+    }
+
+    *rawlen = (rc == STARB_OK) ? block->rawlen : 0;
+    STARB_Lz_DropOldest(lz);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get the original length of the oldest block (0: no block). */
+STARB_CAPTYPE STARB_Lz_PeekRawLen(STARB_Lz* lz)
+{
+    assert(lz != NULL);
+
+    return (lz->num > 0) ? lz->blocks[lz->first].rawlen : 0;
+}
+
+/** @brief Remove whole blocks without decoding them.
+ *
+ *  @param[in] lz    The STARB_Lz instance
+ *  @param[in] count Count of blocks to skip
+ *  @return Count of blocks skipped
+ */
+uint32_t STARB_Lz_Skip(STARB_Lz* lz, const uint32_t count)
+{
+    uint32_t skipped = 0;
+
+    assert(lz != NULL);
+
+    while (skipped < count && lz->num > 0)
+    {
+        STARB_Lz_DropOldest(lz);
+        skipped++;
+    }
+
+    return skipped;
+}
+
+/** @brief Unaligned 32-bit load. */
+static inline uint32_t STARB_Lz_Read32(const byte* ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(uint32_t));
+    return value;
+}
+
+/** @brief Multiplicative (Fibonacci) hash of 4 bytes into STARB_LZ_HASHLOG bits. */
+static inline uint32_t STARB_Lz_Hash(const uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - STARB_LZ_HASHLOG);
+}
+
+/** @brief Write the extra length bytes (255, 255, ..., rest); NULL when out of room. */
+static inline byte* STARB_Lz_PutLength(byte* op, const byte* oend, uint32_t len)
+{
+    while (len >= 255 && op < oend)
+    {
+        *op++ = 255;
+        len -= 255;
+    }
+
+    if (op >= oend)
+    {
+        op = NULL;
+    }
+    else
+    {
+        *op++ = (byte)len;
+    }
+
+    return op;
+}
+
+/** @brief   Write one sequence: token, literals, then offset and match length.
+ *  @details `matchlen` 0 writes the final, literals-only sequence.
+ *           Returns NULL when `dst` runs out of room.
+ */
+static byte* STARB_Lz_PutSequence(byte* op, const byte* oend, const byte* literals, const uint32_t litlen, const uint32_t offset, const uint32_t matchlen)
+{
+    uint32_t mcode = (matchlen > 0) ? matchlen - STARB_LZ_MINMATCH : 0;
+    byte* token = NULL;
+
+    if (op >= oend)
+    {
+        op = NULL;
+        goto EXIT;
+    }
+
+    token = op++;
+    *token = (byte)(((litlen < STARB_LZ_RUNMASK) ? litlen : STARB_LZ_RUNMASK) << 4);
+    if (litlen >= STARB_LZ_RUNMASK)
+    {
+        op = STARB_Lz_PutLength(op, oend, litlen - STARB_LZ_RUNMASK);
+        if (op == NULL)
+        {
+            goto EXIT;
+        }
+    }
+
+    if (litlen > (size_t)(oend - op))
+    {
+        op = NULL;
+        goto EXIT;
+    }
+    memcpy(op, literals, litlen);
+    op += litlen;
+
+    if (matchlen <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (oend - op < 2)
+    {
+        op = NULL;
+        goto EXIT;
+    }
+    *op++ = (byte)(offset & 0xFF);
+    *op++ = (byte)(offset >> 8);
+
+    *token |= (byte)((mcode < STARB_LZ_RUNMASK) ? mcode : STARB_LZ_RUNMASK);
+    if (mcode >= STARB_LZ_RUNMASK)
+    {
+        op = STARB_Lz_PutLength(op, oend, mcode - STARB_LZ_RUNMASK);
+    }
+
+EXIT:
+    return op;
+}
+
+/** @brief Remove the oldest block from the ring and the index. */
+static void STARB_Lz_DropOldest(STARB_Lz* lz)
+{
+    const STARB_LzBlock* block = &lz->blocks[lz->first];
+
+    StaticRingBuf_Forward(&lz->rbuf, block->clen);
+    lz->rawbytes -= block->rawlen;
+    lz->first = (lz->first + 1 < lz->blockcount) ? lz->first + 1 : 0;
+    lz->num--;
+}
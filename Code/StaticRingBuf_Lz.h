@@ -0,0 +1,168 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Lz.h                                             *
+ *  @brief    LZ77 block compression stage for rings.                        *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Lz_H
+#define _INC_GH2025_StaticRingBuf_Lz_H
+
+#include "StaticRingBuf.h"
+
+/** @brief Tech Decision Macros */
+
+/** @brief Match finder hash table size (log2 of entries, 2 bytes each) */
+#ifndef STARB_LZ_HASHLOG
+#define STARB_LZ_HASHLOG    12
+#endif
+
+/** @brief Compression stage mode bits */
+#define STARB_LZ_DEFAULT    0x00
+#define STARB_LZ_OVERWRITE  0x01    // Drop the oldest blocks to make room for a new one
+
+/** @brief Block index entry */
+typedef struct _STARB_LzBlock_t {
+    STARB_CAPTYPE clen;             // Stored length (== rawlen: stored uncompressed)
+    STARB_CAPTYPE rawlen;           // Original length
+} STARB_LzBlock;
+
+/** \brief  Struct definition for the compressed block ring.
+ * \details Each committed block is compressed with an in-tree LZ77 codec
+ *          (LZ4-style sequences: token, literals, 16-bit offset, match length)
+ *          and the result is written to a mirrored StaticRingBuf. Blocks that
+ *          do not shrink are stored as they are. Block boundaries live in a
+ *          small index ring, so a reader can skip whole blocks without
+ *          decoding them, and every block decodes on its own.
+ *
+ *          Working memory is static: the match finder table is part of the
+ *          struct, and the caller supplies a scratch buffer of `blockmax`
+ *          bytes for the compressed output. Decoding reads straight from the
+ *          ring (mirror: contiguous).
+ */
+typedef struct _STARB_Lz_t
+{
+    StaticRingBuf rbuf;             // Compressed block storage (mirrored)
+    STARB_LzBlock* blocks;          // Block index (`blockcount` entries)
+    uint32_t blockcount;            // Count of index entries
+    uint32_t first;                 // Index entry of the oldest block
+    uint32_t num;                   // Count of blocks held
+    uint32_t rawbytes;              // Original bytes held
+    byte* scratch;                  // Compressed output scratch (`blockmax` bytes)
+    STARB_CAPTYPE blockmax;         // Maximum block length
+    uint8_t mode;                   // STARB_LZ_xxx
+    uint16_t table[1 << STARB_LZ_HASHLOG];  // Match finder working memory
+
+} STARB_Lz;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Compress a block.
+     *
+     *  @param[in] src     Data to compress
+     *  @param[in] srclen  Length of `src`
+     *  @param[out] dst    Buffer for the compressed block
+     *  @param[in] dstmax  Size of `dst`
+     *  @param[in] table   Working memory, `1 << STARB_LZ_HASHLOG` entries
+     *  @return Compressed length, or 0 when it does not fit in `dstmax`
+     */
+    STARB_CAPTYPE STARB_Lz_Compress(const byte* src, const STARB_CAPTYPE srclen, byte* dst, const STARB_CAPTYPE dstmax, uint16_t* table);
+
+    /** @brief Decompress a block (all input is bounds checked).
+     *
+     *  @param[in] src     Compressed block
+     *  @param[in] srclen  Length of `src`
+     *  @param[out] dst    Buffer for the original data
+     *  @param[in] dstmax  Size of `dst`
+     *  @return Original length, or 0 when the block is corrupt or does not fit
+     */
+    STARB_CAPTYPE STARB_Lz_Decompress(const byte* src, const STARB_CAPTYPE srclen, byte* dst, const STARB_CAPTYPE dstmax);
+
+    /** @brief Initialize the STARB_Lz instance.
+     *
+     *  @param[out] lz               The STARB_Lz instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer (mirrored: 2x capacity)
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *  @param[in] blocks            Block index entries
+     *  @param[in] blockcount        Count of block index entries (>= 1)
+     *  @param[in] scratch           Compression scratch buffer (`blockmax` bytes)
+     *  @param[in] blockmax          Maximum block length (1 ~ capacity)
+     *  @param[in] mode              STARB_LZ_DEFAULT or STARB_LZ_OVERWRITE
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Lz_Init(STARB_Lz* lz, const STARB_STOSZTP total_buffer_size, byte* _buffer,
+        STARB_LzBlock* blocks, const uint32_t blockcount, byte* scratch, const STARB_CAPTYPE blockmax, const uint8_t mode);
+
+    /** @brief Compress and commit one block.
+     *
+     *  @param[in] lz     The STARB_Lz instance
+     *  @param[in] srcbuf Block data
+     *  @param[in] rawlen Block length (1 ~ `blockmax`)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (ring or index full, STARB_LZ_DEFAULT mode).
+     */
+    uint8_t STARB_Lz_Write(STARB_Lz* lz, const byte* srcbuf, const STARB_CAPTYPE rawlen);
+
+    /** @brief Decompress and remove the oldest block.
+     *
+     *  @param[in] lz      The STARB_Lz instance
+     *  @param[out] outbuf Buffer for the block data
+     *  @param[in] outmax  Size of `outbuf`
+     *  @param[out] rawlen Block length
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (`outbuf` too small).
+     *  @retval 0xE5 Failed: No (enough) data.
+     *  @retval 0xE6 Failed: Invalid data (corrupt block; it is removed).
+     */
+    uint8_t STARB_Lz_Read(STARB_Lz* lz, byte* outbuf, const STARB_CAPTYPE outmax, STARB_CAPTYPE* rawlen);
+
+    /** @brief Get the original length of the oldest block (0: no block). */
+    STARB_CAPTYPE STARB_Lz_PeekRawLen(STARB_Lz* lz);
+
+    /** @brief Remove whole blocks without decoding them.
+     *
+     *  @param[in] lz    The STARB_Lz instance
+     *  @param[in] count Count of blocks to skip
+     *  @return Count of blocks skipped
+     */
+    uint32_t STARB_Lz_Skip(STARB_Lz* lz, const uint32_t count);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Lz_H
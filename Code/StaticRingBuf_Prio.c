@@ -0,0 +1,208 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Prio.h"
+
+static inline uint32_t STARB_Prio_NextFrom(const uint32_t mask, const uint32_t start);
+
+/** @brief Initialize the STARB_Prio instance over initialized lane rings.
+ *
+ *  @param[out] prio   The STARB_Prio instance to be initialized
+ *  @param[in] lanes   Lane rings (`count` entries)
+ *  @param[in] count   Count of lanes (1 ~ STARB_PRIO_MAXLANES)
+ *  @param[in] weights Weight per lane (0: strict), or NULL for strict priority only
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Prio_Init(STARB_Prio* prio, StaticRingBuf* lanes, const uint32_t count, const uint16_t* weights)
+{
+    uint8_t rc = STARB_OK;
+
+    if (prio == NULL || lanes == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (count < 1 || count > STARB_PRIO_MAXLANES)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(prio, 0, sizeof(STARB_Prio));
+    prio->lanes = lanes;
+    prio->weights = weights;
+    prio->count = count;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (weights == NULL || weights[i] == 0)
+        {
+            prio->strict |= 1UL << i;
+        }
+
+        STARB_Prio_Refresh(prio, i);
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Write bytes to a lane.
+ *
+ *  @param[in] prio       The STARB_Prio instance
+ *  @param[in] lane       Lane number
+ *  @param[in] srcbuf     Data to write
+ *  @param[in] writecount Count of bytes to write
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow.
+ */
+uint8_t STARB_Prio_Write(STARB_Prio* prio, const uint32_t lane, byte* srcbuf, const STARB_CAPTYPE writecount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (prio == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (lane >= prio->count)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_WriteItems(&prio->lanes[lane], srcbuf, writecount);
+    if (rc == STARB_OK && writecount > 0)
+    {
+        prio->ready |= 1UL << lane;
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Read up to `maxcount` bytes from the lane whose turn it is.
+ *
+ *  @param[in] prio       The STARB_Prio instance
+ *  @param[out] outbuf    Buffer to receive the data
+ *  @param[in] maxcount   Maximum count of bytes to read (at least 1)
+ *  @param[out] readcount Count of bytes read
+ *  @param[out] lane      Lane served
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (`maxcount` is 0).
+ *  @retval 0xE5 Failed: No (enough) data (all lanes empty).
+ */
+uint8_t STARB_Prio_Read(STARB_Prio* prio, byte* outbuf, const STARB_CAPTYPE maxcount, STARB_CAPTYPE* readcount, uint32_t* lane)
+{
+    uint8_t rc = STARB_OK;
+
+    if (prio == NULL || outbuf == NULL || readcount == NULL || lane == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (maxcount <= 0)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    *readcount = 0;
+    *lane = STARB_Prio_Select(prio);
+    if (*lane >= prio->count)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    StaticRingBuf* rbuf = &prio->lanes[*lane];
+    STARB_CAPTYPE count = StaticRingBuf_GetReadCapacity(rbuf);
+    if (count > maxcount)
+    {
+        count = maxcount;
+    }
+
+    rc = StaticRingBuf_ReadItems(rbuf, outbuf, count);
+    if (rc == STARB_OK)
+    {
+        *readcount = count;
+    }
+
+    STARB_Prio_Refresh(prio, *lane);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Pick the lane to serve next, and charge the read to it.
+ *  @details For zero-copy reads on the lane ring itself; call
+ *           STARB_Prio_Refresh() on the lane afterwards.
+ *
+ *  @param[in] prio The STARB_Prio instance
+ *  @return Lane number, or `prio->count` when all lanes are empty
+ */
+uint32_t STARB_Prio_Select(STARB_Prio* prio)
+{
+    assert(prio != NULL);
+
+    uint32_t lane = prio->count;
+
+    uint32_t strict = prio->ready & prio->strict;
+    if (strict != 0)
+    {
+        lane = STARB_Ctz32(strict);
+        goto EXIT;
+    }
+
+    uint32_t shared = prio->ready & ~prio->strict;
+    if (shared == 0)
+    {
+        goto EXIT;
+    }
+
+    /* Turn used up, or its lane ran dry: pass it to the next non-empty lane. */
+    if (prio->credit == 0 || ((shared >> prio->turn) & 1) == 0)
+    {
+        prio->turn = STARB_Prio_NextFrom(shared, (prio->credit == 0) ? prio->turn + 1 : prio->turn);
+        prio->credit = prio->weights[prio->turn];
+    }
+
+    prio->credit--;
+    lane = prio->turn;
+
+EXIT:
+    return lane;
+}
+
+/** @brief Update the non-empty bit of a lane accessed directly. */
+void STARB_Prio_Refresh(STARB_Prio* prio, const uint32_t lane)
+{
+    assert(prio != NULL && lane < prio->count);
+
+    if (StaticRingBuf_GetReadCapacity(&prio->lanes[lane]) > 0)
+    {
+        prio->ready |= 1UL << lane;
+    }
+    else
+    {
+        prio->ready &= ~(1UL << lane);
+    }
+}
+
+/** @brief First set bit of `mask` at or after `start`, wrapping around (`mask` not 0). */
+static inline uint32_t STARB_Prio_NextFrom(const uint32_t mask, const uint32_t start)
+{
+    uint32_t upper = (start < STARB_PRIO_MAXLANES) ? (mask & (0xFFFFFFFFUL << start)) : 0;
+
+    return STARB_Ctz32((upper != 0) ? upper : mask);
+}
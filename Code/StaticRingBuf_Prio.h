@@ -0,0 +1,133 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Prio.h                                           *
+ *  @brief    Priority lanes: strict and weighted round robin.               *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Prio_H
+#define _INC_GH2025_StaticRingBuf_Prio_H
+
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief Maximum count of lanes (bits of the non-empty bitmap) */
+#define STARB_PRIO_MAXLANES     32
+
+/** \brief  Struct definition for the priority ring set.
+ * \details `count` lanes, each a StaticRingBuf with its own storage, set up by
+ *          the caller. Lane 0 has the highest priority.
+ *
+ *          Lanes with weight 0 are strict: any of them holding data is served
+ *          first, lowest lane number first. The other lanes share what is left
+ *          by weighted round robin: a lane is served up to `weight` reads in a
+ *          row, then the turn moves to the next non-empty lane. Without a
+ *          weight array every lane is strict.
+ *
+ *          `ready` has one bit per non-empty lane, so picking the next lane is
+ *          a mask and a count-trailing-zeros, whatever the backlog; a strict
+ *          lane waits at most one read of another lane.
+ *
+ *          Each read serves one lane. Write whole messages and read with the
+ *          message size to schedule per message. Not thread-safe: use from
+ *          one context, or serialize the calls.
+ */
+typedef struct _STARB_Prio_t
+{
+    StaticRingBuf* lanes;           // Lane rings (`count` entries)
+    const uint16_t* weights;        // Weight per lane (0: strict), or NULL
+    uint32_t count;                 // Count of lanes
+    uint32_t ready;                 // Non-empty lane bitmap
+    uint32_t strict;                // Strict lane bitmap
+    uint32_t turn;                  // Lane holding the round robin turn
+    uint32_t credit;                // Reads left in the current turn
+
+} STARB_Prio;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_Prio instance over initialized lane rings.
+     *
+     *  @param[out] prio   The STARB_Prio instance to be initialized
+     *  @param[in] lanes   Lane rings (`count` entries)
+     *  @param[in] count   Count of lanes (1 ~ STARB_PRIO_MAXLANES)
+     *  @param[in] weights Weight per lane (0: strict), or NULL for strict priority only
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Prio_Init(STARB_Prio* prio, StaticRingBuf* lanes, const uint32_t count, const uint16_t* weights);
+
+    /** @brief Write bytes to a lane.
+     *
+     *  @param[in] prio       The STARB_Prio instance
+     *  @param[in] lane       Lane number
+     *  @param[in] srcbuf     Data to write
+     *  @param[in] writecount Count of bytes to write
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow.
+     */
+    uint8_t STARB_Prio_Write(STARB_Prio* prio, const uint32_t lane, byte* srcbuf, const STARB_CAPTYPE writecount);
+
+    /** @brief Read up to `maxcount` bytes from the lane whose turn it is.
+     *
+     *  @param[in] prio       The STARB_Prio instance
+     *  @param[out] outbuf    Buffer to receive the data
+     *  @param[in] maxcount   Maximum count of bytes to read (at least 1)
+     *  @param[out] readcount Count of bytes read
+     *  @param[out] lane      Lane served
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (`maxcount` is 0).
+     *  @retval 0xE5 Failed: No (enough) data (all lanes empty).
+     */
+    uint8_t STARB_Prio_Read(STARB_Prio* prio, byte* outbuf, const STARB_CAPTYPE maxcount, STARB_CAPTYPE* readcount, uint32_t* lane);
+
+    /** @brief Pick the lane to serve next, and charge the read to it.
+     *  @details For zero-copy reads on the lane ring itself; call
+     *           STARB_Prio_Refresh() on the lane afterwards.
+     *
+     *  @param[in] prio The STARB_Prio instance
+     *  @return Lane number, or `prio->count` when all lanes are empty
+     */
+    uint32_t STARB_Prio_Select(STARB_Prio* prio);
+
+    /** @brief Update the non-empty bit of a lane accessed directly. */
+    void STARB_Prio_Refresh(STARB_Prio* prio, const uint32_t lane);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Prio_H
@@ -0,0 +1,684 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Spsc.h"
+#include "Common/memcopy.h"
+
+static inline uint32_t STARB_Spsc_Distance(const STARB_Spsc* ring, const uint32_t head, const uint32_t tail);
+static inline uint32_t STARB_Spsc_Advance(const STARB_Spsc* ring, const uint32_t index, const uint32_t count);
+static inline uint32_t STARB_Spsc_Offset(const STARB_Spsc* ring, const uint32_t index);
+static inline uint32_t STARB_Spsc_Free(STARB_Spsc* ring, const uint32_t needed);
+static inline uint32_t STARB_Spsc_Avail(STARB_Spsc* ring, const uint32_t needed);
+static inline void STARB_Spsc_Commit(STARB_Spsc* ring, const uint32_t count);
+static inline void STARB_Spsc_Publish(STARB_Spsc* ring);
+static inline void STARB_Spsc_Claim(STARB_Spsc* ring, const uint32_t count);
+static inline uint32_t STARB_Spsc_ClaimDistance(const STARB_Spsc* ring, const uint32_t head, const uint32_t tail);
+
+/** @brief   Initialize the STARB_Spsc instance.
+ *  @details Same storage rule as StaticRingBuf_Init(): the logical capacity is
+ *           exactly HALF of the provided (mirrored) buffer size.
+ *
+ *  @param[out] ring             The STARB_Spsc instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Spsc_Init(STARB_Spsc* ring, const STARB_STOSZTP total_buffer_size, byte* _buffer)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL || _buffer == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (total_buffer_size < 2 || total_buffer_size > STARB_MAXCAP)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(ring, 0, sizeof(STARB_Spsc));
+    ring->buffer = _buffer;
+    ring->capacity = total_buffer_size / 2;
+    ring->span = 2 * ring->capacity * (0x80000000u / (2 * ring->capacity));
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Producer] Set the publication batch size of the STARB_Spsc instance.
+ *  @details Writes are published to the consumer once `batch` bytes are pending,
+ *           when fewer than `batch` bytes of space are left, when a write fails
+ *           with 0xE4, or on STARB_Spsc_Flush().
+ *           Pending bytes are published before the new setting takes effect.
+ *
+ *  @param[in] ring  The STARB_Spsc instance
+ *  @param[in] batch Publish threshold (bytes), 0 or 1 to publish every write
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Spsc_SetBatch(STARB_Spsc* ring, const STARB_CAPTYPE batch)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (batch > ring->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    STARB_StoreRelease32(&ring->wpos, ring->wpos_local);
+    ring->batch = batch;
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Producer] Publish all pending writes to the consumer.
+ *
+ *  @param[in] ring The STARB_Spsc instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ */
+uint8_t STARB_Spsc_Flush(STARB_Spsc* ring)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    STARB_Spsc_Publish(ring);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Producer] Enable observer snapshots (STARB_Spsc_Snapshot()).
+ *  @details From then on every write advances `claim` before its copy: one
+ *           extra store and a release fence per write. Rings that never call
+ *           this skip both. Call it before the first write: older bytes may
+ *           be reported as missing (0xE5). Calling it again does nothing.
+ *
+ *  @param[in] ring The STARB_Spsc instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ */
+uint8_t STARB_Spsc_EnableSnapshot(STARB_Spsc* ring)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (ring->snapshot == 0)
+    {
+        /* `claim` must match `wpos_local` modulo 2 * capacity before observers see the flag. */
+        ring->claim = ring->wpos_local;
+        STARB_StoreRelease32(&ring->snapshot, 1);
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Producer] Get writing capacity of the STARB_Spsc instance.
+ *
+ *  @param[in] ring The STARB_Spsc instance
+ *  @return Writing capacity (bytes)
+ */
+STARB_CAPTYPE STARB_Spsc_GetWriteCapacity(STARB_Spsc* ring)
+{
+    assert(ring != NULL);
+    return (STARB_CAPTYPE)STARB_Spsc_Free(ring, ring->capacity);
+}
+
+/** @brief [Consumer] Get reading capacity of the STARB_Spsc instance.
+ *
+ *  @param[in] ring The STARB_Spsc instance
+ *  @return Reading capacity (bytes)
+ */
+STARB_CAPTYPE STARB_Spsc_GetReadCapacity(STARB_Spsc* ring)
+{
+    assert(ring != NULL);
+    return (STARB_CAPTYPE)STARB_Spsc_Avail(ring, ring->capacity);
+}
+
+/** @brief [Producer] Write 1 byte into the STARB_Spsc instance.
+ *
+ *  @param[in] ring     The STARB_Spsc instance
+ *  @param[in] _elem    Content to be written
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE4 Failed: Buffer overflow.
+ */
+uint8_t STARB_Spsc_Write(STARB_Spsc* ring, const byte _elem)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Free(ring, 1) < 1)
+    {
+        /* The consumer can only free space it has seen: publish pending bytes. */
+        STARB_Spsc_Publish(ring);
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    STARB_Spsc_Claim(ring, 1);
+    uint32_t offset = STARB_Spsc_Offset(ring, ring->wpos_local);
+    ring->buffer[offset] = _elem;
+    ring->buffer[offset + ring->capacity] = _elem;
+
+    STARB_Spsc_Commit(ring, 1);
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Producer] Write bytes into the STARB_Spsc instance.
+ *
+ *  @param[in] ring         The STARB_Spsc instance
+ *  @param[in] srcbuf       Pointer to source data buffer to be written
+ *  @param[in] writecount   Data length to be written
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow.
+ */
+uint8_t STARB_Spsc_WriteItems(STARB_Spsc* ring, const byte* srcbuf, const STARB_CAPTYPE writecount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (writecount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (ring == NULL || srcbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (writecount > ring->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Free(ring, writecount) < writecount)
+    {
+        /* The consumer can only free space it has seen: publish pending bytes. */
+        STARB_Spsc_Publish(ring);
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    STARB_Spsc_Claim(ring, writecount);
+    uint32_t offset = STARB_Spsc_Offset(ring, ring->wpos_local);
+    byte* dst = ring->buffer + offset;
+    STARB_MemCopy(dst, srcbuf, writecount);
+    if (offset + writecount <= ring->capacity)
+    {
+        STARB_MemCopy(dst + ring->capacity, srcbuf, writecount);
+    }
+    else
+    {
+        uint32_t countL = ring->capacity - offset;
+        STARB_MemCopy(dst + ring->capacity, srcbuf, countL);
+        STARB_MemCopy(ring->buffer, srcbuf + countL, (size_t)writecount - countL);
+    }
+
+    STARB_Spsc_Commit(ring, writecount);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Producer] Write 1 byte from interrupt / signal context.
+ *  @details Wait-free and async-signal-safe. The byte is published at once,
+ *           regardless of `batch`. Must not be mixed with the other producer
+ *           functions: the handler is the one and only producer.
+ *
+ *  @param[in] ring     The STARB_Spsc instance
+ *  @param[in] _elem    Content to be written
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE4 Failed: Buffer overflow.
+ */
+uint8_t STARB_Spsc_WriteIsr(STARB_Spsc* ring, const byte _elem)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Free(ring, 1) < 1)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    STARB_Spsc_Claim(ring, 1);
+    uint32_t offset = STARB_Spsc_Offset(ring, ring->wpos_local);
+    ring->buffer[offset] = _elem;
+    ring->buffer[offset + ring->capacity] = _elem;
+
+    ring->wpos_local = STARB_Spsc_Advance(ring, ring->wpos_local, 1);
+    STARB_StoreRelease32(&ring->wpos, ring->wpos_local);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Producer] Write bytes from interrupt / signal context.
+ *  @details Wait-free and async-signal-safe: the copy is an inline byte loop
+ *           bounded by `STARB_SPSC_ISR_MAXWRITE`, and the bytes are published at
+ *           once, regardless of `batch`. Must not be mixed with the other
+ *           producer functions: the handler is the one and only producer.
+ *
+ *  @param[in] ring         The STARB_Spsc instance
+ *  @param[in] srcbuf       Pointer to source data buffer to be written
+ *  @param[in] writecount   Data length to be written (up to `STARB_SPSC_ISR_MAXWRITE`)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow.
+ */
+uint8_t STARB_Spsc_WriteItemsIsr(STARB_Spsc* ring, const byte* srcbuf, const STARB_CAPTYPE writecount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (writecount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (ring == NULL || srcbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (writecount > STARB_SPSC_ISR_MAXWRITE || writecount > ring->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Free(ring, writecount) < writecount)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    STARB_Spsc_Claim(ring, writecount);
+    uint32_t offset = STARB_Spsc_Offset(ring, ring->wpos_local);
+    byte* dst = ring->buffer + offset;
+    STARB_MemCopy_Isr(dst, srcbuf, writecount);
+    if (offset + writecount <= ring->capacity)
+    {
+        STARB_MemCopy_Isr(dst + ring->capacity, srcbuf, writecount);
+    }
+    else
+    {
+        uint32_t countL = ring->capacity - offset;
+        STARB_MemCopy_Isr(dst + ring->capacity, srcbuf, countL);
+        STARB_MemCopy_Isr(ring->buffer, srcbuf + countL, (size_t)writecount - countL);
+    }
+
+    ring->wpos_local = STARB_Spsc_Advance(ring, ring->wpos_local, writecount);
+    STARB_StoreRelease32(&ring->wpos, ring->wpos_local);
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Consumer] Read 1 byte from the STARB_Spsc instance.
+ *
+ *  @param[in] ring     The STARB_Spsc instance
+ *  @param[out] _elem   Pointer to output the read content
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Spsc_Read(STARB_Spsc* ring, byte* _elem)
+{
+    uint8_t rc = STARB_OK;
+
+    if (ring == NULL || _elem == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Avail(ring, 1) < 1)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    uint32_t rpos = ring->rpos;
+    *_elem = ring->buffer[STARB_Spsc_Offset(ring, rpos)];
+
+    STARB_StoreRelease32(&ring->rpos, STARB_Spsc_Advance(ring, rpos, 1));
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Consumer] Read bytes from the STARB_Spsc instance.
+ *
+ *  @param[in] ring      The STARB_Spsc instance
+ *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+ *  @param[in] readcount The length to read (unit: bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Spsc_ReadItems(STARB_Spsc* ring, byte* outbuf, const STARB_CAPTYPE readcount)
+{
+    uint8_t rc = STARB_Spsc_PeekItems(ring, outbuf, readcount);
+
+    if (rc == STARB_OK && readcount > 0)
+    {
+        STARB_StoreRelease32(&ring->rpos, STARB_Spsc_Advance(ring, ring->rpos, readcount));
+    }
+
+    return rc;
+}
+
+/** @brief [Consumer] Read bytes from the STARB_Spsc instance without moving the read index.
+ *
+ *  @param[in] ring      The STARB_Spsc instance
+ *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+ *  @param[in] readcount The length to read (unit: bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Spsc_PeekItems(STARB_Spsc* ring, byte* outbuf, const STARB_CAPTYPE readcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (readcount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (ring == NULL || outbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (readcount > ring->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Avail(ring, readcount) < readcount)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_MemCopy(outbuf, ring->buffer + STARB_Spsc_Offset(ring, ring->rpos), readcount);
+
+EXIT:
+    return rc;
+}
+
+/** @brief [Consumer] Get reading pointer of the STARB_Spsc instance.
+ *  @note  Up to GetReadCapacity() bytes are contiguous from this pointer (mirror).
+ */
+byte* STARB_Spsc_GetReadPtr(STARB_Spsc* ring)
+{
+    return ring->buffer + STARB_Spsc_Offset(ring, ring->rpos);
+}
+
+/** @brief [Consumer] Move the read index forward (release bytes to the producer).
+ *
+ *  @param[in] ring      The STARB_Spsc instance
+ *  @param[in] skipcount The length to move forward (skip)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Spsc_Forward(STARB_Spsc* ring, const STARB_CAPTYPE skipcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (skipcount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (ring == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (skipcount > ring->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (STARB_Spsc_Avail(ring, skipcount) < skipcount)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_StoreRelease32(&ring->rpos, STARB_Spsc_Advance(ring, ring->rpos, skipcount));
+
+EXIT:
+    return rc;
+}
+
+/** @brief   [Observer] Copy the last `count` published bytes, consumed or not.
+ *  @details Lock-free and read-only: no index moves, nothing is written to the
+ *           ring, so any number of observer threads may run next to the
+ *           producer and the consumer. A copy the producer may have overwritten
+ *           meanwhile is detected and retried, up to `STARB_SPSC_SNAPSHOT_RETRY`
+ *           attempts.
+ *
+ *  @param[in] ring    The STARB_Spsc instance
+ *  @param[out] outbuf Pointer to the output buffer to hold the snapshot
+ *  @param[in] count   The length to copy (unit: bytes)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (or snapshots not enabled).
+ *  @retval 0xE5 Failed: No (enough) data (fewer than `count` bytes written so far).
+ *  @retval 0xE6 Failed: Invalid data (torn: overwritten during every attempt).
+ */
+uint8_t STARB_Spsc_Snapshot(STARB_Spsc* ring, byte* outbuf, const STARB_CAPTYPE count)
+{
+    uint8_t rc = STARB_OK;
+
+    if (count <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (ring == NULL || outbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (count > ring->capacity || STARB_LoadAcquire32(&ring->snapshot) == 0)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rc = STARB_DATAINVALID;
+    for (int attempt = 0; attempt < STARB_SPSC_SNAPSHOT_RETRY; attempt++)
+    {
+        /* Same `claim` on both sides of the `wpos` load: no write started in between,
+         * so the claimed but unpublished bytes are at most `capacity`. */
+        uint32_t claim = STARB_LoadAcquire32(&ring->claim);
+        uint32_t wpos = STARB_LoadAcquire32(&ring->wpos);
+        if (STARB_LoadAcquire32(&ring->claim) != claim)
+        {
+            continue;
+        }
+
+        uint32_t end = claim - STARB_Spsc_Distance(ring, claim % (2 * ring->capacity), wpos);
+        if (end < count)
+        {
+            rc = STARB_NOENOUGHDAT;
+            break;
+        }
+
+        uint32_t start = end - count;
+        STARB_MemCopy(outbuf, ring->buffer + STARB_Spsc_Offset(ring, start % (2 * ring->capacity)), count);
+
+        /* The byte at `start` is overwritten by the write that claims `start + capacity + 1`. */
+        STARB_FenceAcquire();
+        if (STARB_Spsc_ClaimDistance(ring, ring->claim, start) <= ring->capacity)
+        {
+            rc = STARB_OK;
+            break;
+        }
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Count of bytes from `tail` up to `head` (indexes in [0, 2 * capacity)). */
+static inline uint32_t STARB_Spsc_Distance(const STARB_Spsc* ring, const uint32_t head, const uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + 2 * ring->capacity - tail);
+}
+
+/** @brief Move an index forward by `count` bytes, wrapping at 2 * capacity. */
+static inline uint32_t STARB_Spsc_Advance(const STARB_Spsc* ring, const uint32_t index, const uint32_t count)
+{
+    uint32_t next = index + count;
+    return (next >= 2 * ring->capacity) ? (next - 2 * ring->capacity) : next;
+}
+
+/** @brief Physical offset of an index in the main region. */
+static inline uint32_t STARB_Spsc_Offset(const STARB_Spsc* ring, const uint32_t index)
+{
+    return (index >= ring->capacity) ? (index - ring->capacity) : index;
+}
+
+/** @brief [Producer] Free space; `rpos` is re-read only if the cached copy is short of `needed`. */
+static inline uint32_t STARB_Spsc_Free(STARB_Spsc* ring, const uint32_t needed)
+{
+    uint32_t free = ring->capacity - STARB_Spsc_Distance(ring, ring->wpos_local, ring->rpos_cache);
+    if (free < needed)
+    {
+        ring->rpos_cache = STARB_LoadAcquire32(&ring->rpos);
+        free = ring->capacity - STARB_Spsc_Distance(ring, ring->wpos_local, ring->rpos_cache);
+    }
+    return free;
+}
+
+/** @brief [Consumer] Readable bytes; `wpos` is re-read only if the cached copy is short of `needed`. */
+static inline uint32_t STARB_Spsc_Avail(STARB_Spsc* ring, const uint32_t needed)
+{
+    uint32_t avail = STARB_Spsc_Distance(ring, ring->wpos_cache, ring->rpos);
+    if (avail < needed)
+    {
+        ring->wpos_cache = STARB_LoadAcquire32(&ring->wpos);
+        avail = STARB_Spsc_Distance(ring, ring->wpos_cache, ring->rpos);
+    }
+    return avail;
+}
+
+/** @brief   [Producer] Account `count` written bytes and publish them when due.
+ *  @details Publication happens when the pending bytes reach `batch`, or when the
+ *           space left (as seen through `rpos_cache`) drops below `batch`.
+ *           A later write larger than the space left can still fail while bytes
+ *           are pending; the 0xE4 paths publish them so that the consumer can
+ *           drain the ring and a retry eventually succeeds.
+ */
+static inline void STARB_Spsc_Commit(STARB_Spsc* ring, const uint32_t count)
+{
+    uint32_t wpos_local = STARB_Spsc_Advance(ring, ring->wpos_local, count);
+    ring->wpos_local = wpos_local;
+
+    if (ring->batch <= 1 ||
+        STARB_Spsc_Distance(ring, wpos_local, ring->wpos) >= ring->batch ||
+        ring->capacity - STARB_Spsc_Distance(ring, wpos_local, ring->rpos_cache) < ring->batch)
+    {
+        STARB_StoreRelease32(&ring->wpos, wpos_local);
+    }
+}
+
+/** @brief [Producer] Publish the pending bytes, if any (release store of `wpos`). */
+static inline void STARB_Spsc_Publish(STARB_Spsc* ring)
+{
+    if (ring->wpos != ring->wpos_local)
+    {
+        STARB_StoreRelease32(&ring->wpos, ring->wpos_local);
+    }
+}
+
+/** @brief   [Producer] Announce a write of `count` bytes to observers, before the copy.
+ *  @details Only with snapshots enabled. The release fence keeps the `claim`
+ *           store ahead of the data stores (a compiler barrier on x86 / x64).
+ */
+static inline void STARB_Spsc_Claim(STARB_Spsc* ring, const uint32_t count)
+{
+    if (ring->snapshot != 0)
+    {
+        uint32_t claim = ring->claim + count;
+        ring->claim = (claim >= ring->span + 2 * ring->capacity) ? claim - ring->span : claim;
+        STARB_FenceRelease();
+    }
+}
+
+/** @brief Count of bytes from `tail` up to `head` (`claim` values, modulo `span`). */
+static inline uint32_t STARB_Spsc_ClaimDistance(const STARB_Spsc* ring, const uint32_t head, const uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + ring->span - tail);
+}
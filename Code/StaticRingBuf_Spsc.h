@@ -0,0 +1,310 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Spsc.h                                           *
+ *  @brief    Single-producer / single-consumer Static Ring Buffer.          *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *  2026/10/19 | 0.1.1.0   | agent      | Add async-signal-safe producer     *
+ *  2026/10/19 | 0.1.2.0   | agent      | Add observer snapshot reads        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+#ifndef _INC_GH2025_StaticRingBuf_Spsc_H
+#define _INC_GH2025_StaticRingBuf_Spsc_H
+
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief Tech Decision Macros */
+
+/** @brief Maximum write length (bytes) of the interrupt / signal-context producer functions */
+#ifndef STARB_SPSC_ISR_MAXWRITE
+#define STARB_SPSC_ISR_MAXWRITE 64
+#endif
+
+/** @brief Attempts of STARB_Spsc_Snapshot() before it reports a torn read */
+#ifndef STARB_SPSC_SNAPSHOT_RETRY
+#define STARB_SPSC_SNAPSHOT_RETRY 4
+#endif
+
+/** \brief  Struct definition for the SPSC Static Ring Buffer.
+ * \details Lock-free variant of the StaticRingBuf for one producer and one consumer
+ *          running concurrently. It keeps the mirrored storage model, but the state
+ *          written by each side lives on its own cache line:
+ *
+ *          - shared line:   `buffer`, `capacity`, `span` (read-only after init)
+ *          - producer line: `wpos`, `claim`, `snapshot` (published) and `rpos_cache`
+ *          - consumer line: `rpos` (published) and `wpos_cache`
+ *
+ *          Each side reads the other side's index only when its cached copy says
+ *          the ring looks full (producer) or empty (consumer).
+ *          Indexes run in [0, 2 * capacity) so that full and empty are distinct
+ *          without a shared `cycle` flag.
+ *
+ *          Batching: with a non-zero `batch`, the producer writes at its private
+ *          `wpos_local` and publishes `wpos` only every `batch` bytes, when the
+ *          ring is nearly full, when a write fails for lack of space (0xE4),
+ *          or on STARB_Spsc_Flush().
+ *
+ *          Interrupt / signal-context producer: STARB_Spsc_WriteIsr() and
+ *          STARB_Spsc_WriteItemsIsr() are wait-free and async-signal-safe (no locks,
+ *          no library calls, bounded copy, one acquire load and one release store).
+ *          The consumer functions only touch consumer-side state and bytes already
+ *          published, so they tolerate being interrupted by such a producer at any
+ *          point, including on the consumer's own thread.
+ *
+ *          Observer snapshots (opt-in, STARB_Spsc_EnableSnapshot()): before each
+ *          copy the producer advances `claim`, a byte counter running in
+ *          [0, span + 2 * capacity) and wrapping by `span` (a multiple of
+ *          2 * capacity), then issues a release fence. A third
+ *          thread copies the tail with STARB_Spsc_Snapshot() and checks `claim`
+ *          again afterwards, seqlock style: if the producer has claimed as far as
+ *          the copied bytes plus `capacity`, they may have been overwritten and
+ *          the copy is retried. The producer never waits for observers. Rings
+ *          without snapshots skip the claim: no extra store or fence per write.
+ *
+ *          Declare instances with `STARB_ALIGNAS(STARB_CACHELINE)`.
+ */
+typedef struct _STARB_Spsc_t
+{
+    byte* buffer;                   // Pointer to the physical storage buffer.
+    uint32_t capacity;              // Logical storage capacity in bytes.
+    uint32_t span;                  // Wrap distance of `claim` (multiple of 2 * capacity)
+    byte pad0[STARB_CACHELINE - sizeof(byte*) - 2 * sizeof(uint32_t)];
+
+    volatile uint32_t wpos;         // [Producer] Write index, published to the consumer
+    uint32_t rpos_cache;            // [Producer] Cached copy of `rpos`
+    uint32_t wpos_local;            // [Producer] Write index including unpublished bytes
+    uint32_t batch;                 // [Producer] Publish threshold (bytes), 0: every write
+    volatile uint32_t claim;        // [Producer] Byte counter up to the write in progress, published to observers
+    volatile uint32_t snapshot;     // [Producer] Non-zero: writes advance `claim` (STARB_Spsc_EnableSnapshot())
+    byte pad1[STARB_CACHELINE - 6 * sizeof(uint32_t)];
+
+    volatile uint32_t rpos;         // [Consumer] Read index, published to the producer
+    uint32_t wpos_cache;            // [Consumer] Cached copy of `wpos`
+    byte pad2[STARB_CACHELINE - 2 * sizeof(uint32_t)];
+
+} STARB_Spsc;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief   Initialize the STARB_Spsc instance.
+     *  @details Same storage rule as StaticRingBuf_Init(): the logical capacity is
+     *           exactly HALF of the provided (mirrored) buffer size.
+     *
+     *  @param[out] ring             The STARB_Spsc instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Spsc_Init(STARB_Spsc* ring, const STARB_STOSZTP total_buffer_size, byte* _buffer);
+
+    /** @brief   [Producer] Set the publication batch size of the STARB_Spsc instance.
+     *  @details Writes are published to the consumer once `batch` bytes are pending,
+     *           when fewer than `batch` bytes of space are left, when a write fails
+     *           with 0xE4, or on STARB_Spsc_Flush().
+     *           Pending bytes are published before the new setting takes effect.
+     *
+     *  @param[in] ring  The STARB_Spsc instance
+     *  @param[in] batch Publish threshold (bytes), 0 or 1 to publish every write
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Spsc_SetBatch(STARB_Spsc* ring, const STARB_CAPTYPE batch);
+
+    /** @brief [Producer] Publish all pending writes to the consumer.
+     *
+     *  @param[in] ring The STARB_Spsc instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     */
+    uint8_t STARB_Spsc_Flush(STARB_Spsc* ring);
+
+    /** @brief   [Producer] Enable observer snapshots (STARB_Spsc_Snapshot()).
+     *  @details From then on every write advances `claim` before its copy: one
+     *           extra store and a release fence per write. Rings that never call
+     *           this skip both. Call it before the first write: older bytes may
+     *           be reported as missing (0xE5). Calling it again does nothing.
+     *
+     *  @param[in] ring The STARB_Spsc instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     */
+    uint8_t STARB_Spsc_EnableSnapshot(STARB_Spsc* ring);
+
+    /** @brief [Producer] Get writing capacity of the STARB_Spsc instance.
+     *
+     *  @param[in] ring The STARB_Spsc instance
+     *  @return Writing capacity (bytes)
+     */
+    STARB_CAPTYPE STARB_Spsc_GetWriteCapacity(STARB_Spsc* ring);
+
+    /** @brief [Consumer] Get reading capacity of the STARB_Spsc instance.
+     *
+     *  @param[in] ring The STARB_Spsc instance
+     *  @return Reading capacity (bytes)
+     */
+    STARB_CAPTYPE STARB_Spsc_GetReadCapacity(STARB_Spsc* ring);
+
+    /** @brief [Producer] Write 1 byte into the STARB_Spsc instance.
+     *
+     *  @param[in] ring     The STARB_Spsc instance
+     *  @param[in] _elem    Content to be written
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE4 Failed: Buffer overflow.
+     */
+    uint8_t STARB_Spsc_Write(STARB_Spsc* ring, const byte _elem);
+
+    /** @brief [Producer] Write bytes into the STARB_Spsc instance.
+     *
+     *  @param[in] ring         The STARB_Spsc instance
+     *  @param[in] srcbuf       Pointer to source data buffer to be written
+     *  @param[in] writecount   Data length to be written
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow.
+     */
+    uint8_t STARB_Spsc_WriteItems(STARB_Spsc* ring, const byte* srcbuf, const STARB_CAPTYPE writecount);
+
+    /** @brief   [Producer] Write 1 byte from interrupt / signal context.
+     *  @details Wait-free and async-signal-safe. The byte is published at once,
+     *           regardless of `batch`. Must not be mixed with the other producer
+     *           functions: the handler is the one and only producer.
+     *
+     *  @param[in] ring     The STARB_Spsc instance
+     *  @param[in] _elem    Content to be written
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE4 Failed: Buffer overflow.
+     */
+    uint8_t STARB_Spsc_WriteIsr(STARB_Spsc* ring, const byte _elem);
+
+    /** @brief   [Producer] Write bytes from interrupt / signal context.
+     *  @details Wait-free and async-signal-safe: the copy is an inline byte loop
+     *           bounded by `STARB_SPSC_ISR_MAXWRITE`, and the bytes are published at
+     *           once, regardless of `batch`. Must not be mixed with the other
+     *           producer functions: the handler is the one and only producer.
+     *
+     *  @param[in] ring         The STARB_Spsc instance
+     *  @param[in] srcbuf       Pointer to source data buffer to be written
+     *  @param[in] writecount   Data length to be written (up to `STARB_SPSC_ISR_MAXWRITE`)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow.
+     */
+    uint8_t STARB_Spsc_WriteItemsIsr(STARB_Spsc* ring, const byte* srcbuf, const STARB_CAPTYPE writecount);
+
+    /** @brief [Consumer] Read 1 byte from the STARB_Spsc instance.
+     *
+     *  @param[in] ring     The STARB_Spsc instance
+     *  @param[out] _elem   Pointer to output the read content
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Spsc_Read(STARB_Spsc* ring, byte* _elem);
+
+    /** @brief [Consumer] Read bytes from the STARB_Spsc instance.
+     *
+     *  @param[in] ring      The STARB_Spsc instance
+     *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+     *  @param[in] readcount The length to read (unit: bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Spsc_ReadItems(STARB_Spsc* ring, byte* outbuf, const STARB_CAPTYPE readcount);
+
+    /** @brief [Consumer] Read bytes from the STARB_Spsc instance without moving the read index.
+     *
+     *  @param[in] ring      The STARB_Spsc instance
+     *  @param[out] outbuf   Pointer to the output buffer to hold the read result
+     *  @param[in] readcount The length to read (unit: bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Spsc_PeekItems(STARB_Spsc* ring, byte* outbuf, const STARB_CAPTYPE readcount);
+
+    /** @brief [Consumer] Get reading pointer of the STARB_Spsc instance.
+     *  @note  Up to GetReadCapacity() bytes are contiguous from this pointer (mirror).
+     */
+    byte* STARB_Spsc_GetReadPtr(STARB_Spsc* ring);
+
+    /** @brief [Consumer] Move the read index forward (release bytes to the producer).
+     *
+     *  @param[in] ring      The STARB_Spsc instance
+     *  @param[in] skipcount The length to move forward (skip)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Spsc_Forward(STARB_Spsc* ring, const STARB_CAPTYPE skipcount);
+
+    /** @brief   [Observer] Copy the last `count` published bytes, consumed or not.
+     *  @details Lock-free and read-only: no index moves, nothing is written to the
+     *           ring, so any number of observer threads may run next to the
+     *           producer and the consumer. A copy the producer may have overwritten
+     *           meanwhile is detected and retried, up to `STARB_SPSC_SNAPSHOT_RETRY`
+     *           attempts.
+     *
+     *  @param[in] ring    The STARB_Spsc instance
+     *  @param[out] outbuf Pointer to the output buffer to hold the snapshot
+     *  @param[in] count   The length to copy (unit: bytes)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (or snapshots not enabled).
+     *  @retval 0xE5 Failed: No (enough) data (fewer than `count` bytes written so far).
+     *  @retval 0xE6 Failed: Invalid data (torn: overwritten during every attempt).
+     */
+    uint8_t STARB_Spsc_Snapshot(STARB_Spsc* ring, byte* outbuf, const STARB_CAPTYPE count);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Spsc_H
@@ -0,0 +1,303 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Stage.h"
+
+static inline uint32_t STARB_Stage_Distance(const STARB_Stage* stage, const uint32_t head, const uint32_t tail);
+static inline uint32_t STARB_Stage_Advance(const STARB_Stage* stage, const uint32_t index);
+static inline uint32_t STARB_Stage_Index(const STARB_Stage* stage, const uint32_t index);
+static uint32_t STARB_Stage_Retire_Core(STARB_Stage* stage);
+
+/** @brief Initialize the STARB_Stage instance.
+ *
+ *  @param[out] stage   The STARB_Stage instance to be initialized
+ *  @param[in] src      Source ring (mirrored storage)
+ *  @param[in] dst      Output ring
+ *  @param[in] slots    Reorder window slots
+ *  @param[in] window   Count of reorder window slots (1 ~ 0xFFFF)
+ *  @param[in] outslab  Result buffers, `window` * `outmax` bytes
+ *  @param[in] outmax   Size of each result buffer (1 ~ `dst` capacity)
+ *  @param[in] framelen Frame boundary callback
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Stage_Init(STARB_Stage* stage, StaticRingBuf* src, StaticRingBuf* dst,
+    STARB_StageSlot* slots, const uint32_t window, byte* outslab, const STARB_CAPTYPE outmax,
+    STARB_FrameLenFunc framelen)
+{
+    uint8_t rc = STARB_OK;
+
+    if (stage == NULL || src == NULL || dst == NULL || slots == NULL || outslab == NULL || framelen == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (window < 1 || window > UINT16_MAX || outmax < 1 || outmax > dst->capacity ||
+        (src->mode & STARB_MODE_NOMIRROR))
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(stage, 0, sizeof(STARB_Stage));
+    memset(slots, 0, window * sizeof(STARB_StageSlot));
+    stage->src = src;
+    stage->dst = dst;
+    stage->slots = slots;
+    stage->outslab = outslab;
+    stage->framelen = framelen;
+    stage->window = window;
+    stage->outmax = outmax;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Take the next frame for processing.
+ *
+ *  @param[in] stage The STARB_Stage instance
+ *  @param[out] job  The job to process
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE4 Failed: Buffer overflow (reorder window full: backpressure).
+ *  @retval 0xE5 Failed: No (enough) data (no complete frame).
+ *  @retval 0xE6 Failed: Invalid data (frame longer than the readable data).
+ */
+uint8_t STARB_Stage_Take(STARB_Stage* stage, STARB_Job* job)
+{
+    uint8_t rc = STARB_OK;
+
+    if (stage == NULL || job == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    STARB_SpinLock_Acquire(&stage->lock);
+
+    STARB_Stage_Retire_Core(stage);
+
+    if (STARB_Stage_Distance(stage, stage->next, stage->head) >= stage->window)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto UNLOCK;
+    }
+
+    StaticRingBuf* src = stage->src;
+    STARB_CAPTYPE avail = StaticRingBuf_GetReadCapacity(src) - stage->taken;
+    if (avail <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto UNLOCK;
+    }
+
+    /* Mirrored storage: the readable data is contiguous from any position. */
+    STARB_STOSZTP pos = (STARB_STOSZTP)src->rpos + stage->taken;
+    if (pos >= src->capacity)
+    {
+        pos -= src->capacity;
+    }
+
+    const byte* data = src->buffer + pos;
+    STARB_CAPTYPE inlen = stage->framelen(data, avail);
+    if (inlen <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto UNLOCK;
+    }
+    if (inlen > avail)
+    {
+        rc = STARB_DATAINVALID;
+        goto UNLOCK;
+    }
+
+    uint32_t index = STARB_Stage_Index(stage, stage->next);
+    STARB_StageSlot* slot = &stage->slots[index];
+    slot->inlen = inlen;
+    slot->outlen = 0;
+    slot->state = STARB_SLOT_TAKEN;
+
+    job->seq = stage->next;
+    job->in = data;
+    job->inlen = inlen;
+    job->out = stage->outslab + (size_t)index * stage->outmax;
+    job->outmax = stage->outmax;
+
+    stage->taken += inlen;
+    stage->next = STARB_Stage_Advance(stage, stage->next);
+
+UNLOCK:
+    STARB_SpinLock_Release(&stage->lock);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Hand the result of a job back; results are retired in frame order.
+ *
+ *  @param[in] stage  The STARB_Stage instance
+ *  @param[in] job    The job received from STARB_Stage_Take()
+ *  @param[in] outlen Length of the result written at `job->out`
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Stage_Complete(STARB_Stage* stage, const STARB_Job* job, const STARB_CAPTYPE outlen)
+{
+    uint8_t rc = STARB_OK;
+
+    if (stage == NULL || job == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (job->seq >= 2 * stage->window || outlen > stage->outmax)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    STARB_SpinLock_Acquire(&stage->lock);
+
+    STARB_StageSlot* slot = &stage->slots[STARB_Stage_Index(stage, job->seq)];
+    if (STARB_Stage_Distance(stage, job->seq, stage->head) >=
+        STARB_Stage_Distance(stage, stage->next, stage->head) ||
+        slot->state != STARB_SLOT_TAKEN)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto UNLOCK;
+    }
+
+    slot->outlen = outlen;
+    slot->state = STARB_SLOT_DONE;
+
+    STARB_Stage_Retire_Core(stage);
+
+UNLOCK:
+    STARB_SpinLock_Release(&stage->lock);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Take one frame, process it with `work`, and complete it.
+ *
+ *  @param[in] stage   The STARB_Stage instance
+ *  @param[in] work    Frame processing callback
+ *  @param[in] context User context passed to `work`
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE4 Failed: Buffer overflow (reorder window full: backpressure).
+ *  @retval 0xE5 Failed: No (enough) data (no complete frame).
+ *  @retval 0xE6 Failed: Invalid data (frame longer than the readable data).
+ */
+uint8_t STARB_Stage_Run(STARB_Stage* stage, STARB_WorkFunc work, void* context)
+{
+    uint8_t rc = STARB_OK;
+    STARB_Job job;
+
+    if (stage == NULL || work == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    rc = STARB_Stage_Take(stage, &job);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    STARB_CAPTYPE outlen = work(context, job.in, job.inlen, job.out, job.outmax);
+    if (outlen > job.outmax)
+    {
+        outlen = job.outmax;
+    }
+
+    rc = STARB_Stage_Complete(stage, &job, outlen);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Retire finished results to the output ring, in order, as far as it has room.
+ *
+ *  @param[in] stage The STARB_Stage instance
+ *  @return Count of results retired
+ */
+uint32_t STARB_Stage_Retire(STARB_Stage* stage)
+{
+    assert(stage != NULL);
+
+    STARB_SpinLock_Acquire(&stage->lock);
+    uint32_t retired = STARB_Stage_Retire_Core(stage);
+    STARB_SpinLock_Release(&stage->lock);
+
+    return retired;
+}
+
+/** @brief Count of slots from `tail` up to `head` (sequence indexes in [0, 2 * window)). */
+static inline uint32_t STARB_Stage_Distance(const STARB_Stage* stage, const uint32_t head, const uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + 2 * stage->window - tail);
+}
+
+/** @brief Next sequence index, wrapping at 2 * window. */
+static inline uint32_t STARB_Stage_Advance(const STARB_Stage* stage, const uint32_t index)
+{
+    uint32_t next = index + 1;
+    return (next >= 2 * stage->window) ? 0 : next;
+}
+
+/** @brief Reorder window slot of a sequence index. */
+static inline uint32_t STARB_Stage_Index(const STARB_Stage* stage, const uint32_t index)
+{
+    return (index >= stage->window) ? (index - stage->window) : index;
+}
+
+/** @brief   Retire the finished slots at the head of the window (caller holds the lock).
+ *  @details Stops at the first slot still in progress, or whose result does not
+ *           fit in `dst` yet. The frame is released from `src` once its result
+ *           is out, so `src` is consumed strictly in order.
+ *           A failed write or forward (`dst` / `src` touched without the lock)
+ *           also stops there; a result already written is not written again.
+ */
+static uint32_t STARB_Stage_Retire_Core(STARB_Stage* stage)
+{
+    uint32_t retired = 0;
+
+    while (stage->head != stage->next)
+    {
+        STARB_StageSlot* slot = &stage->slots[STARB_Stage_Index(stage, stage->head)];
+        if (slot->state != STARB_SLOT_DONE ||
+            slot->outlen > StaticRingBuf_GetWriteCapacity(stage->dst))
+        {
+            break;
+        }
+
+        byte* out = stage->outslab + (size_t)STARB_Stage_Index(stage, stage->head) * stage->outmax;
+        if (StaticRingBuf_WriteItems(stage->dst, out, slot->outlen) != STARB_OK)
+        {
+            break;
+        }
+        slot->outlen = 0;
+
+        if (StaticRingBuf_Forward(stage->src, slot->inlen) != STARB_OK)
+        {
+            break;
+        }
+        stage->taken -= slot->inlen;
+
+        slot->state = STARB_SLOT_FREE;
+        stage->head = STARB_Stage_Advance(stage, stage->head);
+        retired++;
+    }
+
+    return retired;
+}
@@ -0,0 +1,177 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Stage.h                                          *
+ *  @brief    Ordered parallel processing stage between two rings.           *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Stage_H
+#define _INC_GH2025_StaticRingBuf_Stage_H
+
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief   Callback function definition to find the next frame in the source ring.
+ *  @details Returns the length of the frame starting at `data` (1 ~ `avail`), or 0
+ *           if `avail` bytes do not hold a complete frame yet.
+ */
+typedef STARB_CAPTYPE (*STARB_FrameLenFunc)(const byte* data, const STARB_CAPTYPE avail);
+
+/** @brief   Callback function definition to process one frame.
+ *  @details Reads `inlen` bytes at `in`, writes up to `outmax` bytes at `out`, and
+ *           returns the output length.
+ */
+typedef STARB_CAPTYPE (*STARB_WorkFunc)(void* context, const byte* in, const STARB_CAPTYPE inlen, byte* out, const STARB_CAPTYPE outmax);
+
+/** @brief Reorder window slot */
+typedef struct _STARB_StageSlot_t {
+    STARB_CAPTYPE inlen;            // Length of the source frame
+    STARB_CAPTYPE outlen;           // Length of the result
+    uint8_t state;                  // STARB_SLOT_xxx
+} STARB_StageSlot;
+
+/** @brief Reorder window slot states */
+#define STARB_SLOT_FREE     0x00
+#define STARB_SLOT_TAKEN    0x01    // Frame handed to a worker
+#define STARB_SLOT_DONE     0x02    // Result ready, waiting for its turn
+
+/** @brief Unit of work handed to a worker */
+typedef struct _STARB_Job_t {
+    uint32_t seq;                   // Sequence index (in [0, 2 * window))
+    const byte* in;                 // Source frame, read in place
+    STARB_CAPTYPE inlen;            // Length of the source frame
+    byte* out;                      // Result buffer of the slot
+    STARB_CAPTYPE outmax;           // Size of the result buffer
+} STARB_Job;
+
+/** \brief  Struct definition for the ordered parallel stage.
+ * \details Splits the frames of the `src` ring across worker threads and writes
+ *          the results to the `dst` ring in the original frame order.
+ *
+ *          Workers call STARB_Stage_Run() (or STARB_Stage_Take(), process the
+ *          job, STARB_Stage_Complete()). Frames are read in place from the
+ *          mirrored `src` storage; each result goes to the slot's own area of
+ *          `outslab` until all earlier frames are retired. Retiring copies the
+ *          result to `dst` and releases the frame from `src`, strictly in order.
+ *
+ *          Backpressure: a frame is only taken while the reorder window has a free
+ *          slot, and a result is only retired while `dst` has room for it, so a
+ *          full `dst` stalls retiring and then fills the window.
+ *
+ *          The stage functions serialize on `lock`; workers process jobs outside
+ *          of it. The `src` producer and the `dst` consumer must hold `lock` too
+ *          (STARB_SpinLock_Acquire()) when they run on other threads.
+ */
+typedef struct _STARB_Stage_t
+{
+    StaticRingBuf* src;             // Source ring (framed records, mirrored storage)
+    StaticRingBuf* dst;             // Output ring
+    STARB_StageSlot* slots;         // Reorder window (`window` entries)
+    byte* outslab;                  // Result buffers (`window` * `outmax` bytes)
+    STARB_FrameLenFunc framelen;    // Frame boundary callback
+    uint32_t window;                // Count of reorder window slots
+    STARB_CAPTYPE outmax;           // Size of each result buffer
+    STARB_CAPTYPE taken;            // Source bytes handed out beyond `src->rpos`
+    uint32_t head;                  // Sequence index of the oldest slot not retired
+    uint32_t next;                  // Sequence index of the next frame
+    STARB_SpinLock lock;            // Serializes the stage state
+
+} STARB_Stage;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_Stage instance.
+     *
+     *  @param[out] stage   The STARB_Stage instance to be initialized
+     *  @param[in] src      Source ring (mirrored storage)
+     *  @param[in] dst      Output ring
+     *  @param[in] slots    Reorder window slots
+     *  @param[in] window   Count of reorder window slots (1 ~ 0xFFFF)
+     *  @param[in] outslab  Result buffers, `window` * `outmax` bytes
+     *  @param[in] outmax   Size of each result buffer (1 ~ `dst` capacity)
+     *  @param[in] framelen Frame boundary callback
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Stage_Init(STARB_Stage* stage, StaticRingBuf* src, StaticRingBuf* dst,
+        STARB_StageSlot* slots, const uint32_t window, byte* outslab, const STARB_CAPTYPE outmax,
+        STARB_FrameLenFunc framelen);
+
+    /** @brief Take the next frame for processing.
+     *
+     *  @param[in] stage The STARB_Stage instance
+     *  @param[out] job  The job to process
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE4 Failed: Buffer overflow (reorder window full: backpressure).
+     *  @retval 0xE5 Failed: No (enough) data (no complete frame).
+     *  @retval 0xE6 Failed: Invalid data (frame longer than the readable data).
+     */
+    uint8_t STARB_Stage_Take(STARB_Stage* stage, STARB_Job* job);
+
+    /** @brief Hand the result of a job back; results are retired in frame order.
+     *
+     *  @param[in] stage  The STARB_Stage instance
+     *  @param[in] job    The job received from STARB_Stage_Take()
+     *  @param[in] outlen Length of the result written at `job->out`
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Stage_Complete(STARB_Stage* stage, const STARB_Job* job, const STARB_CAPTYPE outlen);
+
+    /** @brief Take one frame, process it with `work`, and complete it.
+     *
+     *  @param[in] stage   The STARB_Stage instance
+     *  @param[in] work    Frame processing callback
+     *  @param[in] context User context passed to `work`
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE4 Failed: Buffer overflow (reorder window full: backpressure).
+     *  @retval 0xE5 Failed: No (enough) data (no complete frame).
+     *  @retval 0xE6 Failed: Invalid data (frame longer than the readable data).
+     */
+    uint8_t STARB_Stage_Run(STARB_Stage* stage, STARB_WorkFunc work, void* context);
+
+    /** @brief Retire finished results to the output ring, in order, as far as it has room.
+     *
+     *  @param[in] stage The STARB_Stage instance
+     *  @return Count of results retired
+     */
+    uint32_t STARB_Stage_Retire(STARB_Stage* stage);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Stage_H
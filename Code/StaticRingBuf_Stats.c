@@ -0,0 +1,277 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Stats.h"
+
+static void STARB_Stats_Notify(StaticRingBuf* rbuf, STARB_Observer* observer, const uint8_t event, const byte* data, const STARB_CAPTYPE count);
+static inline int64_t STARB_Stats_Decode(const STARB_Stats* stats, const byte* sample);
+static void STARB_Stats_Enter(STARB_Stats* stats, const int64_t value);
+static void STARB_Stats_Leave(STARB_Stats* stats, const int64_t value);
+static inline void STARB_Stats_Apply(STARB_Stats* stats, const bool enter, const byte* sample);
+
+/** @brief   Initialize the STARB_Stats instance and attach it to a ring.
+ *  @details Samples already in the ring are counted (sample aligned at the
+ *           read position).
+ *
+ *  @param[out] stats The STARB_Stats instance to be initialized
+ *  @param[in] rbuf   The StaticRingBuf instance to observe
+ *  @param[in] type   STARB_STATS_xxx
+ *  @param[in] minq   Deque entries for min
+ *  @param[in] maxq   Deque entries for max
+ *  @param[in] qcount Count of entries of each deque (>= capacity / size + 1)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Stats_Init(STARB_Stats* stats, StaticRingBuf* rbuf, const uint8_t type,
+    STARB_StatsEntry* minq, STARB_StatsEntry* maxq, const uint32_t qcount)
+{
+    uint8_t rc = STARB_OK;
+    STARB_Span spans[2];
+
+    if (stats == NULL || rbuf == NULL || minq == NULL || maxq == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    uint8_t size = type & 0x7F;
+    if ((size != 1 && size != 2 && size != 4) || qcount < (uint32_t)rbuf->capacity / size + 1)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(stats, 0, sizeof(STARB_Stats));
+    stats->observer.notify = STARB_Stats_Notify;
+    stats->rbuf = rbuf;
+    stats->type = type;
+    stats->size = size;
+    stats->minq = minq;
+    stats->maxq = maxq;
+    stats->qcount = qcount;
+
+    uint8_t count = StaticRingBuf_GetReadSpans(rbuf, spans);
+    for (uint8_t idx = 0; idx < count; idx++)
+    {
+        STARB_Stats_Notify(rbuf, &stats->observer, STARB_EVENT_ENTER, spans[idx].ptr, spans[idx].len);
+    }
+
+    rc = StaticRingBuf_AddObserver(rbuf, &stats->observer);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Detach the STARB_Stats instance from its ring.
+ *
+ *  @param[in] stats The STARB_Stats instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+ */
+uint8_t STARB_Stats_Detach(STARB_Stats* stats)
+{
+    uint8_t rc = STARB_OK;
+
+    if (stats == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_RemoveObserver(stats->rbuf, &stats->observer);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Get the statistics of the buffered samples, O(1).
+ *
+ *  @param[in] stats   The STARB_Stats instance
+ *  @param[out] result Statistics (all zero when there is no sample)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Stats_Get(STARB_Stats* stats, STARB_StatsResult* result)
+{
+    uint8_t rc = STARB_OK;
+
+    if (stats == NULL || result == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    memset(result, 0, sizeof(STARB_StatsResult));
+    result->count = stats->inseq - stats->outseq;
+    if (result->count <= 0)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    result->sum = stats->sum;
+    result->min = stats->minq[stats->minfirst].value;
+    result->max = stats->maxq[stats->maxfirst].value;
+    result->mean = stats->sum / (int64_t)result->count;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Observer callback: assemble samples from the entering / leaving bytes.
+ *  @details Whole samples are decoded in place; a sample split across calls is
+ *           collected in `inpart` / `outpart` first.
+ */
+static void STARB_Stats_Notify(StaticRingBuf* rbuf, STARB_Observer* observer, const uint8_t event, const byte* data, const STARB_CAPTYPE count)
+{
+    STARB_Stats* stats = (STARB_Stats*)observer;
+    bool enter = (event == STARB_EVENT_ENTER);
+    byte* part = enter ? stats->inpart : stats->outpart;
+    uint8_t* partlen = enter ? &stats->inlen : &stats->outlen;
+    uint32_t remain = count;
+
+    (void)rbuf;
+
+    while (remain > 0 && *partlen > 0)
+    {
+        part[(*partlen)++] = *data++;
+        remain--;
+        if (*partlen == stats->size)
+        {
+            *partlen = 0;
+            STARB_Stats_Apply(stats, enter, part);
+        }
+    }
+
+    for (; remain >= stats->size; remain -= stats->size, data += stats->size)
+    {
+        STARB_Stats_Apply(stats, enter, data);
+    }
+
+    while (remain > 0)
+    {
+        part[(*partlen)++] = *data++;
+        remain--;
+    }
+}
+
+/** @brief Decode one whole sample and account it as entering or leaving. */
+static inline void STARB_Stats_Apply(STARB_Stats* stats, const bool enter, const byte* sample)
+{
+    if (enter)
+    {
+        STARB_Stats_Enter(stats, STARB_Stats_Decode(stats, sample));
+    }
+    else
+    {
+        STARB_Stats_Leave(stats, STARB_Stats_Decode(stats, sample));
+    }
+}
+
+/** @brief Decode one sample (native byte order). */
+static inline int64_t STARB_Stats_Decode(const STARB_Stats* stats, const byte* sample)
+{
+    int64_t value;
+    uint16_t u16;
+    uint32_t u32;
+
+    switch (stats->type)
+    {
+    case STARB_STATS_U8:
+        value = sample[0];
+        break;
+    case STARB_STATS_I8:
+        value = (int8_t)sample[0];
+        break;
+    case STARB_STATS_U16:
+        memcpy(&u16, sample, sizeof(u16));
+        value = u16;
+        break;
+    case STARB_STATS_I16:
+        memcpy(&u16, sample, sizeof(u16));
+        value = (int16_t)u16;
+        break;
+    case STARB_STATS_U32:
+        memcpy(&u32, sample, sizeof(u32));
+        value = u32;
+        break;
+    default:
+        memcpy(&u32, sample, sizeof(u32));
+        value = (int32_t)u32;
+        break;
+    }
+
+    return value;
+}
+
+/** @brief A sample entered: add it to the sum and push it on both deques. */
+static void STARB_Stats_Enter(STARB_Stats* stats, const int64_t value)
+{
+    uint32_t seq = stats->inseq++;
+    uint32_t index;
+
+    stats->sum += value;
+
+    /* min: drop the candidates that are not smaller than the new sample. */
+    while (stats->minnum > 0)
+    {
+        index = stats->minfirst + stats->minnum - 1;
+        index = (index >= stats->qcount) ? index - stats->qcount : index;
+        if (stats->minq[index].value < value)
+        {
+            break;
+        }
+        stats->minnum--;
+    }
+
+    assert(stats->minnum < stats->qcount);
+    index = stats->minfirst + stats->minnum;
+    index = (index >= stats->qcount) ? index - stats->qcount : index;
+    stats->minq[index].value = value;
+    stats->minq[index].seq = seq;
+    stats->minnum++;
+
+    /* max: drop the candidates that are not larger than the new sample. */
+    while (stats->maxnum > 0)
+    {
+        index = stats->maxfirst + stats->maxnum - 1;
+        index = (index >= stats->qcount) ? index - stats->qcount : index;
+        if (stats->maxq[index].value > value)
+        {
+            break;
+        }
+        stats->maxnum--;
+    }
+
+    assert(stats->maxnum < stats->qcount);
+    index = stats->maxfirst + stats->maxnum;
+    index = (index >= stats->qcount) ? index - stats->qcount : index;
+    stats->maxq[index].value = value;
+    stats->maxq[index].seq = seq;
+    stats->maxnum++;
+}
+
+/** @brief The oldest sample left: take it off the sum and off the deque fronts. */
+static void STARB_Stats_Leave(STARB_Stats* stats, const int64_t value)
+{
+    uint32_t seq = stats->outseq++;
+
+    stats->sum -= value;
+
+    if (stats->minnum > 0 && stats->minq[stats->minfirst].seq == seq)
+    {
+        stats->minfirst = (stats->minfirst + 1 < stats->qcount) ? stats->minfirst + 1 : 0;
+        stats->minnum--;
+    }
+
+    if (stats->maxnum > 0 && stats->maxq[stats->maxfirst].seq == seq)
+    {
+        stats->maxfirst = (stats->maxfirst + 1 < stats->qcount) ? stats->maxfirst + 1 : 0;
+        stats->maxnum--;
+    }
+}
@@ -0,0 +1,144 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Stats.h                                          *
+ *  @brief    Incremental statistics over the buffered samples.              *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Stats_H
+#define _INC_GH2025_StaticRingBuf_Stats_H
+
+#include "StaticRingBuf.h"
+
+/** @brief Sample types (low bits: sample size in bytes, 0x80: signed) */
+#define STARB_STATS_U8      0x01
+#define STARB_STATS_I8      0x81
+#define STARB_STATS_U16     0x02
+#define STARB_STATS_I16     0x82
+#define STARB_STATS_U32     0x04
+#define STARB_STATS_I32     0x84
+
+/** @brief Monotonic deque entry */
+typedef struct _STARB_StatsEntry_t {
+    int64_t value;                  // Sample value
+    uint32_t seq;                   // Sample number
+} STARB_StatsEntry;
+
+/** @brief Statistics over the buffered samples */
+typedef struct _STARB_StatsResult_t {
+    uint32_t count;                 // Count of samples
+    int64_t sum;                    // Sum of the samples
+    int64_t min;                    // Smallest sample
+    int64_t max;                    // Largest sample
+    int64_t mean;                   // sum / count, truncated toward zero
+} STARB_StatsResult;
+
+/** \brief  Struct definition for the incremental ring statistics.
+ * \details A StaticRingBuf observer that keeps count, sum, min and max of the
+ *          samples (native byte order) held in the ring, updated as bytes enter
+ *          and leave, so a query is O(1) instead of a pass over the contents.
+ *
+ *          min / max use monotonic deques: a new sample drops every queued
+ *          sample it dominates from the back, a leaving sample is dropped from
+ *          the front if it is still there. Each sample is queued and dropped at
+ *          most once: amortized O(1) per sample.
+ *
+ *          A sample counts from the moment its last byte is written until its
+ *          last byte is read, skipped or overwritten, so transfers need not be
+ *          sample aligned.
+ */
+typedef struct _STARB_Stats_t
+{
+    STARB_Observer observer;        // Attached to `rbuf` (first member)
+    StaticRingBuf* rbuf;            // Observed ring
+    uint8_t type;                   // STARB_STATS_xxx
+    uint8_t size;                   // Sample size in bytes
+    STARB_StatsEntry* minq;         // Deque of min candidates (`qcount` entries)
+    STARB_StatsEntry* maxq;         // Deque of max candidates (`qcount` entries)
+    uint32_t qcount;                // Count of entries per deque
+    uint32_t minfirst;              // Front entry of `minq`
+    uint32_t minnum;                // Count of entries in `minq`
+    uint32_t maxfirst;              // Front entry of `maxq`
+    uint32_t maxnum;                // Count of entries in `maxq`
+    uint32_t inseq;                 // Sample number of the next entering sample
+    uint32_t outseq;                // Sample number of the next leaving sample
+    int64_t sum;                    // Sum of the buffered samples
+    byte inpart[4];                 // Bytes of the partially written sample
+    byte outpart[4];                // Bytes of the partially removed sample
+    uint8_t inlen;                  // Length of `inpart`
+    uint8_t outlen;                 // Length of `outpart`
+
+} STARB_Stats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief   Initialize the STARB_Stats instance and attach it to a ring.
+     *  @details Samples already in the ring are counted (sample aligned at the
+     *           read position).
+     *
+     *  @param[out] stats The STARB_Stats instance to be initialized
+     *  @param[in] rbuf   The StaticRingBuf instance to observe
+     *  @param[in] type   STARB_STATS_xxx
+     *  @param[in] minq   Deque entries for min
+     *  @param[in] maxq   Deque entries for max
+     *  @param[in] qcount Count of entries of each deque (>= capacity / size + 1)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Stats_Init(STARB_Stats* stats, StaticRingBuf* rbuf, const uint8_t type,
+        STARB_StatsEntry* minq, STARB_StatsEntry* maxq, const uint32_t qcount);
+
+    /** @brief Detach the STARB_Stats instance from its ring.
+     *
+     *  @param[in] stats The STARB_Stats instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+     */
+    uint8_t STARB_Stats_Detach(STARB_Stats* stats);
+
+    /** @brief Get the statistics of the buffered samples, O(1).
+     *
+     *  @param[in] stats   The STARB_Stats instance
+     *  @param[out] result Statistics (all zero when there is no sample)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Stats_Get(STARB_Stats* stats, STARB_StatsResult* result);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Stats_H
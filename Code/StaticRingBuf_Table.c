@@ -0,0 +1,477 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Table.h"
+#include "Common/memcopy.h"
+
+static inline byte* STARB_Table_Block(const STARB_Table* tbl, const uint32_t ring);
+static inline void STARB_Table_Alloc(STARB_Table* tbl, const uint32_t ring);
+static inline void STARB_Table_Free(STARB_Table* tbl, const uint32_t ring);
+static inline void STARB_Table_Consume(STARB_Table* tbl, const uint32_t ring, const STARB_CAPTYPE count);
+
+/** @brief Initialize the STARB_Table instance; all rings start cold and empty.
+ *
+ *  @param[out] tbl      The STARB_Table instance to be initialized
+ *  @param[in] arena     Storage arena
+ *  @param[in] arenasize Size of the arena, at least one STARB_TABLE_BLOCKSIZE()
+ *  @param[in] ringcap   Capacity of each ring (4 ~ 0xFFFF)
+ *  @param[in] mode      STARB_MODE_DEFAULT (mirrored) or STARB_MODE_NOMIRROR
+ *  @param[in] count     Count of rings
+ *  @param[in] offsets   Block offset array (`count` entries)
+ *  @param[in] rpos      Read position array (`count` entries)
+ *  @param[in] used      Readable byte count array (`count` entries)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Table_Init(STARB_Table* tbl, byte* arena, const STARB_STOSZTP arenasize,
+    const STARB_CAPTYPE ringcap, const uint8_t mode, const uint32_t count,
+    uint32_t* offsets, STARB_CAPTYPE* rpos, STARB_CAPTYPE* used)
+{
+    uint8_t rc = STARB_OK;
+
+    if (tbl == NULL || arena == NULL || offsets == NULL || rpos == NULL || used == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    uint32_t blocksize = STARB_TABLE_BLOCKSIZE(ringcap, mode);
+    if (ringcap < 4 || count < 1 || (mode & ~STARB_MODE_NOMIRROR) || arenasize < blocksize)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    tbl->arena = arena;
+    tbl->offsets = offsets;
+    tbl->rpos = rpos;
+    tbl->used = used;
+    tbl->count = count;
+    tbl->blocksize = blocksize;
+    tbl->ringcap = ringcap;
+    tbl->mode = mode;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        offsets[i] = STARB_TABLE_COLD;
+        rpos[i] = 0;
+        used[i] = 0;
+    }
+
+    /* Chain the blocks through their first 4 bytes, lowest offset first. */
+    uint32_t blocks = arenasize / blocksize;
+    tbl->freehead = STARB_TABLE_COLD;
+    tbl->freeblocks = blocks;
+    for (uint32_t i = blocks; i > 0; i--)
+    {
+        uint32_t offset = (i - 1) * blocksize;
+        memcpy(arena + offset, &tbl->freehead, sizeof(uint32_t));
+        tbl->freehead = offset;
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Get the count of bytes that can be written to a ring.
+ *  @details A cold ring reports its full capacity while a free block is left.
+ *
+ *  @param[in] tbl  The STARB_Table instance
+ *  @param[in] ring Ring number
+ *  @return Writing capacity (bytes)
+ */
+STARB_CAPTYPE STARB_Table_GetWriteCapacity(STARB_Table* tbl, const uint32_t ring)
+{
+    assert(tbl != NULL);
+
+    STARB_CAPTYPE write_capacity = 0;
+
+    if (ring >= tbl->count)
+    {
+        goto EXIT;
+    }
+
+    if (tbl->offsets[ring] == STARB_TABLE_COLD)
+    {
+        write_capacity = (tbl->freeblocks > 0) ? tbl->ringcap : 0;
+    }
+    else
+    {
+        write_capacity = tbl->ringcap - tbl->used[ring];
+    }
+
+EXIT:
+    return write_capacity;
+}
+
+/** @brief Get the count of bytes readable from a ring.
+ *
+ *  @param[in] tbl  The STARB_Table instance
+ *  @param[in] ring Ring number
+ *  @return Reading capacity (bytes)
+ */
+STARB_CAPTYPE STARB_Table_GetReadCapacity(STARB_Table* tbl, const uint32_t ring)
+{
+    assert(tbl != NULL);
+
+    return (ring < tbl->count) ? tbl->used[ring] : 0;
+}
+
+/** @brief Write bytes to a ring, giving it a storage block if it is cold.
+ *
+ *  @param[in] tbl        The STARB_Table instance
+ *  @param[in] ring       Ring number
+ *  @param[in] srcbuf     Data to write
+ *  @param[in] writecount Count of bytes to write
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (ring full, or no free block for a cold ring).
+ */
+uint8_t STARB_Table_WriteItems(STARB_Table* tbl, const uint32_t ring, const byte* srcbuf, const STARB_CAPTYPE writecount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (writecount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (tbl == NULL || srcbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (ring >= tbl->count || writecount > tbl->ringcap)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (writecount > STARB_Table_GetWriteCapacity(tbl, ring))
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    if (tbl->offsets[ring] == STARB_TABLE_COLD)
+    {
+        STARB_Table_Alloc(tbl, ring);
+    }
+
+    byte* block = STARB_Table_Block(tbl, ring);
+    STARB_CAPTYPE cap = tbl->ringcap;
+    STARB_CAPTYPE wpos = tbl->rpos[ring];
+    STARB_CAPTYPE countL = cap - wpos;
+    if (tbl->used[ring] >= countL)
+    {
+        wpos = tbl->used[ring] - countL;
+    }
+    else
+    {
+        wpos += tbl->used[ring];
+    }
+
+    countL = cap - wpos;
+    if (tbl->mode & STARB_MODE_NOMIRROR)
+    {
+        if (countL >= writecount)
+        {
+            STARB_MemCopy(block + wpos, srcbuf, writecount);
+        }
+        else
+        {
+            STARB_MemCopy(block + wpos, srcbuf, countL);
+            STARB_MemCopy(block, srcbuf + countL, (STARB_CAPTYPE)(writecount - countL));
+        }
+    }
+    else
+    {
+        STARB_MemCopy(block + wpos, srcbuf, writecount);
+        if (countL >= writecount)
+        {
+            STARB_MemCopy(block + wpos + cap, srcbuf, writecount);
+        }
+        else
+        {
+            STARB_MemCopy(block + wpos + cap, srcbuf, countL);
+            STARB_MemCopy(block, block + cap, (STARB_CAPTYPE)(writecount - countL));
+        }
+    }
+
+    tbl->used[ring] += writecount;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Read bytes from a ring.
+ *
+ *  @param[in] tbl       The STARB_Table instance
+ *  @param[in] ring      Ring number
+ *  @param[out] outbuf   Buffer to receive the data
+ *  @param[in] readcount Count of bytes to read
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Table_ReadItems(STARB_Table* tbl, const uint32_t ring, byte* outbuf, const STARB_CAPTYPE readcount)
+{
+    uint8_t rc = STARB_OK;
+    STARB_Span spans[2];
+
+    if (readcount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (tbl == NULL || outbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (ring >= tbl->count || readcount > tbl->ringcap)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (readcount > tbl->used[ring])
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_Table_GetReadSpans(tbl, ring, spans);
+    if (spans[0].len >= readcount)
+    {
+        STARB_MemCopy(outbuf, spans[0].ptr, readcount);
+    }
+    else
+    {
+        STARB_MemCopy(outbuf, spans[0].ptr, spans[0].len);
+        STARB_MemCopy(outbuf + spans[0].len, spans[1].ptr, (STARB_CAPTYPE)(readcount - spans[0].len));
+    }
+
+    STARB_Table_Consume(tbl, ring, readcount);
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Get the readable data of a ring as contiguous spans.
+ *  @details Mirrored storage always yields 1 span; `STARB_MODE_NOMIRROR` yields
+ *           2 spans when the data wraps around the end of the block.
+ *
+ *  @param[in] tbl    The STARB_Table instance
+ *  @param[in] ring   Ring number
+ *  @param[out] spans Array of 2 spans to receive the readable regions
+ *  @return Count of spans filled (0 ~ 2)
+ */
+uint8_t STARB_Table_GetReadSpans(STARB_Table* tbl, const uint32_t ring, STARB_Span spans[2])
+{
+    uint8_t count = 0;
+
+    if (tbl == NULL || spans == NULL || ring >= tbl->count || tbl->used[ring] <= 0)
+    {
+        goto EXIT;
+    }
+
+    byte* block = STARB_Table_Block(tbl, ring);
+    STARB_CAPTYPE rpos = tbl->rpos[ring];
+    STARB_CAPTYPE used = tbl->used[ring];
+
+    spans[0].ptr = block + rpos;
+    spans[0].len = used;
+    count = 1;
+
+    if ((tbl->mode & STARB_MODE_NOMIRROR) && used > tbl->ringcap - rpos)
+    {
+        spans[0].len = tbl->ringcap - rpos;
+        spans[1].ptr = block;
+        spans[1].len = used - spans[0].len;
+        count = 2;
+    }
+
+EXIT:
+    return count;
+}
+
+/** @brief Skip readable bytes of a ring.
+ *
+ *  @param[in] tbl       The STARB_Table instance
+ *  @param[in] ring      Ring number
+ *  @param[in] skipcount Count of bytes to skip
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Table_Forward(STARB_Table* tbl, const uint32_t ring, const STARB_CAPTYPE skipcount)
+{
+    uint8_t rc = STARB_OK;
+
+    if (skipcount <= 0)
+    {
+        goto EXIT;
+    }
+
+    if (tbl == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (ring >= tbl->count)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (skipcount > tbl->used[ring])
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_Table_Consume(tbl, ring, skipcount);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Return the storage block of an empty ring to the free list.
+ *
+ *  @param[in] tbl  The STARB_Table instance
+ *  @param[in] ring Ring number
+ *
+ *  @retval 1    Executed successfully (also when the ring is already cold).
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (or the ring still holds data).
+ */
+uint8_t STARB_Table_Park(STARB_Table* tbl, const uint32_t ring)
+{
+    uint8_t rc = STARB_OK;
+
+    if (tbl == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (ring >= tbl->count || tbl->used[ring] > 0)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    if (tbl->offsets[ring] != STARB_TABLE_COLD)
+    {
+        STARB_Table_Free(tbl, ring);
+    }
+
+EXIT:
+    return rc;
+}
+
+/** @brief Park every empty ring that still holds a storage block.
+ *
+ *  @param[in] tbl The STARB_Table instance
+ *  @return Count of blocks returned to the free list
+ */
+uint32_t STARB_Table_ParkIdle(STARB_Table* tbl)
+{
+    uint32_t parked = 0;
+
+    assert(tbl != NULL);
+
+    for (uint32_t i = 0; i < tbl->count; i++)
+    {
+        if (tbl->used[i] == 0 && tbl->offsets[i] != STARB_TABLE_COLD)
+        {
+            STARB_Table_Free(tbl, i);
+            parked++;
+        }
+    }
+
+    return parked;
+}
+
+/** @brief Find the next ring with readable data.
+ *
+ *  @param[in] tbl  The STARB_Table instance
+ *  @param[in] from First ring number to look at
+ *  @return Ring number, or `tbl->count` when no ring from `from` on has data
+ */
+uint32_t STARB_Table_NextReady(STARB_Table* tbl, const uint32_t from)
+{
+    assert(tbl != NULL);
+
+    const STARB_CAPTYPE* used = tbl->used;
+    uint32_t i = from;
+
+    while (i < tbl->count && used[i] == 0)
+    {
+        i++;
+    }
+
+    return (i < tbl->count) ? i : tbl->count;
+}
+
+/** @brief Storage block of a hot ring. */
+static inline byte* STARB_Table_Block(const STARB_Table* tbl, const uint32_t ring)
+{
+    return tbl->arena + tbl->offsets[ring];
+}
+
+/** @brief Give a cold ring the first free block (caller checked `freeblocks`). */
+static inline void STARB_Table_Alloc(STARB_Table* tbl, const uint32_t ring)
+{
+    uint32_t offset = tbl->freehead;
+
+    memcpy(&tbl->freehead, tbl->arena + offset, sizeof(uint32_t));
+    tbl->freeblocks--;
+    tbl->offsets[ring] = offset;
+    tbl->rpos[ring] = 0;
+}
+
+/** @brief Put the block of a ring back on the free list; the ring turns cold. */
+static inline void STARB_Table_Free(STARB_Table* tbl, const uint32_t ring)
+{
+    uint32_t offset = tbl->offsets[ring];
+
+    memcpy(tbl->arena + offset, &tbl->freehead, sizeof(uint32_t));
+    tbl->freehead = offset;
+    tbl->freeblocks++;
+    tbl->offsets[ring] = STARB_TABLE_COLD;
+    tbl->rpos[ring] = 0;
+}
+
+/** @brief Move the read position of a ring; an emptied ring restarts at 0. */
+static inline void STARB_Table_Consume(STARB_Table* tbl, const uint32_t ring, const STARB_CAPTYPE count)
+{
+    STARB_CAPTYPE rpos = tbl->rpos[ring];
+
+    tbl->used[ring] -= count;
+    if (tbl->used[ring] == 0)
+    {
+        rpos = 0;
+    }
+    else if (rpos >= tbl->ringcap - count)
+    {
+        rpos = (STARB_CAPTYPE)((size_t)rpos + count - tbl->ringcap);
+    }
+    else
+    {
+        rpos += count;
+    }
+
+    tbl->rpos[ring] = rpos;
+}
@@ -0,0 +1,202 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Table.h                                          *
+ *  @brief    Many small rings carved out of one arena.                      *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Table_H
+#define _INC_GH2025_StaticRingBuf_Table_H
+
+#include "StaticRingBuf.h"
+
+/** @brief Offset of a cold ring (no storage block) */
+#define STARB_TABLE_COLD    0xFFFFFFFF
+
+/** @brief Storage block size of one ring in the arena */
+#define STARB_TABLE_BLOCKSIZE(ringcap, mode) \
+    (((mode) & STARB_MODE_NOMIRROR) ? (uint32_t)(ringcap) : 2 * (uint32_t)(ringcap))
+
+/** \brief  Struct definition for the ring table.
+ * \details Holds `count` rings of the same capacity over one arena. The ring
+ *          state is kept as parallel arrays (struct-of-arrays) indexed by ring
+ *          number, 8 bytes per ring:
+ *
+ *          - `offsets`: 32-bit byte offset of the ring's storage block in the
+ *            arena, or STARB_TABLE_COLD when the ring has none;
+ *          - `rpos`:    read position within the block;
+ *          - `used`:    readable byte count (the write position is derived).
+ *
+ *          A ring is cold until its first write, which takes a block from the
+ *          free list. Idle (empty) rings give their block back with
+ *          STARB_Table_Park() / STARB_Table_ParkIdle(), so the arena only
+ *          needs to cover the rings that hold data at the same time.
+ *          "Which rings have data" sweeps (STARB_Table_NextReady()) scan the
+ *          dense `used` array only.
+ *
+ *          Free blocks are chained through their first 4 bytes; no extra
+ *          bookkeeping memory is needed.
+ */
+typedef struct _STARB_Table_t
+{
+    byte* arena;                    // Storage arena
+    uint32_t* offsets;              // Block offset per ring (`count` entries)
+    STARB_CAPTYPE* rpos;            // Read position per ring (`count` entries)
+    STARB_CAPTYPE* used;            // Readable bytes per ring (`count` entries)
+    uint32_t count;                 // Count of rings
+    uint32_t blocksize;             // Storage block size in the arena
+    uint32_t freehead;              // Offset of the first free block, or STARB_TABLE_COLD
+    uint32_t freeblocks;            // Count of free blocks
+    STARB_CAPTYPE ringcap;          // Capacity of each ring (bytes)
+    uint8_t mode;                   // STARB_MODE_DEFAULT or STARB_MODE_NOMIRROR
+
+} STARB_Table;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_Table instance; all rings start cold and empty.
+     *
+     *  @param[out] tbl      The STARB_Table instance to be initialized
+     *  @param[in] arena     Storage arena
+     *  @param[in] arenasize Size of the arena, at least one STARB_TABLE_BLOCKSIZE()
+     *  @param[in] ringcap   Capacity of each ring (4 ~ 0xFFFF)
+     *  @param[in] mode      STARB_MODE_DEFAULT (mirrored) or STARB_MODE_NOMIRROR
+     *  @param[in] count     Count of rings
+     *  @param[in] offsets   Block offset array (`count` entries)
+     *  @param[in] rpos      Read position array (`count` entries)
+     *  @param[in] used      Readable byte count array (`count` entries)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Table_Init(STARB_Table* tbl, byte* arena, const STARB_STOSZTP arenasize,
+        const STARB_CAPTYPE ringcap, const uint8_t mode, const uint32_t count,
+        uint32_t* offsets, STARB_CAPTYPE* rpos, STARB_CAPTYPE* used);
+
+    /** @brief   Get the count of bytes that can be written to a ring.
+     *  @details A cold ring reports its full capacity while a free block is left.
+     *
+     *  @param[in] tbl  The STARB_Table instance
+     *  @param[in] ring Ring number
+     *  @return Writing capacity (bytes)
+     */
+    STARB_CAPTYPE STARB_Table_GetWriteCapacity(STARB_Table* tbl, const uint32_t ring);
+
+    /** @brief Get the count of bytes readable from a ring.
+     *
+     *  @param[in] tbl  The STARB_Table instance
+     *  @param[in] ring Ring number
+     *  @return Reading capacity (bytes)
+     */
+    STARB_CAPTYPE STARB_Table_GetReadCapacity(STARB_Table* tbl, const uint32_t ring);
+
+    /** @brief Write bytes to a ring, giving it a storage block if it is cold.
+     *
+     *  @param[in] tbl        The STARB_Table instance
+     *  @param[in] ring       Ring number
+     *  @param[in] srcbuf     Data to write
+     *  @param[in] writecount Count of bytes to write
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (ring full, or no free block for a cold ring).
+     */
+    uint8_t STARB_Table_WriteItems(STARB_Table* tbl, const uint32_t ring, const byte* srcbuf, const STARB_CAPTYPE writecount);
+
+    /** @brief Read bytes from a ring.
+     *
+     *  @param[in] tbl       The STARB_Table instance
+     *  @param[in] ring      Ring number
+     *  @param[out] outbuf   Buffer to receive the data
+     *  @param[in] readcount Count of bytes to read
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Table_ReadItems(STARB_Table* tbl, const uint32_t ring, byte* outbuf, const STARB_CAPTYPE readcount);
+
+    /** @brief   Get the readable data of a ring as contiguous spans.
+     *  @details Mirrored storage always yields 1 span; `STARB_MODE_NOMIRROR` yields
+     *           2 spans when the data wraps around the end of the block.
+     *
+     *  @param[in] tbl    The STARB_Table instance
+     *  @param[in] ring   Ring number
+     *  @param[out] spans Array of 2 spans to receive the readable regions
+     *  @return Count of spans filled (0 ~ 2)
+     */
+    uint8_t STARB_Table_GetReadSpans(STARB_Table* tbl, const uint32_t ring, STARB_Span spans[2]);
+
+    /** @brief Skip readable bytes of a ring.
+     *
+     *  @param[in] tbl       The STARB_Table instance
+     *  @param[in] ring      Ring number
+     *  @param[in] skipcount Count of bytes to skip
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Table_Forward(STARB_Table* tbl, const uint32_t ring, const STARB_CAPTYPE skipcount);
+
+    /** @brief Return the storage block of an empty ring to the free list.
+     *
+     *  @param[in] tbl  The STARB_Table instance
+     *  @param[in] ring Ring number
+     *
+     *  @retval 1    Executed successfully (also when the ring is already cold).
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (or the ring still holds data).
+     */
+    uint8_t STARB_Table_Park(STARB_Table* tbl, const uint32_t ring);
+
+    /** @brief Park every empty ring that still holds a storage block.
+     *
+     *  @param[in] tbl The STARB_Table instance
+     *  @return Count of blocks returned to the free list
+     */
+    uint32_t STARB_Table_ParkIdle(STARB_Table* tbl);
+
+    /** @brief Find the next ring with readable data.
+     *
+     *  @param[in] tbl  The STARB_Table instance
+     *  @param[in] from First ring number to look at
+     *  @return Ring number, or `tbl->count` when no ring from `from` on has data
+     */
+    uint32_t STARB_Table_NextReady(STARB_Table* tbl, const uint32_t from);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Table_H
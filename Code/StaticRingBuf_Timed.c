@@ -0,0 +1,339 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Timed.h"
+
+static inline const byte* STARB_Timed_Record(const STARB_Timed* timed, const uint32_t pos, uint64_t* ts, STARB_CAPTYPE* len);
+static inline const STARB_TimedMark* STARB_Timed_Mark(const STARB_Timed* timed, const uint32_t index);
+static void STARB_Timed_DropOldest(STARB_Timed* timed);
+
+/** @brief Initialize the STARB_Timed instance.
+ *
+ *  @param[out] timed            The STARB_Timed instance to be initialized
+ *  @param[in] total_buffer_size Physical size for the storage buffer (mirrored: 2x capacity)
+ *  @param[in] _buffer           Pointer to the physical storage buffer
+ *  @param[in] marks             Sparse index entries
+ *  @param[in] markcount         Count of index entries (>= 1)
+ *  @param[in] stride            Index every `stride`-th record (>= 1)
+ *  @param[in] window            Retention window (ticks)
+ *  @param[in] logcallback       Dropped record log, or NULL
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Timed_Init(STARB_Timed* timed, const STARB_STOSZTP total_buffer_size, byte* _buffer,
+    STARB_TimedMark* marks, const uint32_t markcount, const uint32_t stride, const uint64_t window,
+    STARB_LostdataLogFunc logcallback)
+{
+    uint8_t rc = STARB_OK;
+
+    if (timed == NULL || _buffer == NULL || marks == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (total_buffer_size <= 2 * STARB_TIMED_HDRSIZE || markcount < 1 || stride < 1)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_Init(&timed->rbuf, total_buffer_size, _buffer);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    timed->marks = marks;
+    timed->markcount = markcount;
+    timed->markfirst = 0;
+    timed->marknum = 0;
+    timed->stride = stride;
+    timed->unmarked = 0;
+    timed->rdpos = 0;
+    timed->records = 0;
+    timed->dropped = 0;
+    timed->window = window;
+    timed->last = 0;
+    timed->logcallback = logcallback;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Append a record; records out of the window, or in the way, are dropped.
+ *
+ *  @param[in] timed  The STARB_Timed instance
+ *  @param[in] ts     Timestamp, not older than the newest record
+ *  @param[in] srcbuf Payload
+ *  @param[in] len    Payload length (record must fit in the capacity)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (too long, or timestamp going back).
+ */
+uint8_t STARB_Timed_Write(STARB_Timed* timed, const uint64_t ts, const byte* srcbuf, const STARB_CAPTYPE len)
+{
+    uint8_t rc = STARB_OK;
+    byte header[STARB_TIMED_HDRSIZE];
+
+    if (timed == NULL || (srcbuf == NULL && len > 0))
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (len > timed->rbuf.capacity - STARB_TIMED_HDRSIZE || (timed->records > 0 && ts < timed->last))
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    timed->last = ts;
+    STARB_Timed_Trim(timed, ts);
+
+    STARB_CAPTYPE size = STARB_TIMED_HDRSIZE + len;
+    while (StaticRingBuf_GetWriteCapacity(&timed->rbuf) < size)
+    {
+        STARB_Timed_DropOldest(timed);
+    }
+
+    uint32_t pos = timed->rdpos + StaticRingBuf_GetReadCapacity(&timed->rbuf);
+
+    memcpy(header, &ts, sizeof(uint64_t));
+    memcpy(header + sizeof(uint64_t), &len, sizeof(STARB_CAPTYPE));
+    StaticRingBuf_WriteItems(&timed->rbuf, header, STARB_TIMED_HDRSIZE);
+    StaticRingBuf_WriteItems(&timed->rbuf, (byte*)srcbuf, len);
+    timed->records++;
+
+    if (timed->unmarked == 0)
+    {
+        if (timed->marknum >= timed->markcount)
+        {
+            /* Index full: give up the oldest mark. */
+            timed->markfirst = (timed->markfirst + 1 < timed->markcount) ? timed->markfirst + 1 : 0;
+            timed->marknum--;
+        }
+
+        uint32_t index = timed->markfirst + timed->marknum;
+        if (index >= timed->markcount)
+        {
+            index -= timed->markcount;
+        }
+
+        timed->marks[index].ts = ts;
+        timed->marks[index].pos = pos;
+        timed->marknum++;
+    }
+
+    timed->unmarked = (timed->unmarked + 1 < timed->stride) ? timed->unmarked + 1 : 0;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Drop the records older than `now` - `window`.
+ *
+ *  @param[in] timed The STARB_Timed instance
+ *  @param[in] now   Current time (ticks)
+ *  @return Count of records dropped
+ */
+uint32_t STARB_Timed_Trim(STARB_Timed* timed, const uint64_t now)
+{
+    uint32_t dropped = 0;
+    uint64_t ts = 0;
+    STARB_CAPTYPE len = 0;
+
+    assert(timed != NULL);
+
+    if (now <= timed->window)
+    {
+        goto EXIT;
+    }
+
+    while (timed->records > 0)
+    {
+        STARB_Timed_Record(timed, timed->rdpos, &ts, &len);
+        if (ts >= now - timed->window)
+        {
+            break;
+        }
+
+        STARB_Timed_DropOldest(timed);
+        dropped++;
+    }
+
+EXIT:
+    return dropped;
+}
+
+/** @brief Find the first record with a timestamp at or after `ts`.
+ *
+ *  @param[in] timed   The STARB_Timed instance
+ *  @param[in] ts      Timestamp to look for
+ *  @param[out] cursor Stream position of the record, for STARB_Timed_Next()
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data (no record at or after `ts`).
+ */
+uint8_t STARB_Timed_Seek(STARB_Timed* timed, const uint64_t ts, uint32_t* cursor)
+{
+    uint8_t rc = STARB_OK;
+    uint64_t rects = 0;
+    STARB_CAPTYPE len = 0;
+
+    if (timed == NULL || cursor == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (timed->records <= 0 || timed->last < ts)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    /* Last mark before `ts`: the record wanted is at most `stride` records after it. */
+    uint32_t lo = 0;
+    uint32_t hi = timed->marknum;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (STARB_Timed_Mark(timed, mid)->ts < ts)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    uint32_t pos = (lo > 0) ? STARB_Timed_Mark(timed, lo - 1)->pos : timed->rdpos;
+    uint32_t end = timed->rdpos + StaticRingBuf_GetReadCapacity(&timed->rbuf);
+    while (pos != end)
+    {
+        STARB_Timed_Record(timed, pos, &rects, &len);
+        if (rects >= ts)
+        {
+            *cursor = pos;
+            goto EXIT;
+        }
+
+        pos += STARB_TIMED_HDRSIZE + len;
+    }
+
+    rc = STARB_NOENOUGHDAT;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Get the record at `cursor` (zero-copy) and move the cursor to the next one.
+ *  @details The payload stays valid until the record is dropped.
+ *
+ *  @param[in] timed      The STARB_Timed instance
+ *  @param[in,out] cursor Stream position from STARB_Timed_Seek() or a previous call
+ *  @param[out] ts        Timestamp of the record
+ *  @param[out] payload   Payload of the record
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE5 Failed: No (enough) data (cursor at the end).
+ *  @retval 0xE6 Failed: Invalid data (the record at `cursor` has been dropped).
+ */
+uint8_t STARB_Timed_Next(STARB_Timed* timed, uint32_t* cursor, uint64_t* ts, STARB_Span* payload)
+{
+    uint8_t rc = STARB_OK;
+    STARB_CAPTYPE len = 0;
+
+    if (timed == NULL || cursor == NULL || ts == NULL || payload == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    uint32_t offset = *cursor - timed->rdpos;
+    uint32_t used = StaticRingBuf_GetReadCapacity(&timed->rbuf);
+    if (offset > used)
+    {
+        rc = STARB_DATAINVALID;
+        goto EXIT;
+    }
+
+    if (offset == used)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    const byte* record = STARB_Timed_Record(timed, *cursor, ts, &len);
+    payload->ptr = (byte*)record + STARB_TIMED_HDRSIZE;
+    payload->len = len;
+    *cursor += STARB_TIMED_HDRSIZE + len;
+
+EXIT:
+    return rc;
+}
+
+/** @brief Locate the record at stream position `pos` (mirror: contiguous) and read its header. */
+static inline const byte* STARB_Timed_Record(const STARB_Timed* timed, const uint32_t pos, uint64_t* ts, STARB_CAPTYPE* len)
+{
+    STARB_STOSZTP offset = (STARB_STOSZTP)timed->rbuf.rpos + (pos - timed->rdpos);
+    if (offset >= timed->rbuf.capacity)
+    {
+        offset -= timed->rbuf.capacity;
+    }
+
+    const byte* record = timed->rbuf.buffer + offset;
+    memcpy(ts, record, sizeof(uint64_t));
+    memcpy(len, record + sizeof(uint64_t), sizeof(STARB_CAPTYPE));
+
+    return record;
+}
+
+/** @brief Mark `index` counted from the oldest one. */
+static inline const STARB_TimedMark* STARB_Timed_Mark(const STARB_Timed* timed, const uint32_t index)
+{
+    uint32_t physical = timed->markfirst + index;
+    if (physical >= timed->markcount)
+    {
+        physical -= timed->markcount;
+    }
+
+    return &timed->marks[physical];
+}
+
+/** @brief Drop the oldest record (logged) and the marks pointing into it. */
+static void STARB_Timed_DropOldest(STARB_Timed* timed)
+{
+    uint64_t ts = 0;
+    STARB_CAPTYPE len = 0;
+    STARB_Lostdata lost;
+
+    const byte* record = STARB_Timed_Record(timed, timed->rdpos, &ts, &len);
+    STARB_CAPTYPE size = STARB_TIMED_HDRSIZE + len;
+
+    if (timed->logcallback != NULL)
+    {
+        lost.dataptr = (byte*)record;
+        lost.pos = timed->rbuf.rpos;
+        lost.count = size;
+        timed->logcallback(&lost);
+    }
+
+    StaticRingBuf_Forward(&timed->rbuf, size);
+    timed->rdpos += size;
+    timed->records--;
+    timed->dropped++;
+
+    uint32_t used = StaticRingBuf_GetReadCapacity(&timed->rbuf);
+    while (timed->marknum > 0 && timed->marks[timed->markfirst].pos - timed->rdpos >= used)
+    {
+        timed->markfirst = (timed->markfirst + 1 < timed->markcount) ? timed->markfirst + 1 : 0;
+        timed->marknum--;
+    }
+}
@@ -0,0 +1,160 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Timed.h                                          *
+ *  @brief    Timestamped records with time-window retention.                *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Timed_H
+#define _INC_GH2025_StaticRingBuf_Timed_H
+
+#include "StaticRingBuf.h"
+
+/** @brief Record header size: 64-bit timestamp + 16-bit payload length */
+#define STARB_TIMED_HDRSIZE     10
+
+/** @brief Sparse index entry */
+typedef struct _STARB_TimedMark_t {
+    uint64_t ts;                    // Timestamp of the indexed record
+    uint32_t pos;                   // Stream position of the indexed record
+} STARB_TimedMark;
+
+/** \brief  Struct definition for the time-indexed record ring.
+ * \details Records are stored back to back in a mirrored StaticRingBuf as
+ *          [timestamp][length][payload], so every record is contiguous.
+ *          Timestamps are caller-defined monotonic ticks (e.g. ns).
+ *
+ *          Retention is driven by age: every write (or an explicit
+ *          STARB_Timed_Trim()) drops the records older than `window` ticks
+ *          from the newest timestamp, oldest first. Each record is dropped
+ *          exactly once, so trimming is O(1) amortized. When a new record
+ *          does not fit, the oldest records are dropped as well, like
+ *          StaticRingBuf_ForceWriteItemsWithLog(). Every dropped record is
+ *          reported to the optional log callback.
+ *
+ *          Every `stride`-th record is entered in a sparse index (a ring
+ *          of `markcount` marks). STARB_Timed_Seek() binary searches the
+ *          index, then scans at most `stride` records. Size the index for
+ *          (max records / stride) marks; when it is full the oldest mark
+ *          is dropped and seeks into that old range scan longer.
+ *
+ *          Positions (`pos`, cursors) count bytes since init and wrap at 2^32.
+ */
+typedef struct _STARB_Timed_t
+{
+    StaticRingBuf rbuf;             // Record storage (mirrored)
+    STARB_TimedMark* marks;         // Sparse index (`markcount` entries)
+    uint32_t markcount;             // Count of index entries
+    uint32_t markfirst;             // Physical index of the oldest mark
+    uint32_t marknum;               // Count of valid marks
+    uint32_t stride;                // Index every `stride`-th record
+    uint32_t unmarked;              // Records written since the last mark
+    uint32_t rdpos;                 // Stream position of the oldest record
+    uint32_t records;               // Count of records held
+    uint32_t dropped;               // Count of records dropped (age or space)
+    uint64_t window;                // Retention window (ticks)
+    uint64_t last;                  // Timestamp of the newest record
+    STARB_LostdataLogFunc logcallback;  // Dropped record log (optional)
+
+} STARB_Timed;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_Timed instance.
+     *
+     *  @param[out] timed            The STARB_Timed instance to be initialized
+     *  @param[in] total_buffer_size Physical size for the storage buffer (mirrored: 2x capacity)
+     *  @param[in] _buffer           Pointer to the physical storage buffer
+     *  @param[in] marks             Sparse index entries
+     *  @param[in] markcount         Count of index entries (>= 1)
+     *  @param[in] stride            Index every `stride`-th record (>= 1)
+     *  @param[in] window            Retention window (ticks)
+     *  @param[in] logcallback       Dropped record log, or NULL
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Timed_Init(STARB_Timed* timed, const STARB_STOSZTP total_buffer_size, byte* _buffer,
+        STARB_TimedMark* marks, const uint32_t markcount, const uint32_t stride, const uint64_t window,
+        STARB_LostdataLogFunc logcallback);
+
+    /** @brief Append a record; records out of the window, or in the way, are dropped.
+     *
+     *  @param[in] timed  The STARB_Timed instance
+     *  @param[in] ts     Timestamp, not older than the newest record
+     *  @param[in] srcbuf Payload
+     *  @param[in] len    Payload length (record must fit in the capacity)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (too long, or timestamp going back).
+     */
+    uint8_t STARB_Timed_Write(STARB_Timed* timed, const uint64_t ts, const byte* srcbuf, const STARB_CAPTYPE len);
+
+    /** @brief Drop the records older than `now` - `window`.
+     *
+     *  @param[in] timed The STARB_Timed instance
+     *  @param[in] now   Current time (ticks)
+     *  @return Count of records dropped
+     */
+    uint32_t STARB_Timed_Trim(STARB_Timed* timed, const uint64_t now);
+
+    /** @brief Find the first record with a timestamp at or after `ts`.
+     *
+     *  @param[in] timed   The STARB_Timed instance
+     *  @param[in] ts      Timestamp to look for
+     *  @param[out] cursor Stream position of the record, for STARB_Timed_Next()
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data (no record at or after `ts`).
+     */
+    uint8_t STARB_Timed_Seek(STARB_Timed* timed, const uint64_t ts, uint32_t* cursor);
+
+    /** @brief   Get the record at `cursor` (zero-copy) and move the cursor to the next one.
+     *  @details The payload stays valid until the record is dropped.
+     *
+     *  @param[in] timed      The STARB_Timed instance
+     *  @param[in,out] cursor Stream position from STARB_Timed_Seek() or a previous call
+     *  @param[out] ts        Timestamp of the record
+     *  @param[out] payload   Payload of the record
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE5 Failed: No (enough) data (cursor at the end).
+     *  @retval 0xE6 Failed: Invalid data (the record at `cursor` has been dropped).
+     */
+    uint8_t STARB_Timed_Next(STARB_Timed* timed, uint32_t* cursor, uint64_t* ts, STARB_Span* payload);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Timed_H
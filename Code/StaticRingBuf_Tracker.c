@@ -0,0 +1,212 @@
+﻿#include <assert.h>
+#include <string.h>
+#include "StaticRingBuf_Tracker.h"
+
+static inline uint32_t STARB_Tracker_Distance(const STARB_Tracker* trk, const uint32_t head, const uint32_t tail);
+static inline uint32_t STARB_Tracker_Advance(const STARB_Tracker* trk, const uint32_t index);
+
+/** @brief Initialize the STARB_Tracker instance.
+ *
+ *  @param[out] trk  The STARB_Tracker instance to be initialized
+ *  @param[in] rbuf  The StaticRingBuf instance to track (consumer side)
+ *  @param[in] slots Borrow records, bounds the count of outstanding borrows
+ *  @param[in] count Count of borrow records (1 ~ 0xFFFF)
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Tracker_Init(STARB_Tracker* trk, StaticRingBuf* rbuf, STARB_Borrow* slots, const uint32_t count)
+{
+    uint8_t rc = STARB_OK;
+
+    if (trk == NULL || rbuf == NULL || slots == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (count < 1 || count > UINT16_MAX)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(slots, 0, count * sizeof(STARB_Borrow));
+    trk->rbuf = rbuf;
+    trk->slots = slots;
+    trk->count = count;
+    trk->head = 0;
+    trk->tail = 0;
+    trk->acquired = 0;
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Borrow the next `readcount` readable bytes.
+ *  @details The region is returned as 1 span (mirrored storage) or, with
+ *           `STARB_MODE_NOMIRROR` and wrapped data, 2 spans; an unused
+ *           `spans[1]` has length 0. The bytes stay valid until released.
+ *
+ *  @param[in] trk       The STARB_Tracker instance
+ *  @param[in] readcount The length to borrow (unit: bytes)
+ *  @param[out] spans    Array of 2 spans to receive the borrowed region
+ *  @param[out] handle   Handle to pass to STARB_Tracker_Release()
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ *  @retval 0xE4 Failed: Buffer overflow (all borrow records in use).
+ *  @retval 0xE5 Failed: No (enough) data.
+ */
+uint8_t STARB_Tracker_Acquire(STARB_Tracker* trk, const STARB_CAPTYPE readcount, STARB_Span spans[2], uint32_t* handle)
+{
+    uint8_t rc = STARB_OK;
+
+    if (trk == NULL || spans == NULL || handle == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    StaticRingBuf* rbuf = trk->rbuf;
+    if (readcount <= 0 || readcount > rbuf->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    STARB_Tracker_Reclaim(trk);
+
+    if (STARB_Tracker_Distance(trk, trk->head, trk->tail) >= trk->count)
+    {
+        rc = STARB_BUFOVERFLOW;
+        goto EXIT;
+    }
+
+    if (readcount > StaticRingBuf_GetReadCapacity(rbuf) - trk->acquired)
+    {
+        rc = STARB_NOENOUGHDAT;
+        goto EXIT;
+    }
+
+    STARB_STOSZTP pos = (STARB_STOSZTP)rbuf->rpos + trk->acquired;
+    if (pos >= rbuf->capacity)
+    {
+        pos -= rbuf->capacity;
+    }
+
+    spans[0].ptr = rbuf->buffer + pos;
+    spans[0].len = readcount;
+    spans[1].ptr = rbuf->buffer;
+    spans[1].len = 0;
+    if ((rbuf->mode & STARB_MODE_NOMIRROR) && readcount > rbuf->capacity - pos)
+    {
+        spans[0].len = (STARB_CAPTYPE)(rbuf->capacity - pos);
+        spans[1].len = readcount - spans[0].len;
+    }
+
+    STARB_Borrow* slot = &trk->slots[trk->head % trk->count];
+    slot->len = readcount;
+    slot->released = 0;
+    trk->acquired += readcount;
+
+    *handle = trk->head;
+    STARB_StoreRelease32(&trk->head, STARB_Tracker_Advance(trk, trk->head));
+
+EXIT:
+    return rc;
+}
+
+/** @brief   Give a borrowed region back, in any order.
+ *  @details Only marks the borrow; the space returns to the producer on the
+ *           next STARB_Tracker_Reclaim() / STARB_Tracker_Acquire().
+ *
+ *  @param[in] trk    The STARB_Tracker instance
+ *  @param[in] handle Handle received from STARB_Tracker_Acquire()
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (unknown handle).
+ */
+uint8_t STARB_Tracker_Release(STARB_Tracker* trk, const uint32_t handle)
+{
+    uint8_t rc = STARB_OK;
+
+    if (trk == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    uint32_t head = STARB_LoadAcquire32(&trk->head);
+    uint32_t tail = STARB_LoadAcquire32(&trk->tail);
+    if (handle >= 2 * trk->count ||
+        STARB_Tracker_Distance(trk, handle, tail) >= STARB_Tracker_Distance(trk, head, tail))
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    STARB_StoreRelease32(&trk->slots[handle % trk->count].released, 1);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Move the read position over the released borrows at the front.
+ *
+ *  @param[in] trk The STARB_Tracker instance
+ *  @return Count of bytes returned to the producer (0 if the ring refused to move)
+ */
+STARB_CAPTYPE STARB_Tracker_Reclaim(STARB_Tracker* trk)
+{
+    assert(trk != NULL);
+
+    STARB_CAPTYPE reclaimed = 0;
+    uint32_t tail = trk->tail;
+
+    while (tail != trk->head)
+    {
+        STARB_Borrow* slot = &trk->slots[tail % trk->count];
+        if (STARB_LoadAcquire32(&slot->released) == 0)
+        {
+            break;
+        }
+        reclaimed += slot->len;
+        tail = STARB_Tracker_Advance(trk, tail);
+    }
+
+    if (reclaimed > 0)
+    {
+        /* Fails only if the ring was read behind the tracker's back: keep the
+         * borrows and the accounting as they are rather than drift. */
+        uint8_t rc = StaticRingBuf_Forward(trk->rbuf, reclaimed);
+        assert(rc == STARB_OK);
+        if (rc != STARB_OK)
+        {
+            reclaimed = 0;
+            goto EXIT;
+        }
+
+        trk->acquired -= reclaimed;
+        STARB_StoreRelease32(&trk->tail, tail);
+    }
+
+EXIT:
+    return reclaimed;
+}
+
+/** @brief Count of borrows from `tail` up to `head` (handles in [0, 2 * count)). */
+static inline uint32_t STARB_Tracker_Distance(const STARB_Tracker* trk, const uint32_t head, const uint32_t tail)
+{
+    return (head >= tail) ? (head - tail) : (head + 2 * trk->count - tail);
+}
+
+/** @brief Next handle, wrapping at 2 * count. */
+static inline uint32_t STARB_Tracker_Advance(const STARB_Tracker* trk, const uint32_t index)
+{
+    uint32_t next = index + 1;
+    return (next >= 2 * trk->count) ? 0 : next;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Tracker.h                                        *
+ *  @brief    Out-of-order release of zero-copy borrows.                     *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Tracker_H
+#define _INC_GH2025_StaticRingBuf_Tracker_H
+
+#include "StaticRingBuf.h"
+#include "Common/platform.h"
+
+/** @brief Borrowed region record */
+typedef struct _STARB_Borrow_t {
+    STARB_CAPTYPE len;              // Length of the borrowed region (bytes)
+    volatile uint32_t released;     // Set by STARB_Tracker_Release()
+} STARB_Borrow;
+
+/** \brief  Struct definition for the release tracker.
+ * \details Lets the consumer of a StaticRingBuf lend out several regions of the
+ *          readable data (zero-copy) and get them back in any order.
+ *
+ *          Borrows are taken one after another from the read position; handles
+ *          run in [0, 2 * count) like the STARB_Spsc indexes. STARB_Tracker_Release() only marks a borrow as done
+ *          (one release store, callable from any thread); STARB_Tracker_Reclaim()
+ *          then moves `rpos` over the longest run of released borrows at the front.
+ *          Reclaim runs in the context owning the ring, and also at the start of
+ *          every STARB_Tracker_Acquire().
+ *
+ *          Do not read from or forward `rbuf` while borrows are outstanding.
+ */
+typedef struct _STARB_Tracker_t
+{
+    StaticRingBuf* rbuf;            // Tracked ring buffer
+    STARB_Borrow* slots;            // Borrow records (`count` entries)
+    uint32_t count;                 // Count of borrow records
+    volatile uint32_t head;         // Handle of the next borrow
+    volatile uint32_t tail;         // Handle of the oldest borrow not yet reclaimed
+    STARB_CAPTYPE acquired;         // Bytes lent out beyond `rpos`
+
+} STARB_Tracker;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief Initialize the STARB_Tracker instance.
+     *
+     *  @param[out] trk  The STARB_Tracker instance to be initialized
+     *  @param[in] rbuf  The StaticRingBuf instance to track (consumer side)
+     *  @param[in] slots Borrow records, bounds the count of outstanding borrows
+     *  @param[in] count Count of borrow records (1 ~ 0xFFFF)
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Tracker_Init(STARB_Tracker* trk, StaticRingBuf* rbuf, STARB_Borrow* slots, const uint32_t count);
+
+    /** @brief   Borrow the next `readcount` readable bytes.
+     *  @details The region is returned as 1 span (mirrored storage) or, with
+     *           `STARB_MODE_NOMIRROR` and wrapped data, 2 spans; an unused
+     *           `spans[1]` has length 0. The bytes stay valid until released.
+     *
+     *  @param[in] trk       The STARB_Tracker instance
+     *  @param[in] readcount The length to borrow (unit: bytes)
+     *  @param[out] spans    Array of 2 spans to receive the borrowed region
+     *  @param[out] handle   Handle to pass to STARB_Tracker_Release()
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     *  @retval 0xE4 Failed: Buffer overflow (all borrow records in use).
+     *  @retval 0xE5 Failed: No (enough) data.
+     */
+    uint8_t STARB_Tracker_Acquire(STARB_Tracker* trk, const STARB_CAPTYPE readcount, STARB_Span spans[2], uint32_t* handle);
+
+    /** @brief   Give a borrowed region back, in any order.
+     *  @details Only marks the borrow; the space returns to the producer on the
+     *           next STARB_Tracker_Reclaim() / STARB_Tracker_Acquire().
+     *
+     *  @param[in] trk    The STARB_Tracker instance
+     *  @param[in] handle Handle received from STARB_Tracker_Acquire()
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (unknown handle).
+     */
+    uint8_t STARB_Tracker_Release(STARB_Tracker* trk, const uint32_t handle);
+
+    /** @brief Move the read position over the released borrows at the front.
+     *
+     *  @param[in] trk The STARB_Tracker instance
+     *  @return Count of bytes returned to the producer (0 if the ring refused to move)
+     */
+    STARB_CAPTYPE STARB_Tracker_Reclaim(STARB_Tracker* trk);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Tracker_H
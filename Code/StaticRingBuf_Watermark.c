@@ -0,0 +1,138 @@
+﻿#include <string.h>
+#include "StaticRingBuf_Watermark.h"
+
+static void STARB_Watermark_Notify(StaticRingBuf* rbuf, STARB_Observer* observer, const uint8_t event, const byte* data, const STARB_CAPTYPE count);
+static inline void STARB_Watermark_Fire(STARB_Watermark* watermark, const uint8_t event);
+
+/** @brief   Initialize the STARB_Watermark instance and attach it to a ring.
+ *  @details The initial state follows the current occupancy (above when it
+ *           is at least `high`) without firing an event. The callback must
+ *           not move the indexes of the ring; typically it flags the
+ *           upstream sender. Overwriting more than `capacity - low` bytes in
+ *           one StaticRingBuf_ForceWriteItemsWithLog() call reports a LOW /
+ *           HIGH pair.
+ *
+ *  @param[out] watermark The STARB_Watermark instance to be initialized
+ *  @param[in] rbuf       The StaticRingBuf instance to observe
+ *  @param[in] low        Low watermark (0 ~ high - 1)
+ *  @param[in] high       High watermark (low + 1 ~ capacity)
+ *  @param[in] callback   Edge callback (NULL: flag bits only)
+ *  @param[in] context    Passed to `callback`
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range.
+ */
+uint8_t STARB_Watermark_Init(STARB_Watermark* watermark, StaticRingBuf* rbuf, const STARB_CAPTYPE low,
+    const STARB_CAPTYPE high, STARB_WatermarkFunc callback, void* context)
+{
+    uint8_t rc = STARB_OK;
+
+    if (watermark == NULL || rbuf == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    if (low >= high || high > rbuf->capacity)
+    {
+        rc = STARB_PARAMOUTRANGE;
+        goto EXIT;
+    }
+
+    memset(watermark, 0, sizeof(STARB_Watermark));
+    watermark->observer.notify = STARB_Watermark_Notify;
+    watermark->rbuf = rbuf;
+    watermark->callback = callback;
+    watermark->context = context;
+    watermark->low = low;
+    watermark->high = high;
+    watermark->above = StaticRingBuf_GetReadCapacity(rbuf) >= high;
+
+    rc = StaticRingBuf_AddObserver(rbuf, &watermark->observer);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Detach the STARB_Watermark instance from its ring.
+ *
+ *  @param[in] watermark The STARB_Watermark instance
+ *
+ *  @retval 1    Executed successfully.
+ *  @retval 0xE1 Failed: Has empty input parameter.
+ *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+ */
+uint8_t STARB_Watermark_Detach(STARB_Watermark* watermark)
+{
+    uint8_t rc = STARB_OK;
+
+    if (watermark == NULL)
+    {
+        rc = STARB_PARAM_NULL;
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_RemoveObserver(watermark->rbuf, &watermark->observer);
+
+EXIT:
+    return rc;
+}
+
+/** @brief Check whether the ring is above the watermarks (HIGH fired, LOW not yet). */
+bool STARB_Watermark_IsAbove(STARB_Watermark* watermark)
+{
+    return (watermark == NULL) ? false : watermark->above;
+}
+
+/** @brief Get and clear the edges that happened since the last call (STARB_WATERMARK_xxx bits). */
+uint8_t STARB_Watermark_TakeEvents(STARB_Watermark* watermark)
+{
+    uint8_t events = 0;
+
+    if (watermark != NULL)
+    {
+        events = watermark->events;
+        watermark->events = 0;
+    }
+
+    return events;
+}
+
+/** @brief   Observer callback: compare the occupancy with the watermark on the side it moves to.
+ *  @details Entering bytes can only cross `high`, leaving bytes only `low`;
+ *           a wrapped transfer is reported in two pieces after the indexes
+ *           moved, so the second piece sees the same occupancy and stays quiet.
+ */
+static void STARB_Watermark_Notify(StaticRingBuf* rbuf, STARB_Observer* observer, const uint8_t event, const byte* data, const STARB_CAPTYPE count)
+{
+    STARB_Watermark* watermark = (STARB_Watermark*)observer;
+    STARB_CAPTYPE occupancy = StaticRingBuf_GetReadCapacity(rbuf);
+
+    (void)data;
+    (void)count;
+
+    if (event == STARB_EVENT_ENTER)
+    {
+        if (!watermark->above && occupancy >= watermark->high)
+        {
+            watermark->above = true;
+            STARB_Watermark_Fire(watermark, STARB_WATERMARK_HIGH);
+        }
+    }
+    else if (watermark->above && occupancy <= watermark->low)
+    {
+        watermark->above = false;
+        STARB_Watermark_Fire(watermark, STARB_WATERMARK_LOW);
+    }
+}
+
+/** @brief Latch the edge and call the callback. */
+static inline void STARB_Watermark_Fire(STARB_Watermark* watermark, const uint8_t event)
+{
+    watermark->events |= event;
+    if (watermark->callback != NULL)
+    {
+        watermark->callback(watermark, event, watermark->context);
+    }
+}
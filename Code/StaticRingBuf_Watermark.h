@@ -0,0 +1,114 @@
+﻿/*****************************************************************************
+ *  @file     StaticRingBuf_Watermark.h                                      *
+ *  @brief    Low / high watermark notifications for flow control            *
+ *                                                                           *
+ *  @author   agent                                                          *
+ *  @version  0.1.0.0                                                        *
+ *  @date     2026-10-19                                                     *
+ *---------------------------------------------------------------------------*
+ *  Copyright 2026 agent                                                     *
+ *                                                                           *
+ *  Licensed under the Apache License, Version 2.0 (the "License");          *
+ *  you may not use this file except in compliance with the License.         *
+ *  You may obtain a copy of the License at                                  *
+ *                                                                           *
+ *      http://www.apache.org/licenses/LICENSE-2.0                           *
+ *                                                                           *
+ *  Unless required by applicable law or agreed to in writing, software      *
+ *  distributed under the License is distributed on an "AS IS" BASIS,        *
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. *
+ *  See the License for the specific language governing permissions and      *
+ *  limitations under the License.                                           *
+ *---------------------------------------------------------------------------*
+ *  Change History :                                                         *
+ *---------------------------------------------------------------------------*
+ *  2026/10/19 | 0.1.0.0   | agent      | Create file                        *
+ *---------------------------------------------------------------------------*
+ *                                                                           *
+ *************************************************************************** */
+
+
+#ifndef _INC_GH2025_StaticRingBuf_Watermark_H
+#define _INC_GH2025_StaticRingBuf_Watermark_H
+
+#include "StaticRingBuf.h"
+
+/** @brief Watermark events */
+#define STARB_WATERMARK_HIGH    0x01    // Occupancy rose to `high`: pause the senders
+#define STARB_WATERMARK_LOW     0x02    // Occupancy fell back to `low`: resume the senders
+
+typedef struct _STARB_Watermark_t STARB_Watermark;
+
+/** @brief Watermark callback (`event`: STARB_WATERMARK_xxx), called from the ring's write / read path. */
+typedef void (*STARB_WatermarkFunc)(STARB_Watermark* watermark, const uint8_t event, void* context);
+
+/** \brief  Struct definition for the watermark notifier.
+ * \details A StaticRingBuf observer that compares the occupancy (readable
+ *          bytes) with two thresholds after every write and read:
+ *          - HIGH fires when the occupancy reaches `high`;
+ *          - LOW fires when it falls back to `low`, and only after a HIGH.
+ *          Between the two thresholds nothing fires (hysteresis), so a ring
+ *          hovering around one threshold does not produce an event per byte.
+ *
+ *          Each edge calls `callback` (if set) and sets its bit in `events`,
+ *          for callers that prefer to check a flag than to be called back.
+ */
+struct _STARB_Watermark_t
+{
+    STARB_Observer observer;        // Attached to `rbuf` (first member)
+    StaticRingBuf* rbuf;            // Observed ring
+    STARB_WatermarkFunc callback;   // Edge callback (NULL: flag bits only)
+    void* context;                  // Passed to `callback`
+    STARB_CAPTYPE low;              // Low watermark (occupancy, bytes)
+    STARB_CAPTYPE high;             // High watermark (occupancy, bytes)
+    bool above;                     // HIGH fired, LOW not yet
+    volatile uint8_t events;        // Edges not taken yet (STARB_WATERMARK_xxx bits)
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** @brief   Initialize the STARB_Watermark instance and attach it to a ring.
+     *  @details The initial state follows the current occupancy (above when it
+     *           is at least `high`) without firing an event. The callback must
+     *           not move the indexes of the ring; typically it flags the
+     *           upstream sender. Overwriting more than `capacity - low` bytes in
+     *           one StaticRingBuf_ForceWriteItemsWithLog() call reports a LOW /
+     *           HIGH pair.
+     *
+     *  @param[out] watermark The STARB_Watermark instance to be initialized
+     *  @param[in] rbuf       The StaticRingBuf instance to observe
+     *  @param[in] low        Low watermark (0 ~ high - 1)
+     *  @param[in] high       High watermark (low + 1 ~ capacity)
+     *  @param[in] callback   Edge callback (NULL: flag bits only)
+     *  @param[in] context    Passed to `callback`
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range.
+     */
+    uint8_t STARB_Watermark_Init(STARB_Watermark* watermark, StaticRingBuf* rbuf, const STARB_CAPTYPE low,
+        const STARB_CAPTYPE high, STARB_WatermarkFunc callback, void* context);
+
+    /** @brief Detach the STARB_Watermark instance from its ring.
+     *
+     *  @param[in] watermark The STARB_Watermark instance
+     *
+     *  @retval 1    Executed successfully.
+     *  @retval 0xE1 Failed: Has empty input parameter.
+     *  @retval 0xE2 Failed: Input parameter is out of range (not attached).
+     */
+    uint8_t STARB_Watermark_Detach(STARB_Watermark* watermark);
+
+    /** @brief Check whether the ring is above the watermarks (HIGH fired, LOW not yet). */
+    bool STARB_Watermark_IsAbove(STARB_Watermark* watermark);
+
+    /** @brief Get and clear the edges that happened since the last call (STARB_WATERMARK_xxx bits). */
+    uint8_t STARB_Watermark_TakeEvents(STARB_Watermark* watermark);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_GH2025_StaticRingBuf_Watermark_H
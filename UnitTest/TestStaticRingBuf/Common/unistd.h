@@ -5,6 +5,8 @@
  * ISO C and C++ conformant named API functions
  */
 
+#if defined(_WIN32)
+
 #include <io.h> /* _access() */
 #ifndef access
 #   define access _access
@@ -42,4 +44,11 @@
 #   define strdup _strdup
 #endif
 
+#else
+
+#include <strings.h>    /* strncasecmp() */
+#include <unistd.h>
+
+#endif
+
 #endif // !_INC_COMMON_unistd_H
@@ -9,6 +9,22 @@
 #include "Common/unistd.h"
 
 #include "Verify/TS_0001.h"
+#include "Verify/TS_0002.h"
+#include "Verify/TS_0003.h"
+#include "Verify/TS_0004.h"
+#include "Verify/TS_0005.h"
+#include "Verify/TS_0006.h"
+#include "Verify/TS_0007.h"
+#include "Verify/TS_0008.h"
+#include "Verify/TS_0009.h"
+#include "Verify/TS_0010.h"
+#include "Verify/TS_0011.h"
+#include "Verify/TS_0012.h"
+#include "Verify/TS_0013.h"
+#include "Verify/TS_0014.h"
+#include "Verify/TS_0015.h"
+#include "Verify/TS_0016.h"
+#include "Verify/TS_0017.h"
 
 typedef enum
 {
@@ -23,6 +39,22 @@ int main(int argc, char* argv[])
 {
     Run_Mode run_mode = RUN_MODE_AUTO;
     CU_pSuite suite_0001 = NULL;
+    CU_pSuite suite_0002 = NULL;
+    CU_pSuite suite_0003 = NULL;
+    CU_pSuite suite_0004 = NULL;
+    CU_pSuite suite_0005 = NULL;
+    CU_pSuite suite_0006 = NULL;
+    CU_pSuite suite_0007 = NULL;
+    CU_pSuite suite_0008 = NULL;
+    CU_pSuite suite_0009 = NULL;
+    CU_pSuite suite_0010 = NULL;
+    CU_pSuite suite_0011 = NULL;
+    CU_pSuite suite_0012 = NULL;
+    CU_pSuite suite_0013 = NULL;
+    CU_pSuite suite_0014 = NULL;
+    CU_pSuite suite_0015 = NULL;
+    CU_pSuite suite_0016 = NULL;
+    CU_pSuite suite_0017 = NULL;
 
     if (argc >= 2)
     {
@@ -54,6 +86,165 @@ int main(int argc, char* argv[])
     CU_ADD_TEST(suite_0001, TC0004_STARB_TestCapBound_Write);
     CU_ADD_TEST(suite_0001, TC0005_STARB_WriteItems);
     CU_ADD_TEST(suite_0001, TC0006_STARB_TestCapBound_WriteItems);
+    CU_ADD_TEST(suite_0001, TC0007_STARB_StreamMode);
+    CU_ADD_TEST(suite_0001, TC0011_STARB_CopyKernels);
+    CU_ADD_TEST(suite_0001, TC0012_STARB_TryPushPop);
+    CU_ADD_TEST(suite_0001, TC0013_STARB_NoMirror);
+    CU_ADD_TEST(suite_0001, TC0029_STARB_Window);
+
+    /* Add a test suite to the registry: STARB_Spsc */
+    suite_0002 = CU_add_suite(TS_0002_Identifier, TS_0002_Setup, TS_0002_Cleanup);
+    if (suite_0002 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0002, TC0008_STARB_Spsc_Layout);
+    CU_ADD_TEST(suite_0002, TC0009_STARB_Spsc_WriteRead);
+    CU_ADD_TEST(suite_0002, TC0010_STARB_Spsc_Batch);
+    CU_ADD_TEST(suite_0002, TC0017_STARB_Spsc_SignalProducer);
+    CU_ADD_TEST(suite_0002, TC0028_STARB_Spsc_Snapshot);
+    CU_ADD_TEST(suite_0002, TC0034_STARB_Spsc_BatchRetry);
+    CU_ADD_TEST(suite_0002, TC0035_STARB_Spsc_Threads);
+
+    /* Add a test suite to the registry: STARB_Dma */
+    suite_0003 = CU_add_suite(TS_0003_Identifier, TS_0003_Setup, TS_0003_Cleanup);
+    if (suite_0003 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0003, TC0014_STARB_Dma_Sync);
+    CU_ADD_TEST(suite_0003, TC0015_STARB_Dma_Overrun);
+
+    /* Add a test suite to the registry: STARB_Bip */
+    suite_0004 = CU_add_suite(TS_0004_Identifier, TS_0004_Setup, TS_0004_Cleanup);
+    if (suite_0004 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0004, TC0016_STARB_Bip_Frames);
+
+    /* Add a test suite to the registry: STARB_DescRing */
+    suite_0005 = CU_add_suite(TS_0005_Identifier, TS_0005_Setup, TS_0005_Cleanup);
+    if (suite_0005 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0005, TC0018_STARB_DescRing_Messages);
+
+    /* Add a test suite to the registry: STARB_Tracker */
+    suite_0006 = CU_add_suite(TS_0006_Identifier, TS_0006_Setup, TS_0006_Cleanup);
+    if (suite_0006 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0006, TC0019_STARB_Tracker_OutOfOrder);
+
+    /* Add a test suite to the registry: STARB_Stage */
+    suite_0007 = CU_add_suite(TS_0007_Identifier, TS_0007_Setup, TS_0007_Cleanup);
+    if (suite_0007 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0007, TC0020_STARB_Stage_Ordered);
+    CU_ADD_TEST(suite_0007, TC0036_STARB_Stage_Workers);
+
+    /* Add a test suite to the registry: STARB_Table */
+    suite_0008 = CU_add_suite(TS_0008_Identifier, TS_0008_Setup, TS_0008_Cleanup);
+    if (suite_0008 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0008, TC0021_STARB_Table_Arena);
+
+    /* Add a test suite to the registry: STARB_Arena */
+    suite_0009 = CU_add_suite(TS_0009_Identifier, TS_0009_Setup, TS_0009_Cleanup);
+    if (suite_0009 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0009, TC0022_STARB_Arena_Provision);
+    CU_ADD_TEST(suite_0009, TC0023_STARB_Arena_Numa);
+
+    /* Add a test suite to the registry: STARB_Timed */
+    suite_0010 = CU_add_suite(TS_0010_Identifier, TS_0010_Setup, TS_0010_Cleanup);
+    if (suite_0010 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0010, TC0024_STARB_Timed_Window);
+
+    /* Add a test suite to the registry: STARB_Prio */
+    suite_0011 = CU_add_suite(TS_0011_Identifier, TS_0011_Setup, TS_0011_Cleanup);
+    if (suite_0011 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0011, TC0025_STARB_Prio_Lanes);
+
+    /* Add a test suite to the registry: STARB_Lz */
+    suite_0012 = CU_add_suite(TS_0012_Identifier, TS_0012_Setup, TS_0012_Cleanup);
+    if (suite_0012 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0012, TC0026_STARB_Lz_Blocks);
+
+    /* Add a test suite to the registry: STARB_Delta */
+    suite_0013 = CU_add_suite(TS_0013_Identifier, TS_0013_Setup, TS_0013_Cleanup);
+    if (suite_0013 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0013, TC0027_STARB_Delta_Samples);
+
+    /* Add a test suite to the registry: STARB_Stats */
+    suite_0014 = CU_add_suite(TS_0014_Identifier, TS_0014_Setup, TS_0014_Cleanup);
+    if (suite_0014 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0014, TC0030_STARB_Stats_Window);
+
+    /* Add a test suite to the registry: STARB_Chunk */
+    suite_0015 = CU_add_suite(TS_0015_Identifier, TS_0015_Setup, TS_0015_Cleanup);
+    if (suite_0015 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0015, TC0031_STARB_Chunk_Boundaries);
+
+    /* Add a test suite to the registry: starb::Ring */
+    suite_0016 = CU_add_suite(TS_0016_Identifier, TS_0016_Setup, TS_0016_Cleanup);
+    if (suite_0016 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0016, TC0032_STARB_Coro_Streams);
+    CU_ADD_TEST(suite_0016, TC0037_STARB_Coro_Bypass);
+
+    /* Add a test suite to the registry: STARB_Watermark */
+    suite_0017 = CU_add_suite(TS_0017_Identifier, TS_0017_Setup, TS_0017_Cleanup);
+    if (suite_0017 == NULL)
+    {
+        goto EXIT;
+    }
+
+    CU_ADD_TEST(suite_0017, TC0033_STARB_Watermark_Edges);
 
     switch (run_mode)
     {
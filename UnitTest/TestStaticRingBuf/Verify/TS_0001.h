@@ -15,6 +15,11 @@ extern "C" {
     void TC0004_STARB_TestCapBound_Write(void);
     void TC0005_STARB_WriteItems(void);
     void TC0006_STARB_TestCapBound_WriteItems(void);
+    void TC0007_STARB_StreamMode(void);
+    void TC0011_STARB_CopyKernels(void);
+    void TC0012_STARB_TryPushPop(void);
+    void TC0013_STARB_NoMirror(void);
+    void TC0029_STARB_Window(void);
 
 #ifdef __cplusplus
 } // ! extern "C"
@@ -3,6 +3,8 @@
 #include "CUnit/CUnit.h"
 #include "TS_0001.h"
 #include "StaticRingBuf.h"
+#include "StaticRingBuf_Inline.h"
+#include "Common/memcopy.h"
 #include "TS_0001_TestData.h"
 
 /** @par Private (Static) data declaration
@@ -11,11 +13,15 @@
 static byte STOBUF[2 * RB_LENGTH] = { 0 };  // StaticRingBuf storage buffer
 static byte ReadBuf[RB_LENGTH] = { 0 };     // Read output buffer
 static byte MAXBUF[2 * UINT16_MAX] = { 0 }; // StaticRingBuf storage buffer with maxium double-size.
+static byte BULKBUF[UINT16_MAX] = { 0 };    // Bulk source / destination buffer.
+static STARB_Lostdata LostLog[2] = { 0 };   // Lost data reported by the log callback
+static uint8_t LostLogCount = 0;            // Count of log callback invocations
 
 /** @par Private (Static) functions declaration
  */
 
 static void Verify_STARB_Init(StaticRingBuf* const rbuf, const STARB_CAPTYPE _capacity);
+static void Log_STARB_Lostdata(STARB_Lostdata* log);
 
 /** @par Public functions implementation: Test Suite
  */
@@ -600,6 +606,408 @@ EXIT:
     return;
 }
 
+void TC0007_STARB_StreamMode(void)
+{
+    StaticRingBuf rbuf = { 0 };
+    STARB_CAPTYPE wcap, rcap;
+
+    const STARB_CAPTYPE Capacity = 3 * STARB_STREAM_THRESHOLD;
+    const STARB_CAPTYPE Count = 2 * STARB_STREAM_THRESHOLD + 3;
+
+    uint8_t rc = StaticRingBuf_Init(&rbuf, 2 * (STARB_STOSZTP)Capacity, MAXBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    Verify_STARB_Init(&rbuf, Capacity);
+
+    rc = StaticRingBuf_SetMode(&rbuf, 0x80);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(rbuf.mode, STARB_MODE_DEFAULT);
+
+    rc = StaticRingBuf_SetMode(&rbuf, STARB_MODE_STREAM);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(rbuf.mode, STARB_MODE_STREAM);
+
+    for (size_t idx = 0; idx < Count; idx++)
+    {
+        BULKBUF[idx] = (byte)(idx * 7 + 1);
+    }
+
+    // Streamed write without wrap (odd start offset)
+
+    rc = StaticRingBuf_Write(&rbuf, 0xAA);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_WriteItems(&rbuf, BULKBUF, Count);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(rbuf.wpos, Count + 1);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 0);
+    CU_ASSERT(memcmp(rbuf.buffer + 1, BULKBUF, Count) == 0);
+    CU_ASSERT(memcmp(rbuf.buffer + Capacity + 1, BULKBUF, Count) == 0);
+
+    rc = StaticRingBuf_Forward(&rbuf, Count + 1);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    // Streamed write with wrap
+
+    rc = StaticRingBuf_WriteItems(&rbuf, BULKBUF, Count);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    if (rc != STARB_OK)
+    {
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(rbuf.wpos, 2 * Count + 1 - Capacity);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 1);
+    wcap = StaticRingBuf_GetWriteCapacity(&rbuf);
+    rcap = StaticRingBuf_GetReadCapacity(&rbuf);
+    CU_ASSERT_EQUAL(wcap, Capacity - Count);
+    CU_ASSERT_EQUAL(rcap, Count);
+
+    memset(MAXBUF + 2 * (size_t)Capacity, 0, Count);
+    rc = StaticRingBuf_ReadItems(&rbuf, MAXBUF + 2 * (size_t)Capacity, Count);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(MAXBUF + 2 * (size_t)Capacity, BULKBUF, Count) == 0);
+    CU_ASSERT(memcmp(rbuf.buffer, rbuf.buffer + Capacity, rbuf.wpos) == 0);
+
+EXIT:
+    return;
+}
+
+void TC0011_STARB_CopyKernels(void)
+{
+    StaticRingBuf rbuf = { 0 };
+    byte elem = 0;
+    size_t count, offset, idx;
+    size_t failures = 0;
+
+    const STARB_CAPTYPE Capacity = 1000;
+    byte* dstbuf = MAXBUF + 4 * (size_t)Capacity;
+
+    for (idx = 0; idx < 1024; idx++)
+    {
+        BULKBUF[idx] = (byte)(idx * 13 + 5);
+    }
+
+    // Every size class boundary, with misaligned source and destination
+
+    for (count = 0; count <= STARB_MEMCOPY_INLINE_MAX + 40; count++)
+    {
+        for (offset = 0; offset < 4; offset++)
+        {
+            memset(dstbuf, 0xEE, count + 16);
+            STARB_MemCopy(dstbuf + offset, BULKBUF + 3 - offset, count);
+
+            if (memcmp(dstbuf + offset, BULKBUF + 3 - offset, count) != 0)
+            {
+                failures++;
+            }
+            for (idx = 0; idx < offset; idx++)
+            {
+                failures += (dstbuf[idx] != 0xEE) ? 1 : 0;
+            }
+            for (idx = offset + count; idx < count + 16; idx++)
+            {
+                failures += (dstbuf[idx] != 0xEE) ? 1 : 0;
+            }
+        }
+    }
+    CU_ASSERT_EQUAL(failures, 0);
+
+    // Round trip through the ring with varied sizes across the wrap point
+
+    uint8_t rc = StaticRingBuf_Init(&rbuf, 2 * (STARB_STOSZTP)Capacity, MAXBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    for (count = 1; count <= 300; count += 7)
+    {
+        rc = StaticRingBuf_WriteItems(&rbuf, BULKBUF + count, (STARB_CAPTYPE)count);
+        if (rc != STARB_OK)
+        {
+            CU_ASSERT_EQUAL(rc, STARB_OK);
+            goto EXIT;
+        }
+
+        rc = StaticRingBuf_PeekItems(&rbuf, dstbuf, (STARB_CAPTYPE)count);
+        failures += (rc != STARB_OK || memcmp(dstbuf, BULKBUF + count, count) != 0) ? 1 : 0;
+
+        rc = StaticRingBuf_Read(&rbuf, &elem);
+        failures += (rc != STARB_OK || elem != BULKBUF[count]) ? 1 : 0;
+
+        rc = StaticRingBuf_ReadItems(&rbuf, dstbuf, (STARB_CAPTYPE)(count - 1));
+        failures += (rc != STARB_OK || memcmp(dstbuf, BULKBUF + count + 1, count - 1) != 0) ? 1 : 0;
+    }
+    CU_ASSERT_EQUAL(failures, 0);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&rbuf), 0);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 0);
+    CU_ASSERT(memcmp(rbuf.buffer, rbuf.buffer + Capacity, Capacity) == 0);
+
+    rc = StaticRingBuf_Read(&rbuf, &elem);
+    CU_ASSERT_EQUAL(rc, STARB_NOENOUGHDAT);
+
+EXIT:
+    return;
+}
+
+void TC0012_STARB_TryPushPop(void)
+{
+    StaticRingBuf rbuf = { 0 };
+    byte* src = Get_ByteArray0();
+    byte elem = 0;
+    STARB_CAPTYPE count;
+
+    uint8_t rc = StaticRingBuf_Init(&rbuf, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    Verify_STARB_Init(&rbuf, RB_LENGTH);
+
+    CU_ASSERT_EQUAL(StaticRingBuf_TryPopByte(&rbuf, &elem), 0);
+
+    // Partial push: only 10 of 12 bytes fit
+
+    count = StaticRingBuf_TryPush(&rbuf, &src[0], 12);
+    CU_ASSERT_EQUAL(count, RB_LENGTH);
+    CU_ASSERT_EQUAL(rbuf.wpos, 0);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 1);
+    CU_ASSERT_EQUAL(StaticRingBuf_TryPushByte(&rbuf, src[10]), 0);
+
+    count = StaticRingBuf_TryPop(&rbuf, ReadBuf, 6);
+    CU_ASSERT_EQUAL(count, 6);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 6) == 0);
+    CU_ASSERT_EQUAL(rbuf.rpos, 6);
+
+    // Push across the wrap point, then pop everything (partial pop)
+
+    count = StaticRingBuf_TryPush(&rbuf, &src[10], 6);
+    CU_ASSERT_EQUAL(count, 6);
+    CU_ASSERT_EQUAL(rbuf.wpos, 6);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&rbuf), RB_LENGTH);
+    CU_ASSERT(memcmp(STOBUF, STOBUF + RB_LENGTH, RB_LENGTH) == 0);
+
+    count = StaticRingBuf_TryPop(&rbuf, ReadBuf, RB_LENGTH + 5);
+    CU_ASSERT_EQUAL(count, RB_LENGTH);
+    CU_ASSERT(memcmp(ReadBuf, &src[6], RB_LENGTH) == 0);
+    CU_ASSERT_EQUAL(rbuf.rpos, 6);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 0);
+
+    // Unchecked and checked API share the same state
+
+    CU_ASSERT_EQUAL(StaticRingBuf_TryPushByte(&rbuf, src[20]), 1);
+    rc = StaticRingBuf_Read(&rbuf, &elem);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(elem, src[20]);
+
+    // Non-default mode falls back to the checked API
+
+    rc = StaticRingBuf_SetMode(&rbuf, STARB_MODE_STREAM);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    count = StaticRingBuf_TryPush(&rbuf, &src[0], 8);
+    CU_ASSERT_EQUAL(count, 8);
+    CU_ASSERT_EQUAL(StaticRingBuf_TryPopByte(&rbuf, &elem), 1);
+    CU_ASSERT_EQUAL(elem, src[0]);
+    count = StaticRingBuf_TryPop(&rbuf, ReadBuf, 20);
+    CU_ASSERT_EQUAL(count, 7);
+    CU_ASSERT(memcmp(ReadBuf, &src[1], 7) == 0);
+
+EXIT:
+    return;
+}
+
+void TC0013_STARB_NoMirror(void)
+{
+    StaticRingBuf rbuf = { 0 };
+    byte* src = Get_ByteArray0();
+    STARB_Span spans[2];
+    STARB_Lostdata lost = { 0 };
+
+    memset(STOBUF, 0xEE, sizeof(STOBUF));
+
+    uint8_t rc = StaticRingBuf_InitMode(&rbuf, RB_LENGTH, STOBUF, STARB_MODE_NOMIRROR | 0x40);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = StaticRingBuf_InitMode(&rbuf, RB_LENGTH, STOBUF, STARB_MODE_NOMIRROR);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    Verify_STARB_Init(&rbuf, RB_LENGTH);
+
+    rc = StaticRingBuf_SetMode(&rbuf, STARB_MODE_DEFAULT);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = StaticRingBuf_SetMode(&rbuf, STARB_MODE_NOMIRROR | STARB_MODE_STREAM);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadSpans(&rbuf, spans), 0);
+
+    // Write 7 items src[0..6], read 5 items
+
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[0], 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_ReadItems(&rbuf, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 5) == 0);
+
+    // Write 6 items src[7..12] across the end, then 1 byte
+
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[7], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_Write(&rbuf, src[13]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(rbuf.wpos, 4);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 1);
+    CU_ASSERT(memcmp(STOBUF, &src[10], 4) == 0);
+
+    // Storage beyond the capacity is never touched
+
+    for (uint8_t idx = RB_LENGTH; idx < 2 * RB_LENGTH; idx++)
+    {
+        CU_ASSERT_EQUAL(STOBUF[idx], 0xEE);
+    }
+
+    // Zero-copy: 2 spans
+
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadSpans(&rbuf, spans), 2);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, STOBUF + 5);
+    CU_ASSERT_EQUAL(spans[0].len, 5);
+    CU_ASSERT_PTR_EQUAL(spans[1].ptr, STOBUF);
+    CU_ASSERT_EQUAL(spans[1].len, 4);
+
+    // Peek and read across the end
+
+    rc = StaticRingBuf_PeekItems(&rbuf, ReadBuf, 9);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[5], 9) == 0);
+
+    rc = StaticRingBuf_ReadItems(&rbuf, ReadBuf, 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[5], 7) == 0);
+    CU_ASSERT_EQUAL(rbuf.rpos, 2);
+    CU_ASSERT_EQUAL(rbuf.flag.cycle, 0);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadSpans(&rbuf, spans), 1);
+    CU_ASSERT_EQUAL(spans[0].len, 2);
+
+    // Forced overwrite of wrapped data is logged in two pieces
+
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[14], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_Forward(&rbuf, 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(rbuf.rpos, 9);
+
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[0], 8);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetWriteCapacity(&rbuf), 1);
+
+    LostLogCount = 0;
+    rc = StaticRingBuf_ForceWriteItemsWithLog(&rbuf, &src[8], 3, &lost, Log_STARB_Lostdata);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(LostLogCount, 2);
+    CU_ASSERT_EQUAL(LostLog[0].pos, 9);
+    CU_ASSERT_EQUAL(LostLog[0].count, 1);
+    CU_ASSERT_EQUAL(LostLog[1].pos, 0);
+    CU_ASSERT_EQUAL(LostLog[1].count, 1);
+    CU_ASSERT_EQUAL(rbuf.rpos, 1);
+
+    rc = StaticRingBuf_ReadItems(&rbuf, ReadBuf, RB_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[1], 10) == 0);
+
+EXIT:
+    return;
+}
+
+void TC0029_STARB_Window(void)
+{
+    StaticRingBuf rbuf = { 0 };
+    byte* src = Get_ByteArray0();
+    byte zeros[RB_LENGTH] = { 0 };
+    byte* window = NULL;
+
+    memset(STOBUF, 0, sizeof(STOBUF));
+
+    uint8_t rc = StaticRingBuf_Init(&rbuf, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_PTR_NULL(StaticRingBuf_GetWindow(&rbuf, 0));
+    CU_ASSERT_PTR_NULL(StaticRingBuf_GetWindow(&rbuf, RB_LENGTH + 1));
+    CU_ASSERT_PTR_NULL(StaticRingBuf_GetWindow(NULL, 1));
+
+    // Write 6 items src[0..5]: the history before them reads as zeros
+
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[0], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    window = StaticRingBuf_GetWindow(&rbuf, 4);
+    CU_ASSERT(window != NULL && memcmp(window, &src[2], 4) == 0);
+    window = StaticRingBuf_GetWindow(&rbuf, RB_LENGTH);
+    CU_ASSERT(window != NULL && memcmp(window, zeros, 4) == 0 && memcmp(window + 4, &src[0], 6) == 0);
+
+    // Consuming does not move the window; wrapping keeps it contiguous
+
+    rc = StaticRingBuf_ReadItems(&rbuf, ReadBuf, 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(StaticRingBuf_GetWindow(&rbuf, 4), window + 6);
+
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[6], 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_Write(&rbuf, src[13]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(rbuf.wpos, 4);
+    window = StaticRingBuf_GetWindow(&rbuf, RB_LENGTH);
+    CU_ASSERT_PTR_EQUAL(window, STOBUF + 4);
+    CU_ASSERT(memcmp(window, &src[4], RB_LENGTH) == 0);
+
+    // Without the mirror only unwrapped windows are available
+
+    rc = StaticRingBuf_InitMode(&rbuf, RB_LENGTH, STOBUF, STARB_MODE_NOMIRROR);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[0], 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    window = StaticRingBuf_GetWindow(&rbuf, 5);
+    CU_ASSERT_PTR_EQUAL(window, STOBUF + 2);
+    CU_ASSERT(memcmp(window, &src[2], 5) == 0);
+
+    rc = StaticRingBuf_Forward(&rbuf, 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[7], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    window = StaticRingBuf_GetWindow(&rbuf, 3);
+    CU_ASSERT(window != NULL && memcmp(window, &src[10], 3) == 0);
+    CU_ASSERT_PTR_NULL(StaticRingBuf_GetWindow(&rbuf, 4));
+
+    // A write ending exactly at the end of the storage leaves wpos at 0
+
+    rc = StaticRingBuf_InitMode(&rbuf, RB_LENGTH, STOBUF, STARB_MODE_NOMIRROR);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_WriteItems(&rbuf, &src[0], RB_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(rbuf.wpos, 0);
+    window = StaticRingBuf_GetWindow(&rbuf, 4);
+    CU_ASSERT_PTR_EQUAL(window, STOBUF + RB_LENGTH - 4);
+    CU_ASSERT(window != NULL && memcmp(window, &src[RB_LENGTH - 4], 4) == 0);
+    window = StaticRingBuf_GetWindow(&rbuf, RB_LENGTH);
+    CU_ASSERT_PTR_EQUAL(window, STOBUF);
+    CU_ASSERT(window != NULL && memcmp(window, &src[0], RB_LENGTH) == 0);
+
+EXIT:
+    return;
+}
+
 /** @par Private (Static) functions implementation
  */
 
@@ -617,3 +1025,12 @@ static void Verify_STARB_Init(StaticRingBuf* const rbuf, const STARB_CAPTYPE _ca
     STARB_CAPTYPE rcap = StaticRingBuf_GetReadCapacity(rbuf);
     CU_ASSERT_EQUAL(rcap, 0);
 }
+
+static void Log_STARB_Lostdata(STARB_Lostdata* log)
+{
+    if (LostLogCount < 2)
+    {
+        LostLog[LostLogCount] = *log;
+    }
+    LostLogCount++;
+}
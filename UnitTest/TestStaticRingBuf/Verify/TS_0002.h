@@ -0,0 +1,25 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0002_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0002_H
+
+#define TS_0002_Identifier "TS_0002: STARB_Spsc"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0002_Setup(void);
+    int TS_0002_Cleanup(void);
+
+    void TC0008_STARB_Spsc_Layout(void);
+    void TC0009_STARB_Spsc_WriteRead(void);
+    void TC0010_STARB_Spsc_Batch(void);
+    void TC0017_STARB_Spsc_SignalProducer(void);
+    void TC0028_STARB_Spsc_Snapshot(void);
+    void TC0034_STARB_Spsc_BatchRetry(void);
+    void TC0035_STARB_Spsc_Threads(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0002_H
@@ -0,0 +1,730 @@
+﻿#if !defined(_WIN32) && !defined(_XOPEN_SOURCE)
+#define _XOPEN_SOURCE 700   /* sigaction(), setitimer(), nanosleep() */
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0002.h"
+#include "StaticRingBuf_Spsc.h"
+#include "TS_0001_TestData.h"
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_ALIGNAS(STARB_CACHELINE) STARB_Spsc RING;   // SPSC ring instance
+static byte STOBUF[2 * RB_LENGTH] = { 0 };              // STARB_Spsc storage buffer
+static byte ReadBuf[RB_LENGTH] = { 0 };                 // Read output buffer
+
+#if !defined(_WIN32)
+#define SIG_FRAME       5                               // Bytes written per SIGALRM
+#define SIG_TARGET      20000                           // Bytes the consumer thread verifies
+
+static STARB_ALIGNAS(STARB_CACHELINE) STARB_Spsc SIGRING;   // Ring fed from the signal handler
+static byte SIGBUF[2 * STARB_SPSC_ISR_MAXWRITE] = { 0 };    // SIGRING storage buffer
+static byte SigSeq = 0;                                 // [Handler] Next sequence byte
+static volatile uint32_t SigWrites = 0;                 // [Handler] Successful writes
+static volatile uint32_t SigConsumed = 0;               // [Consumer] Bytes read
+static volatile uint32_t SigErrors = 0;                 // [Consumer] Sequence errors
+static volatile sig_atomic_t SigDone = 0;               // [Consumer] Target reached
+static volatile sig_atomic_t SigStop = 0;               // [Main] Give up waiting
+
+static void Sig_Producer(int signo);
+static void* Sig_Consumer(void* arg);
+
+#define SNAP_LENGTH     64                              // SNAPRING capacity
+#define SNAP_COUNT      48                              // Bytes per snapshot
+#define SNAP_TARGET     20000                           // Consistent snapshots to take
+#define SNAP_ATTEMPTS   2000000                         // Snapshot attempts at most
+
+static STARB_ALIGNAS(STARB_CACHELINE) STARB_Spsc SNAPRING;  // Ring watched by snapshots
+static byte SNAPBUF[2 * SNAP_LENGTH] = { 0 };           // SNAPRING storage buffer
+static volatile uint32_t SnapStop = 0;                  // [Main] Snapshots done
+
+static void* Snap_Worker(void* arg);
+
+#define THR_LENGTH      61                              // THRRING capacity (odd: laps wrap unevenly)
+#define THR_TOTAL       100000                          // Bytes streamed per run
+#define THR_IDLE_LIMIT  200000000u                      // Empty polls before the consumer gives up
+
+static STARB_ALIGNAS(STARB_CACHELINE) STARB_Spsc THRRING;   // Ring shared by two threads
+static byte THRBUF[2 * THR_LENGTH] = { 0 };             // THRRING storage buffer
+static volatile uint32_t ThrStop = 0;                   // [Main] Consumer done or gave up
+
+static void* Thr_Producer(void* arg);
+static byte Thr_Byte(const uint32_t index);
+#endif
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0002_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0002_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0008_STARB_Spsc_Layout(void)
+{
+    size_t shared = offsetof(STARB_Spsc, buffer);
+    size_t producer = offsetof(STARB_Spsc, wpos);
+    size_t consumer = offsetof(STARB_Spsc, rpos);
+
+    CU_ASSERT(producer - shared >= STARB_CACHELINE);
+    CU_ASSERT(consumer - producer >= STARB_CACHELINE);
+    CU_ASSERT_EQUAL(offsetof(STARB_Spsc, rpos_cache) / STARB_CACHELINE, producer / STARB_CACHELINE);
+    CU_ASSERT_EQUAL(offsetof(STARB_Spsc, wpos_cache) / STARB_CACHELINE, consumer / STARB_CACHELINE);
+    CU_ASSERT_EQUAL(sizeof(STARB_Spsc), 3 * STARB_CACHELINE);
+    CU_ASSERT_EQUAL((uintptr_t)&RING % STARB_CACHELINE, 0);
+}
+
+void TC0009_STARB_Spsc_WriteRead(void)
+{
+    byte* src = Get_ByteArray0();
+    byte elem = 0;
+
+    uint8_t rc = STARB_Spsc_Init(&RING, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(RING.capacity, RB_LENGTH);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetWriteCapacity(&RING), RB_LENGTH);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), 0);
+
+    rc = STARB_Spsc_Read(&RING, &elem);
+    CU_ASSERT_EQUAL(rc, STARB_NOENOUGHDAT);
+    rc = STARB_Spsc_WriteItems(&RING, src, RB_LENGTH + 1);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+
+    // Write 7 items src[0..6], read 5 items
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[0], 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 7);
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 5) == 0);
+    CU_ASSERT_EQUAL(RING.rpos, 5);
+    CU_ASSERT_EQUAL(RING.wpos_cache, 7);
+
+    // Producer still sees the stale `rpos_cache` until it runs short of space
+
+    CU_ASSERT_EQUAL(RING.rpos_cache, 0);
+    rc = STARB_Spsc_WriteItems(&RING, &src[7], 3);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.rpos_cache, 0);
+
+    // Wrap: write 5 items src[10..14]; the cached `rpos` gets refreshed
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[10], 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.rpos_cache, 5);
+    CU_ASSERT_EQUAL(RING.wpos, 15);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetWriteCapacity(&RING), 0);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), RB_LENGTH);
+
+    rc = STARB_Spsc_Write(&RING, src[15]);
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+
+    for (uint8_t idx = 0; idx < RB_LENGTH; idx++)
+    {
+        CU_ASSERT_EQUAL(STOBUF[idx], STOBUF[RB_LENGTH + idx]);
+    }
+
+    // Zero-copy read across the wrap point through the mirror
+
+    CU_ASSERT(memcmp(STARB_Spsc_GetReadPtr(&RING), &src[5], RB_LENGTH) == 0);
+
+    rc = STARB_Spsc_Read(&RING, &elem);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(elem, src[5]);
+
+    rc = STARB_Spsc_Forward(&RING, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    rc = STARB_Spsc_PeekItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[10], 5) == 0);
+    CU_ASSERT_EQUAL(RING.rpos, 10);
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 6);
+    CU_ASSERT_EQUAL(rc, STARB_NOENOUGHDAT);
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[10], 5) == 0);
+    CU_ASSERT_EQUAL(RING.rpos, 15);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), 0);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetWriteCapacity(&RING), RB_LENGTH);
+
+    // Index wraps at 2 * capacity
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[0], 8);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 3);
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 8);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 8) == 0);
+    CU_ASSERT_EQUAL(RING.rpos, 3);
+
+EXIT:
+    return;
+}
+
+void TC0010_STARB_Spsc_Batch(void)
+{
+    byte* src = Get_ByteArray0();
+
+    uint8_t rc = STARB_Spsc_Init(&RING, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    rc = STARB_Spsc_SetBatch(&RING, RB_LENGTH + 1);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Spsc_SetBatch(&RING, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    // 3 bytes stay private to the producer
+
+    for (uint8_t idx = 0; idx < 3; idx++)
+    {
+        rc = STARB_Spsc_Write(&RING, src[idx]);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+    }
+
+    CU_ASSERT_EQUAL(RING.wpos, 0);
+    CU_ASSERT_EQUAL(RING.wpos_local, 3);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), 0);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetWriteCapacity(&RING), RB_LENGTH - 3);
+
+    // The 4th byte reaches the batch size: published
+
+    rc = STARB_Spsc_Write(&RING, src[3]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 4);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), 4);
+
+    // Explicit flush
+
+    rc = STARB_Spsc_Write(&RING, src[4]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 4);
+    rc = STARB_Spsc_Flush(&RING);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 5);
+
+    // Nearly full: fewer than `batch` bytes of space left, published at once
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[5], 2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 7);
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 7) == 0);
+
+    // Stale `rpos_cache` still looks nearly full: published at once
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[7], 3);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.rpos_cache, 0);
+    CU_ASSERT_EQUAL(RING.wpos, 10);
+
+    // `rpos_cache` refreshed on shortage: batching resumes
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[10], 2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.rpos_cache, 7);
+    CU_ASSERT_EQUAL(RING.wpos, 10);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), 3);
+
+    rc = STARB_Spsc_Flush(&RING);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 12);
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[7], 5) == 0);
+
+EXIT:
+    return;
+}
+
+void TC0017_STARB_Spsc_SignalProducer(void)
+{
+    byte* src = Get_ByteArray0();
+
+    uint8_t rc = STARB_Spsc_Init(&RING, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    // Published at once, whatever the batch size
+
+    rc = STARB_Spsc_SetBatch(&RING, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_WriteIsr(&RING, src[0]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_WriteItemsIsr(&RING, &src[1], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 7);
+    rc = STARB_Spsc_WriteItemsIsr(&RING, &src[7], 4);
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_WriteItemsIsr(&RING, &src[7], 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 14);
+    CU_ASSERT(memcmp(STARB_Spsc_GetReadPtr(&RING), &src[5], 9) == 0);
+
+#if !defined(_WIN32)
+    // Stress: SIGALRM handler produces, a thread consumes. SIGALRM is blocked
+    // everywhere but in the consumer thread, so every signal interrupts a read.
+
+    struct sigaction action;
+    struct sigaction previous;
+    struct itimerval timer;
+    struct timespec pause = { 0, 10 * 1000 * 1000 };
+    sigset_t mask, oldmask;
+    pthread_t consumer;
+
+    rc = STARB_Spsc_Init(&SIGRING, sizeof(SIGBUF), SIGBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_WriteItemsIsr(&SIGRING, SIGBUF, STARB_SPSC_ISR_MAXWRITE + 1);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+
+    SigSeq = 0;
+    SigWrites = 0;
+    SigConsumed = 0;
+    SigErrors = 0;
+    SigDone = 0;
+    SigStop = 0;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = Sig_Producer;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &action, &previous);
+
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGALRM);
+    pthread_sigmask(SIG_BLOCK, &mask, &oldmask);
+
+    if (pthread_create(&consumer, NULL, Sig_Consumer, NULL) != 0)
+    {
+        CU_FAIL("pthread_create");
+    }
+    else
+    {
+        memset(&timer, 0, sizeof(timer));
+        timer.it_interval.tv_usec = 20;
+        timer.it_value.tv_usec = 20;
+        setitimer(ITIMER_REAL, &timer, NULL);
+
+        for (uint16_t wait = 0; wait < 1000 && !SigDone; wait++)
+        {
+            nanosleep(&pause, NULL);
+        }
+        SigStop = 1;
+        pthread_join(consumer, NULL);
+
+        memset(&timer, 0, sizeof(timer));
+        setitimer(ITIMER_REAL, &timer, NULL);
+    }
+
+    /* Discard a signal still pending on the blocked main thread before restoring. */
+    action.sa_handler = SIG_IGN;
+    sigaction(SIGALRM, &action, NULL);
+    pthread_sigmask(SIG_SETMASK, &oldmask, NULL);
+    sigaction(SIGALRM, &previous, NULL);
+
+    CU_ASSERT(SigWrites > 0);
+    CU_ASSERT(SigConsumed >= SIG_TARGET);
+    CU_ASSERT_EQUAL(SigErrors, 0);
+#endif
+
+EXIT:
+    return;
+}
+
+void TC0028_STARB_Spsc_Snapshot(void)
+{
+    byte* src = Get_ByteArray0();
+
+    uint8_t rc = STARB_Spsc_Init(&RING, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    // Opt-in: without it writes leave `claim` alone and snapshots are refused
+
+    rc = STARB_Spsc_Write(&RING, src[0]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.claim, 0);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 1), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Spsc_EnableSnapshot(NULL), STARB_PARAM_NULL);
+
+    rc = STARB_Spsc_Init(&RING, 2 * RB_LENGTH, STOBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Spsc_EnableSnapshot(&RING), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 1), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, RB_LENGTH + 1), STARB_PARAMOUTRANGE);
+
+    // The tail includes bytes the consumer has already read
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[0], 7);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 7), STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 7) == 0);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 8), STARB_NOENOUGHDAT);
+
+    // Across the wrap, contiguous through the mirror
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[7], 8);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, RB_LENGTH), STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[5], RB_LENGTH) == 0);
+    CU_ASSERT_EQUAL(RING.rpos, 5);
+
+    // Unpublished (batched) bytes are not part of the snapshot until flushed
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_SetBatch(&RING, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_Write(&RING, src[15]);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 3), STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[12], 3) == 0);
+    STARB_Spsc_Flush(&RING);
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 3), STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[13], 3) == 0);
+
+    // A producer that has claimed the whole ring may be overwriting the tail
+
+    RING.claim += RB_LENGTH;
+    CU_ASSERT_EQUAL(STARB_Spsc_Snapshot(&RING, ReadBuf, 1), STARB_DATAINVALID);
+    RING.claim -= RB_LENGTH;
+
+#if !defined(_WIN32)
+    // Stress: a worker thread produces and consumes a byte sequence, the main
+    // thread snapshots it. Every snapshot reported consistent must be in sequence.
+
+    byte snap[SNAP_COUNT];
+    uint32_t consistent = 0;
+    uint32_t errors = 0;
+    pthread_t worker;
+
+    rc = STARB_Spsc_Init(&SNAPRING, sizeof(SNAPBUF), SNAPBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Spsc_EnableSnapshot(&SNAPRING);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    SnapStop = 0;
+
+    if (pthread_create(&worker, NULL, Snap_Worker, NULL) != 0)
+    {
+        CU_FAIL("pthread_create");
+    }
+    else
+    {
+        for (uint32_t attempt = 0; attempt < SNAP_ATTEMPTS && consistent < SNAP_TARGET; attempt++)
+        {
+            if (STARB_Spsc_Snapshot(&SNAPRING, snap, SNAP_COUNT) != STARB_OK)
+            {
+                continue;
+            }
+
+            consistent++;
+            for (uint8_t idx = 1; idx < SNAP_COUNT; idx++)
+            {
+                if (snap[idx] != (byte)(snap[idx - 1] + 1))
+                {
+                    errors++;
+                    break;
+                }
+            }
+        }
+        SnapStop = 1;
+        pthread_join(worker, NULL);
+    }
+
+    CU_ASSERT(consistent > 0);
+    CU_ASSERT_EQUAL(errors, 0);
+#endif
+
+EXIT:
+    return;
+}
+
+void TC0034_STARB_Spsc_BatchRetry(void)
+{
+    byte* src = Get_ByteArray0();
+
+    uint8_t rc = STARB_Spsc_Init(&RING, 2 * RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    rc = STARB_Spsc_SetBatch(&RING, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    // 3 bytes pending, plenty of space left: not published yet
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[0], 3);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RING.wpos, 0);
+
+    // A write larger than the space left fails, and publishes the pending bytes
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[3], RB_LENGTH - 2);
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+    CU_ASSERT_EQUAL(RING.wpos, 3);
+    CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&RING), 3);
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[3], RB_LENGTH - 2);
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+
+    // Once the consumer drains them, the retry succeeds
+
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, 3);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[0], 3) == 0);
+
+    rc = STARB_Spsc_WriteItems(&RING, &src[3], RB_LENGTH - 2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    STARB_Spsc_Flush(&RING);
+    rc = STARB_Spsc_ReadItems(&RING, ReadBuf, RB_LENGTH - 2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(ReadBuf, &src[3], RB_LENGTH - 2) == 0);
+
+EXIT:
+    return;
+}
+
+void TC0035_STARB_Spsc_Threads(void)
+{
+#if !defined(_WIN32)
+    // A producer thread streams a sequence with Write / WriteItems, the main
+    // thread reads it with Read / ReadItems: batching off, then on.
+
+    static const STARB_CAPTYPE batches[2] = { 0, 8 };
+    byte buf[16];
+    pthread_t producer;
+
+    for (uint8_t run = 0; run < 2; run++)
+    {
+        uint32_t consumed = 0;
+        uint32_t errors = 0;
+        uint32_t idle = 0;
+
+        uint8_t rc = STARB_Spsc_Init(&THRRING, sizeof(THRBUF), THRBUF);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        rc = STARB_Spsc_SetBatch(&THRRING, batches[run]);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        ThrStop = 0;
+
+        if (pthread_create(&producer, NULL, Thr_Producer, NULL) != 0)
+        {
+            CU_FAIL("pthread_create");
+            break;
+        }
+
+        while (consumed < THR_TOTAL && idle < THR_IDLE_LIMIT)
+        {
+            STARB_CAPTYPE avail = STARB_Spsc_GetReadCapacity(&THRRING);
+            if (avail <= 0)
+            {
+                idle++;
+                sched_yield();
+                continue;
+            }
+
+            /* Every 5th read takes a single byte */
+            avail = (avail > sizeof(buf)) ? sizeof(buf) : avail;
+            avail = (consumed % 5 == 0) ? 1 : avail;
+            rc = (avail == 1) ? STARB_Spsc_Read(&THRRING, buf) : STARB_Spsc_ReadItems(&THRRING, buf, avail);
+            if (rc != STARB_OK)
+            {
+                errors++;
+                continue;
+            }
+
+            for (STARB_CAPTYPE idx = 0; idx < avail; idx++)
+            {
+                errors += buf[idx] != Thr_Byte(consumed + idx);
+            }
+            consumed += avail;
+            idle = 0;
+        }
+
+        ThrStop = 1;
+        pthread_join(producer, NULL);
+
+        CU_ASSERT_EQUAL(consumed, THR_TOTAL);
+        CU_ASSERT_EQUAL(errors, 0);
+        CU_ASSERT_EQUAL(STARB_Spsc_GetReadCapacity(&THRRING), 0);
+    }
+#endif
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+#if !defined(_WIN32)
+/** @brief SIGALRM handler: the one and only producer of SIGRING. */
+static void Sig_Producer(int signo)
+{
+    byte frame[SIG_FRAME];
+
+    (void)signo;
+    for (uint8_t idx = 0; idx < SIG_FRAME; idx++)
+    {
+        frame[idx] = (byte)(SigSeq + idx);
+    }
+
+    if (STARB_Spsc_WriteItemsIsr(&SIGRING, frame, SIG_FRAME) == STARB_OK)
+    {
+        SigSeq += SIG_FRAME;
+        SigWrites++;
+    }
+}
+
+/** @brief Consumer thread: read and check the byte sequence until SIG_TARGET bytes. */
+static void* Sig_Consumer(void* arg)
+{
+    sigset_t mask;
+    byte buf[16];
+    byte expect = 0;
+    uint32_t count = 0;
+
+    (void)arg;
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGALRM);
+    pthread_sigmask(SIG_UNBLOCK, &mask, NULL);
+
+    while (count < SIG_TARGET && !SigStop)
+    {
+        STARB_CAPTYPE avail = STARB_Spsc_GetReadCapacity(&SIGRING);
+        if (avail > sizeof(buf))
+        {
+            avail = sizeof(buf);
+        }
+        if (avail <= 0)
+        {
+            continue;
+        }
+
+        if (STARB_Spsc_ReadItems(&SIGRING, buf, avail) != STARB_OK)
+        {
+            SigErrors++;
+            continue;
+        }
+        for (STARB_CAPTYPE idx = 0; idx < avail; idx++)
+        {
+            if (buf[idx] != expect++)
+            {
+                SigErrors++;
+            }
+        }
+        count += avail;
+    }
+
+    SigConsumed = count;
+    SigDone = 1;
+    return NULL;
+}
+
+/** @brief Worker thread: producer and consumer of SNAPRING, streams a byte sequence in uneven frames. */
+static void* Snap_Worker(void* arg)
+{
+    byte frame[13];
+    byte seq = 0;
+    uint32_t total = 0;
+
+    (void)arg;
+    while (!SnapStop)
+    {
+        STARB_CAPTYPE len = (STARB_CAPTYPE)(1 + total % sizeof(frame));
+        for (STARB_CAPTYPE idx = 0; idx < len; idx++)
+        {
+            frame[idx] = (byte)(seq + idx);
+        }
+
+        if (STARB_Spsc_WriteItems(&SNAPRING, frame, len) == STARB_OK)
+        {
+            seq += (byte)len;
+            total += len;
+        }
+        STARB_Spsc_Forward(&SNAPRING, STARB_Spsc_GetReadCapacity(&SNAPRING));
+    }
+
+    return NULL;
+}
+
+/** @brief Producer thread: stream THR_TOTAL bytes of the sequence in uneven frames. */
+static void* Thr_Producer(void* arg)
+{
+    byte frame[13];
+    uint32_t index = 0;
+
+    (void)arg;
+    while (index < THR_TOTAL && !ThrStop)
+    {
+        STARB_CAPTYPE len = (STARB_CAPTYPE)(1 + index % sizeof(frame));
+        len = (len < THR_TOTAL - index) ? len : (STARB_CAPTYPE)(THR_TOTAL - index);
+        for (STARB_CAPTYPE idx = 0; idx < len; idx++)
+        {
+            frame[idx] = Thr_Byte(index + idx);
+        }
+
+        uint8_t rc = (len == 1) ? STARB_Spsc_Write(&THRRING, frame[0]) : STARB_Spsc_WriteItems(&THRRING, frame, len);
+        if (rc == STARB_OK)
+        {
+            index += len;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    STARB_Spsc_Flush(&THRRING);
+    return NULL;
+}
+
+/** @brief Byte `index` of the THRRING sequence (does not repeat every 256 bytes). */
+static byte Thr_Byte(const uint32_t index)
+{
+    return (byte)(index * 7 + (index >> 8));
+}
+#endif
@@ -0,0 +1,20 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0003_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0003_H
+
+#define TS_0003_Identifier "TS_0003: STARB_Dma"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0003_Setup(void);
+    int TS_0003_Cleanup(void);
+
+    void TC0014_STARB_Dma_Sync(void);
+    void TC0015_STARB_Dma_Overrun(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0003_H
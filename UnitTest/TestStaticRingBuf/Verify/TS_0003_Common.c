@@ -0,0 +1,220 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0003.h"
+#include "StaticRingBuf_Dma.h"
+#include "TS_0001_TestData.h"
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Dma DMA = { 0 };                   // Externally fed ring instance
+static byte STOBUF[2 * RB_LENGTH] = { 0 };      // STARB_Dma storage buffer
+static byte ReadBuf[RB_LENGTH] = { 0 };         // Read output buffer
+
+static STARB_CAPTYPE DmaLength = 0;             // Simulated DMA: circular transfer length
+static STARB_CAPTYPE DmaPos = 0;                // Simulated DMA: current offset
+static byte DmaSeq = 0;                         // Simulated DMA: next byte value
+
+static STARB_CAPTYPE Dma_Transfer(const STARB_CAPTYPE count);
+static void Dma_Reset(const STARB_CAPTYPE length);
+static bool Verify_Sequence(const byte* data, const STARB_CAPTYPE count, const byte first);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0003_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0003_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0014_STARB_Dma_Sync(void)
+{
+    uint8_t rc = STARB_Dma_Init(&DMA, 2 * RB_LENGTH, STOBUF, STARB_MODE_STREAM);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+
+    memset(STOBUF, 0xEE, sizeof(STOBUF));
+    rc = STARB_Dma_Init(&DMA, 2 * RB_LENGTH, STOBUF, STARB_MODE_DEFAULT);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    Dma_Reset(DMA.rbuf.capacity);
+
+    // Producer delivers 7 bytes (0..6), consumer reads 6
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(7));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Dma_GetReadCapacity(&DMA), 7);
+
+    rc = STARB_Dma_ReadItems(&DMA, ReadBuf, 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(Verify_Sequence(ReadBuf, 6, 0));
+
+    // Producer delivers 8 bytes (7..14) across the end of the storage
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(8));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(DMA.rbuf.wpos, 5);
+    CU_ASSERT_EQUAL(DMA.rbuf.flag.cycle, 1);
+    CU_ASSERT_EQUAL(STARB_Dma_GetReadCapacity(&DMA), 9);
+    CU_ASSERT_EQUAL(STOBUF[RB_LENGTH], 0xEE);
+
+    // Peek repairs only the wrapped bytes it needs
+
+    rc = STARB_Dma_PeekItems(&DMA, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(Verify_Sequence(ReadBuf, 5, 6));
+    CU_ASSERT_EQUAL(DMA.mirrored, 1);
+    CU_ASSERT_EQUAL(STOBUF[RB_LENGTH + 1], 0xEE);
+
+    // Zero-copy pointer: the whole readable data is contiguous
+
+    byte* ptr = STARB_Dma_GetReadPtr(&DMA);
+    CU_ASSERT_PTR_EQUAL(ptr, STOBUF + 6);
+    CU_ASSERT(Verify_Sequence(ptr, 9, 6));
+    CU_ASSERT_EQUAL(DMA.mirrored, 5);
+    CU_ASSERT_EQUAL(STOBUF[RB_LENGTH + 5], 0xEE);
+
+    rc = STARB_Dma_ReadItems(&DMA, ReadBuf, 9);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(Verify_Sequence(ReadBuf, 9, 6));
+    CU_ASSERT_EQUAL(DMA.rbuf.flag.cycle, 0);
+    CU_ASSERT_EQUAL(DMA.mirrored, 0);
+
+    // Idle producer and out-of-range positions
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(0));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Dma_GetReadCapacity(&DMA), 0);
+
+    rc = STARB_Dma_Sync(&DMA, RB_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Dma_SyncRemaining(&DMA, RB_LENGTH + 1);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Dma_Sync(NULL, 0);
+    CU_ASSERT_EQUAL(rc, STARB_PARAM_NULL);
+
+    // A lap ending exactly at the end of the storage (counter reloaded)
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(5));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(DMA.rbuf.wpos, 0);
+    CU_ASSERT_EQUAL(STARB_Dma_GetReadCapacity(&DMA), 5);
+
+    rc = STARB_Dma_ReadItems(&DMA, ReadBuf, 5);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(Verify_Sequence(ReadBuf, 5, 15));
+
+EXIT:
+    return;
+}
+
+void TC0015_STARB_Dma_Overrun(void)
+{
+    STARB_Span spans[2];
+
+    uint8_t rc = STARB_Dma_Init(&DMA, 2 * RB_LENGTH, STOBUF, STARB_MODE_DEFAULT);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    Dma_Reset(DMA.rbuf.capacity);
+
+    // 8 bytes arrive, 2 are read, 5 more overwrite unread data
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(8));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Dma_ReadItems(&DMA, ReadBuf, 2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(5));
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+    CU_ASSERT_EQUAL(DMA.overruns, 1);
+    CU_ASSERT_EQUAL(STARB_Dma_GetReadCapacity(&DMA), 0);
+    CU_ASSERT_EQUAL(DMA.rbuf.rpos, 3);
+    CU_ASSERT_EQUAL(DMA.rbuf.wpos, 3);
+
+    // The ring resumes with the next arrivals
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(4));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Dma_ReadItems(&DMA, ReadBuf, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(Verify_Sequence(ReadBuf, 4, 13));
+
+    // Mirror-less storage: wrapped data is exposed as two spans
+
+    memset(STOBUF, 0xEE, sizeof(STOBUF));
+    rc = STARB_Dma_Init(&DMA, RB_LENGTH, STOBUF, STARB_MODE_NOMIRROR);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    Dma_Reset(DMA.rbuf.capacity);
+
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(6));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Dma_Forward(&DMA, 4);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Dma_SyncRemaining(&DMA, Dma_Transfer(7));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    CU_ASSERT_EQUAL(STARB_Dma_GetReadSpans(&DMA, spans), 2);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, STOBUF + 4);
+    CU_ASSERT_EQUAL(spans[0].len, 6);
+    CU_ASSERT_PTR_EQUAL(spans[1].ptr, STOBUF);
+    CU_ASSERT_EQUAL(spans[1].len, 3);
+    CU_ASSERT_EQUAL(STOBUF[RB_LENGTH], 0xEE);
+
+    rc = STARB_Dma_ReadItems(&DMA, ReadBuf, 9);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(Verify_Sequence(ReadBuf, 9, 4));
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Simulated circular DMA channel: write `count` bytes, return the remaining transfer count. */
+static STARB_CAPTYPE Dma_Transfer(const STARB_CAPTYPE count)
+{
+    for (STARB_CAPTYPE idx = 0; idx < count; idx++)
+    {
+        STOBUF[DmaPos] = DmaSeq++;
+        DmaPos = (DmaPos + 1 < DmaLength) ? DmaPos + 1 : 0;
+    }
+    return DmaLength - DmaPos;
+}
+
+static void Dma_Reset(const STARB_CAPTYPE length)
+{
+    DmaLength = length;
+    DmaPos = 0;
+    DmaSeq = 0;
+}
+
+static bool Verify_Sequence(const byte* data, const STARB_CAPTYPE count, const byte first)
+{
+    for (STARB_CAPTYPE idx = 0; idx < count; idx++)
+    {
+        if (data[idx] != (byte)(first + idx))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0004_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0004_H
+
+#define TS_0004_Identifier "TS_0004: STARB_Bip"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0004_Setup(void);
+    int TS_0004_Cleanup(void);
+
+    void TC0016_STARB_Bip_Frames(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0004_H
@@ -0,0 +1,130 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0004.h"
+#include "StaticRingBuf_Bip.h"
+#include "TS_0001_TestData.h"
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Bip BIP = { 0 };                   // Bipartite ring instance
+static byte STOBUF[RB_LENGTH] = { 0 };          // STARB_Bip storage buffer
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0004_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0004_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0016_STARB_Bip_Frames(void)
+{
+    byte* src = Get_ByteArray0();
+    byte* ptr = NULL;
+    STARB_Span block = { 0 };
+
+    uint8_t rc = STARB_Bip_Init(&BIP, RB_LENGTH, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+    CU_ASSERT_EQUAL(BIP.rbuf.capacity, RB_LENGTH);
+    CU_ASSERT_EQUAL(STARB_Bip_Reserve(&BIP, 0, &ptr), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Bip_Reserve(&BIP, RB_LENGTH + 1, &ptr), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Bip_GetReadBlock(&BIP, &block), STARB_NOENOUGHDAT);
+
+    // Frame 0: 4 bytes; frame 1: reserve 4, commit 3
+
+    rc = STARB_Bip_Reserve(&BIP, 4, &ptr);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(ptr, STOBUF);
+    memcpy(ptr, &src[0], 4);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, 4), STARB_OK);
+
+    rc = STARB_Bip_Reserve(&BIP, 4, &ptr);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(ptr, STOBUF + 4);
+    memcpy(ptr, &src[4], 3);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, 5), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, 3), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Bip_GetReadCapacity(&BIP), 7);
+
+    // 3 bytes left at the end, none at the start: no contiguous block of 4
+
+    rc = STARB_Bip_Reserve(&BIP, 4, &ptr);
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+
+    rc = STARB_Bip_GetReadBlock(&BIP, &block);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(block.ptr, STOBUF);
+    CU_ASSERT_EQUAL(block.len, 7);
+    CU_ASSERT(memcmp(block.ptr, &src[0], 7) == 0);
+    CU_ASSERT_EQUAL(STARB_Bip_Release(&BIP, 4), STARB_OK);
+
+    // Frame 2 wraps to the start, the 3-byte tail is left unused
+
+    rc = STARB_Bip_Reserve(&BIP, 4, &ptr);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(ptr, STOBUF);
+    memcpy(ptr, &src[7], 4);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, 4), STARB_OK);
+    CU_ASSERT_EQUAL(BIP.watermark, 7);
+    CU_ASSERT_EQUAL(BIP.rbuf.flag.cycle, 1);
+    CU_ASSERT_EQUAL(STARB_Bip_GetReadCapacity(&BIP), 7);
+    CU_ASSERT_EQUAL(STARB_Bip_Reserve(&BIP, 1, &ptr), STARB_BUFOVERFLOW);
+
+    rc = STARB_Bip_GetReadBlock(&BIP, &block);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(block.ptr, STOBUF + 4);
+    CU_ASSERT_EQUAL(block.len, 3);
+    CU_ASSERT(memcmp(block.ptr, &src[4], 3) == 0);
+    CU_ASSERT_EQUAL(STARB_Bip_Release(&BIP, 3), STARB_OK);
+
+    // The reader skipped the tail
+
+    CU_ASSERT_EQUAL(BIP.rbuf.rpos, 0);
+    CU_ASSERT_EQUAL(BIP.rbuf.flag.cycle, 0);
+    rc = STARB_Bip_GetReadBlock(&BIP, &block);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(block.ptr, STOBUF);
+    CU_ASSERT_EQUAL(block.len, 4);
+    CU_ASSERT(memcmp(block.ptr, &src[7], 4) == 0);
+    CU_ASSERT_EQUAL(STARB_Bip_Release(&BIP, 5), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(STARB_Bip_Release(&BIP, 4), STARB_OK);
+
+    // Empty ring: the full capacity is one block again; cancel, then fill exactly
+
+    rc = STARB_Bip_Reserve(&BIP, RB_LENGTH, &ptr);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(ptr, STOBUF);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, 0), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, 1), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Bip_GetReadCapacity(&BIP), 0);
+
+    rc = STARB_Bip_Reserve(&BIP, RB_LENGTH, &ptr);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    memcpy(ptr, &src[11], RB_LENGTH);
+    CU_ASSERT_EQUAL(STARB_Bip_Commit(&BIP, RB_LENGTH), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Bip_GetReadCapacity(&BIP), RB_LENGTH);
+
+    rc = STARB_Bip_GetReadBlock(&BIP, &block);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(block.len, RB_LENGTH);
+    CU_ASSERT(memcmp(block.ptr, &src[11], RB_LENGTH) == 0);
+    CU_ASSERT_EQUAL(STARB_Bip_Release(&BIP, RB_LENGTH), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Bip_GetReadCapacity(&BIP), 0);
+
+EXIT:
+    return;
+}
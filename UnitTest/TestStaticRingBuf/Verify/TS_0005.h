@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0005_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0005_H
+
+#define TS_0005_Identifier "TS_0005: STARB_DescRing"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0005_Setup(void);
+    int TS_0005_Cleanup(void);
+
+    void TC0018_STARB_DescRing_Messages(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0005_H
@@ -0,0 +1,169 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0005.h"
+#include "StaticRingBuf_Desc.h"
+#include "TS_0001_TestData.h"
+
+#define DESC_COUNT  4
+#define SLAB_SIZE   32
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_DescRing RING = { 0 };             // Descriptor ring instance
+static STARB_Desc DESCS[DESC_COUNT] = { 0 };    // Descriptor storage
+static byte SLAB[SLAB_SIZE] = { 0 };            // Payload slab
+
+static void Verify_Message(const uint32_t offset, const uint16_t length, const uint16_t flags, const byte first);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0005_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0005_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0018_STARB_DescRing_Messages(void)
+{
+    byte* payload = NULL;
+
+    uint8_t rc = STARB_DescRing_Init(&RING, DESCS, 0, SLAB, SLAB_SIZE);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_DescRing_Init(&RING, DESCS, DESC_COUNT, SLAB, SLAB_SIZE);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, SLAB_SIZE + 1, &payload), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 1, 0), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_NOENOUGHDAT);
+
+    // Message 0: reserve 12, write 10 in place; message 1: 12 bytes
+
+    rc = STARB_DescRing_Reserve(&RING, 12, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB);
+    for (uint8_t idx = 0; idx < 10; idx++)
+    {
+        payload[idx] = (byte)(0x10 + idx);
+    }
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 13, 0), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 10, 0x0001), STARB_OK);
+
+    rc = STARB_DescRing_Reserve(&RING, 12, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB + 10);
+    for (uint8_t idx = 0; idx < 12; idx++)
+    {
+        payload[idx] = (byte)(0x20 + idx);
+    }
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 12, 0x0002), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_GetReadCount(&RING), 2);
+
+    // 10 bytes left at the end, none at the start
+
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, 12, &payload), STARB_BUFOVERFLOW);
+
+    Verify_Message(0, 10, 0x0001, 0x10);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_OK);
+
+    // Message 2 fills the end exactly, message 3 wraps to the start
+
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, 12, &payload), STARB_BUFOVERFLOW);
+    rc = STARB_DescRing_Reserve(&RING, 10, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB + 22);
+    memset(payload, 0x30, 10);
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 10, 0x0003), STARB_OK);
+
+    rc = STARB_DescRing_Reserve(&RING, 8, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB);
+    for (uint8_t idx = 0; idx < 8; idx++)
+    {
+        payload[idx] = (byte)(0x40 + idx);
+    }
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 8, 0x0004), STARB_OK);
+
+    // Wrapped: 2 bytes left up to the oldest payload
+
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, 3, &payload), STARB_BUFOVERFLOW);
+    rc = STARB_DescRing_Reserve(&RING, 2, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB + 8);
+    payload[0] = 0x50;
+    payload[1] = 0x51;
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 2, 0x0005), STARB_OK);
+
+    // All descriptors in use
+
+    CU_ASSERT_EQUAL(STARB_DescRing_GetReadCount(&RING), DESC_COUNT);
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, 1, &payload), STARB_BUFOVERFLOW);
+
+    // Consume in FIFO order, payloads read in place
+
+    Verify_Message(10, 12, 0x0002, 0x20);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_OK);
+    Verify_Message(0, 8, 0x0004, 0x40);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_OK);
+    Verify_Message(8, 2, 0x0005, 0x50);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_GetReadCount(&RING), 0);
+
+    // Empty: the whole slab is one block again
+
+    rc = STARB_DescRing_Reserve(&RING, SLAB_SIZE, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB);
+
+    // Zero-length commit is rejected: it would leave `head` on the oldest payload
+
+    rc = STARB_DescRing_Init(&RING, DESCS, DESC_COUNT, SLAB, SLAB_SIZE);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, 16, &payload), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 16, 0x0006), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_Reserve(&RING, 16, &payload), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_DescRing_Commit(&RING, 0, 0x0007), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_DescRing_GetReadCount(&RING), 1);
+    CU_ASSERT_EQUAL(STARB_DescRing_Release(&RING), STARB_OK);
+    rc = STARB_DescRing_Reserve(&RING, 8, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+static void Verify_Message(const uint32_t offset, const uint16_t length, const uint16_t flags, const byte first)
+{
+    STARB_Desc desc = { 0 };
+    byte* payload = NULL;
+
+    uint8_t rc = STARB_DescRing_Peek(&RING, &desc, &payload);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(desc.offset, offset);
+    CU_ASSERT_EQUAL(desc.length, length);
+    CU_ASSERT_EQUAL(desc.flags, flags);
+    CU_ASSERT_PTR_EQUAL(payload, SLAB + offset);
+
+    for (uint16_t idx = 0; rc == STARB_OK && idx < length; idx++)
+    {
+        CU_ASSERT_EQUAL(payload[idx], (byte)(first + idx));
+    }
+}
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0006_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0006_H
+
+#define TS_0006_Identifier "TS_0006: STARB_Tracker"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0006_Setup(void);
+    int TS_0006_Cleanup(void);
+
+    void TC0019_STARB_Tracker_OutOfOrder(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0006_H
@@ -0,0 +1,130 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0006.h"
+#include "StaticRingBuf_Tracker.h"
+#include "TS_0001_TestData.h"
+
+#define BORROW_COUNT    3
+
+/** @par Private (Static) data declaration
+ */
+
+static StaticRingBuf RBUF = { 0 };                  // Tracked ring instance
+static byte STOBUF[2 * RB_LENGTH] = { 0 };          // StaticRingBuf storage buffer
+static STARB_Tracker TRK = { 0 };                   // Release tracker instance
+static STARB_Borrow SLOTS[BORROW_COUNT] = { 0 };    // Borrow records
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0006_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0006_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0019_STARB_Tracker_OutOfOrder(void)
+{
+    byte* src = Get_ByteArray0();
+    STARB_Span spans[2];
+    uint32_t h0 = 0, h1 = 0, h2 = 0, h3 = 0;
+
+    uint8_t rc = StaticRingBuf_Init(&RBUF, 2 * RB_LENGTH, STOBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Tracker_Init(&TRK, &RBUF, SLOTS, BORROW_COUNT);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_WriteItems(&RBUF, &src[0], RB_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    // Borrow 3 + 4 + 2 bytes
+
+    rc = STARB_Tracker_Acquire(&TRK, 3, spans, &h0);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(spans[0].ptr, &src[0], 3) == 0);
+    rc = STARB_Tracker_Acquire(&TRK, 4, spans, &h1);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(spans[0].ptr, &src[3], 4) == 0);
+    rc = STARB_Tracker_Acquire(&TRK, 2, spans, &h2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(spans[0].ptr, &src[7], 2) == 0);
+    CU_ASSERT_EQUAL(spans[1].len, 0);
+
+    rc = STARB_Tracker_Acquire(&TRK, 1, spans, &h3);
+    CU_ASSERT_EQUAL(rc, STARB_BUFOVERFLOW);
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h2 + 1), STARB_PARAMOUTRANGE);
+
+    // Released out of order: nothing returns until the oldest borrow is back
+
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h2), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Reclaim(&TRK), 0);
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h1), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Reclaim(&TRK), 0);
+    CU_ASSERT_EQUAL(RBUF.rpos, 0);
+
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h0), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Reclaim(&TRK), 9);
+    CU_ASSERT_EQUAL(RBUF.rpos, 9);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetWriteCapacity(&RBUF), 9);
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h0), STARB_PARAMOUTRANGE);
+
+    // Borrow across the wrap point (mirror: 1 span), handles keep cycling
+
+    rc = StaticRingBuf_WriteItems(&RBUF, &src[10], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Tracker_Acquire(&TRK, 5, spans, &h0);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, STOBUF + 9);
+    CU_ASSERT(memcmp(spans[0].ptr, &src[9], 5) == 0);
+    rc = STARB_Tracker_Acquire(&TRK, 3, spans, &h1);
+    CU_ASSERT_EQUAL(rc, STARB_NOENOUGHDAT);
+    rc = STARB_Tracker_Acquire(&TRK, 2, spans, &h1);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(spans[0].ptr, &src[14], 2) == 0);
+
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h1), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h0), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Reclaim(&TRK), 7);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&RBUF), 0);
+
+    // Mirror-less storage: a wrapped borrow comes as 2 spans
+
+    rc = StaticRingBuf_InitMode(&RBUF, RB_LENGTH, STOBUF, STARB_MODE_NOMIRROR);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Tracker_Init(&TRK, &RBUF, SLOTS, BORROW_COUNT);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    rc = StaticRingBuf_WriteItems(&RBUF, &src[0], 8);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Tracker_Acquire(&TRK, 6, spans, &h0);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Release(&TRK, h0), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Tracker_Reclaim(&TRK), 6);
+    rc = StaticRingBuf_WriteItems(&RBUF, &src[8], 6);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    rc = STARB_Tracker_Acquire(&TRK, 8, spans, &h1);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RBUF.rpos, 6);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, STOBUF + 6);
+    CU_ASSERT_EQUAL(spans[0].len, 4);
+    CU_ASSERT_PTR_EQUAL(spans[1].ptr, STOBUF);
+    CU_ASSERT_EQUAL(spans[1].len, 4);
+    CU_ASSERT(memcmp(spans[0].ptr, &src[6], 4) == 0);
+    CU_ASSERT(memcmp(spans[1].ptr, &src[10], 4) == 0);
+
+EXIT:
+    return;
+}
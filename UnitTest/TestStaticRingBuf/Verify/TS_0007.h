@@ -0,0 +1,20 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0007_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0007_H
+
+#define TS_0007_Identifier "TS_0007: STARB_Stage"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0007_Setup(void);
+    int TS_0007_Cleanup(void);
+
+    void TC0020_STARB_Stage_Ordered(void);
+    void TC0036_STARB_Stage_Workers(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0007_H
@@ -0,0 +1,358 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0007.h"
+#include "StaticRingBuf_Stage.h"
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#define SRC_LENGTH      14
+#define DST_LENGTH      8
+#define STAGE_WINDOW    3
+#define STAGE_OUTMAX    4
+
+/** @par Private (Static) data declaration
+ */
+
+static StaticRingBuf SRC = { 0 };                           // Source ring instance
+static byte SRCBUF[2 * SRC_LENGTH] = { 0 };                 // Source storage buffer
+static StaticRingBuf DST = { 0 };                           // Output ring instance
+static byte DSTBUF[2 * DST_LENGTH] = { 0 };                 // Output storage buffer
+static STARB_Stage STAGE = { 0 };                           // Stage instance
+static STARB_StageSlot SLOTS[STAGE_WINDOW] = { 0 };         // Reorder window
+static byte OUTSLAB[STAGE_WINDOW * STAGE_OUTMAX] = { 0 };   // Result buffers
+
+/** @par Private (Static) functions declaration
+ */
+
+static STARB_CAPTYPE Frame_Length(const byte* data, const STARB_CAPTYPE avail);
+static STARB_CAPTYPE Frame_Work(void* context, const byte* in, const STARB_CAPTYPE inlen, byte* out, const STARB_CAPTYPE outmax);
+static void Job_Echo(STARB_Job* job);
+
+#if !defined(_WIN32)
+#define WRK_COUNT       4                               // Worker threads
+#define WRK_FRAMES      20000                           // Frames pushed through the stage
+#define WRK_SRC_LENGTH  64                              // WSRC capacity
+#define WRK_DST_LENGTH  16                              // WDST capacity
+#define WRK_WINDOW      8                               // Reorder window of WSTAGE
+#define WRK_OUTMAX      2                               // Result: frame number, little endian
+#define WRK_IDLE_LIMIT  200000000u                      // Idle polls before the main thread gives up
+
+static StaticRingBuf WSRC = { 0 };                      // Source ring shared with the workers
+static byte WSRCBUF[2 * WRK_SRC_LENGTH] = { 0 };        // WSRC storage buffer
+static StaticRingBuf WDST = { 0 };                      // Output ring shared with the workers
+static byte WDSTBUF[2 * WRK_DST_LENGTH] = { 0 };        // WDST storage buffer
+static STARB_Stage WSTAGE = { 0 };                      // Stage fed to the worker pool
+static STARB_StageSlot WSLOTS[WRK_WINDOW] = { 0 };      // WSTAGE reorder window
+static byte WOUTSLAB[WRK_WINDOW * WRK_OUTMAX] = { 0 };  // WSTAGE result buffers
+static volatile uint32_t WrkStop = 0;                   // [Main] All results read or gave up
+
+static void* Wrk_Worker(void* arg);
+static STARB_CAPTYPE Wrk_Work(void* context, const byte* in, const STARB_CAPTYPE inlen, byte* out, const STARB_CAPTYPE outmax);
+#endif
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0007_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0007_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0020_STARB_Stage_Ordered(void)
+{
+    // Length-prefixed frames: [len][payload]
+    byte frames[] = { 2, 'a', 'b', 3, 'c', 'd', 'e', 1, 'f', 2, 'g', 'h' };
+    byte partial[] = { 3, 'i' };
+    byte rest[] = { 'j', 'k' };
+    byte last[] = { 2, 'x', 'y' };
+    byte result[DST_LENGTH] = { 0 };
+    STARB_Job j0, j1, j2, j3;
+    int calls = 0;
+
+    uint8_t rc = StaticRingBuf_Init(&SRC, 2 * SRC_LENGTH, SRCBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_Init(&DST, 2 * DST_LENGTH, DSTBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    rc = STARB_Stage_Init(&STAGE, &SRC, &DST, SLOTS, 0, OUTSLAB, STAGE_OUTMAX, Frame_Length);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Stage_Init(&STAGE, &SRC, &DST, SLOTS, STAGE_WINDOW, OUTSLAB, DST_LENGTH + 1, Frame_Length);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Stage_Init(&STAGE, &SRC, &DST, SLOTS, STAGE_WINDOW, OUTSLAB, STAGE_OUTMAX, Frame_Length);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    rc = StaticRingBuf_WriteItems(&SRC, frames, sizeof(frames));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+
+    // Fill the reorder window, then backpressure
+
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j0), STARB_OK);
+    CU_ASSERT_EQUAL(j0.inlen, 3);
+    CU_ASSERT_PTR_EQUAL(j0.in, SRCBUF);
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j1), STARB_OK);
+    CU_ASSERT_EQUAL(j1.inlen, 4);
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j2), STARB_OK);
+    CU_ASSERT_EQUAL(j2.inlen, 2);
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j3), STARB_BUFOVERFLOW);
+
+    // Completed in reverse order: nothing is retired until the oldest is done
+
+    Job_Echo(&j2);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j2, 1), STARB_OK);
+    Job_Echo(&j1);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j1, 3), STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&DST), 0);
+    CU_ASSERT_EQUAL(SRC.rpos, 0);
+
+    Job_Echo(&j0);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j0, 2), STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&DST), 6);
+    CU_ASSERT_EQUAL(SRC.rpos, 9);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j0, 2), STARB_PARAMOUTRANGE);
+
+    // Incomplete frame is not handed out
+
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j3), STARB_OK);
+    CU_ASSERT_EQUAL(j3.inlen, 3);
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j0), STARB_NOENOUGHDAT);
+    rc = StaticRingBuf_WriteItems(&SRC, partial, sizeof(partial));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j0), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j3, STAGE_OUTMAX + 1), STARB_PARAMOUTRANGE);
+    Job_Echo(&j3);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j3, 2), STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetWriteCapacity(&DST), 0);
+
+    // Frame across the wrap point (mirror: contiguous), output ring full
+
+    rc = StaticRingBuf_WriteItems(&SRC, rest, sizeof(rest));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stage_Take(&STAGE, &j0), STARB_OK);
+    CU_ASSERT_EQUAL(j0.inlen, 4);
+    CU_ASSERT_PTR_EQUAL(j0.in, SRCBUF + 12);
+    CU_ASSERT(memcmp(j0.in, "\x03ijk", 4) == 0);
+    Job_Echo(&j0);
+    CU_ASSERT_EQUAL(STARB_Stage_Complete(&STAGE, &j0, 3), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stage_Retire(&STAGE), 0);
+    CU_ASSERT_EQUAL(SRC.rpos, 12);
+
+    rc = StaticRingBuf_ReadItems(&DST, result, DST_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(result, "abcdefgh", DST_LENGTH) == 0);
+    CU_ASSERT_EQUAL(STARB_Stage_Retire(&STAGE), 1);
+    CU_ASSERT_EQUAL(SRC.rpos, 2);
+    rc = StaticRingBuf_ReadItems(&DST, result, 3);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(result, "ijk", 3) == 0);
+
+    // Take, process and complete in one call
+
+    CU_ASSERT_EQUAL(STARB_Stage_Run(&STAGE, NULL, &calls), STARB_PARAM_NULL);
+    CU_ASSERT_EQUAL(STARB_Stage_Run(&STAGE, Frame_Work, &calls), STARB_NOENOUGHDAT);
+    rc = StaticRingBuf_WriteItems(&SRC, last, sizeof(last));
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stage_Run(&STAGE, Frame_Work, &calls), STARB_OK);
+    CU_ASSERT_EQUAL(calls, 1);
+    rc = StaticRingBuf_ReadItems(&DST, result, 2);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(result, "YX", 2) == 0);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&SRC), 0);
+
+    // Mirror-less source storage is rejected
+
+    rc = StaticRingBuf_InitMode(&SRC, SRC_LENGTH, SRCBUF, STARB_MODE_NOMIRROR);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Stage_Init(&STAGE, &SRC, &DST, SLOTS, STAGE_WINDOW, OUTSLAB, STAGE_OUTMAX, Frame_Length);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+
+EXIT:
+    return;
+}
+
+void TC0036_STARB_Stage_Workers(void)
+{
+#if !defined(_WIN32)
+    // The main thread writes numbered frames and reads the results, a pool of
+    // workers runs them in whatever order they get scheduled. The results
+    // must come out in frame order.
+
+    pthread_t workers[WRK_COUNT];
+    uint32_t failures[WRK_COUNT] = { 0 };
+    uint32_t started = 0;
+    uint32_t written = 0;
+    uint32_t received = 0;
+    uint32_t errors = 0;
+    uint32_t idle = 0;
+    byte frame[8];
+    byte result[WRK_DST_LENGTH];
+
+    uint8_t rc = StaticRingBuf_Init(&WSRC, sizeof(WSRCBUF), WSRCBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_Init(&WDST, sizeof(WDSTBUF), WDSTBUF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Stage_Init(&WSTAGE, &WSRC, &WDST, WSLOTS, WRK_WINDOW, WOUTSLAB, WRK_OUTMAX, Frame_Length);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        return;
+    }
+    WrkStop = 0;
+
+    for (; started < WRK_COUNT; started++)
+    {
+        if (pthread_create(&workers[started], NULL, Wrk_Worker, &failures[started]) != 0)
+        {
+            CU_FAIL("pthread_create");
+            break;
+        }
+    }
+
+    while (started > 0 && received < WRK_FRAMES && idle < WRK_IDLE_LIMIT)
+    {
+        STARB_CAPTYPE avail = 0;
+        int progress = 0;
+
+        /* Frame `written`: [len][number lo][number hi][filler], 3 ~ 7 bytes */
+        STARB_CAPTYPE len = (STARB_CAPTYPE)(3 + written % 5);
+        frame[0] = (byte)(len - 1);
+        frame[1] = (byte)written;
+        frame[2] = (byte)(written >> 8);
+        memset(frame + 3, 0xA5, sizeof(frame) - 3);
+
+        STARB_SpinLock_Acquire(&WSTAGE.lock);
+        if (written < WRK_FRAMES && StaticRingBuf_GetWriteCapacity(&WSRC) >= len)
+        {
+            errors += StaticRingBuf_WriteItems(&WSRC, frame, len) != STARB_OK;
+            written++;
+            progress = 1;
+        }
+        avail = StaticRingBuf_GetReadCapacity(&WDST);
+        if (avail > 0)
+        {
+            errors += StaticRingBuf_ReadItems(&WDST, result, avail) != STARB_OK;
+        }
+        STARB_SpinLock_Release(&WSTAGE.lock);
+
+        /* Results blocked on a full output ring are retired on the next take;
+         * retire here as well so it does not depend on a worker being awake. */
+        STARB_Stage_Retire(&WSTAGE);
+
+        for (STARB_CAPTYPE idx = 0; idx + 1 < avail; idx += WRK_OUTMAX)
+        {
+            uint32_t number = (uint32_t)result[idx] | ((uint32_t)result[idx + 1] << 8);
+            errors += number != (received & 0xFFFF);
+            received++;
+        }
+        errors += avail % WRK_OUTMAX;
+
+        if (progress || avail > 0)
+        {
+            idle = 0;
+        }
+        else
+        {
+            idle++;
+            sched_yield();
+        }
+    }
+
+    WrkStop = 1;
+    for (uint32_t idx = 0; idx < started; idx++)
+    {
+        pthread_join(workers[idx], NULL);
+        errors += failures[idx];
+    }
+
+    CU_ASSERT_EQUAL(started, WRK_COUNT);
+    CU_ASSERT_EQUAL(received, WRK_FRAMES);
+    CU_ASSERT_EQUAL(errors, 0);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&WSRC), 0);
+#endif
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Frame length of a length-prefixed frame, 0 while incomplete. */
+static STARB_CAPTYPE Frame_Length(const byte* data, const STARB_CAPTYPE avail)
+{
+    STARB_CAPTYPE len = (STARB_CAPTYPE)(1 + data[0]);
+    return (len <= avail) ? len : 0;
+}
+
+/** @brief Worker: payload reversed and upper-cased. */
+static STARB_CAPTYPE Frame_Work(void* context, const byte* in, const STARB_CAPTYPE inlen, byte* out, const STARB_CAPTYPE outmax)
+{
+    STARB_CAPTYPE len = inlen - 1;
+    (*(int*)context)++;
+
+    for (STARB_CAPTYPE i = 0; i < len && i < outmax; i++)
+    {
+        out[i] = (byte)(in[inlen - 1 - i] - 'a' + 'A');
+    }
+
+    return len;
+}
+
+/** @brief Worker stand-in: copy the payload to the result buffer. */
+static void Job_Echo(STARB_Job* job)
+{
+    memcpy(job->out, job->in + 1, job->inlen - 1);
+}
+
+#if !defined(_WIN32)
+/** @brief Worker thread: run frames until told to stop, counting unexpected results. */
+static void* Wrk_Worker(void* arg)
+{
+    uint32_t* failures = (uint32_t*)arg;
+
+    while (!WrkStop)
+    {
+        uint8_t rc = STARB_Stage_Run(&WSTAGE, Wrk_Work, NULL);
+        if (rc == STARB_OK)
+        {
+            continue;
+        }
+
+        *failures += (rc != STARB_BUFOVERFLOW && rc != STARB_NOENOUGHDAT);
+        sched_yield();
+    }
+
+    return NULL;
+}
+
+/** @brief Worker: the frame number as result; every third frame yields first to shuffle completions. */
+static STARB_CAPTYPE Wrk_Work(void* context, const byte* in, const STARB_CAPTYPE inlen, byte* out, const STARB_CAPTYPE outmax)
+{
+    (void)context;
+    if (inlen < 3 || outmax < WRK_OUTMAX)
+    {
+        return 0;
+    }
+
+    if (in[1] % 3 == 0)
+    {
+        sched_yield();
+    }
+
+    out[0] = in[1];
+    out[1] = in[2];
+    return WRK_OUTMAX;
+}
+#endif
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0008_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0008_H
+
+#define TS_0008_Identifier "TS_0008: STARB_Table"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0008_Setup(void);
+    int TS_0008_Cleanup(void);
+
+    void TC0021_STARB_Table_Arena(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0008_H
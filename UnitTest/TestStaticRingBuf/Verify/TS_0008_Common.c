@@ -0,0 +1,123 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0008.h"
+#include "StaticRingBuf_Table.h"
+
+#define RING_COUNT      6
+#define RING_CAP        4
+#define ARENA_SIZE      (3 * 2 * RING_CAP + 3)
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Table TBL = { 0 };                     // Ring table instance
+static byte ARENA[ARENA_SIZE] = { 0 };              // Storage arena
+static uint32_t OFFSETS[RING_COUNT] = { 0 };        // Block offset per ring
+static STARB_CAPTYPE RPOS[RING_COUNT] = { 0 };      // Read position per ring
+static STARB_CAPTYPE USED[RING_COUNT] = { 0 };      // Readable bytes per ring
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0008_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0008_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0021_STARB_Table_Arena(void)
+{
+    byte result[RING_CAP] = { 0 };
+    STARB_Span spans[2];
+
+    uint8_t rc = STARB_Table_Init(&TBL, ARENA, ARENA_SIZE, 3, STARB_MODE_DEFAULT, RING_COUNT, OFFSETS, RPOS, USED);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Table_Init(&TBL, ARENA, 2 * RING_CAP - 1, RING_CAP, STARB_MODE_DEFAULT, RING_COUNT, OFFSETS, RPOS, USED);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Table_Init(&TBL, ARENA, ARENA_SIZE, RING_CAP, STARB_MODE_DEFAULT, RING_COUNT, OFFSETS, RPOS, USED);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(TBL.freeblocks, 3);
+    CU_ASSERT_EQUAL(OFFSETS[0], STARB_TABLE_COLD);
+    CU_ASSERT_EQUAL(STARB_Table_NextReady(&TBL, 0), RING_COUNT);
+
+    // Blocks are handed out on first write, until the arena runs out
+
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 1, (const byte*)"abc", 3), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 4, (const byte*)"de", 2), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 5, (const byte*)"f", 1), STARB_OK);
+    CU_ASSERT_EQUAL(OFFSETS[1], 0);
+    CU_ASSERT_EQUAL(OFFSETS[4], 2 * RING_CAP);
+    CU_ASSERT_EQUAL(OFFSETS[5], 4 * RING_CAP);
+    CU_ASSERT_EQUAL(STARB_Table_GetWriteCapacity(&TBL, 2), 0);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 2, (const byte*)"x", 1), STARB_BUFOVERFLOW);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, RING_COUNT, (const byte*)"x", 1), STARB_PARAMOUTRANGE);
+
+    // Sweep over the rings with data
+
+    CU_ASSERT_EQUAL(STARB_Table_NextReady(&TBL, 0), 1);
+    CU_ASSERT_EQUAL(STARB_Table_NextReady(&TBL, 2), 4);
+    CU_ASSERT_EQUAL(STARB_Table_NextReady(&TBL, 5), 5);
+
+    // Wrap inside a mirrored block: still 1 span
+
+    CU_ASSERT_EQUAL(STARB_Table_ReadItems(&TBL, 1, result, 2), STARB_OK);
+    CU_ASSERT(memcmp(result, "ab", 2) == 0);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 1, (const byte*)"ghi", 3), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_GetWriteCapacity(&TBL, 1), 0);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 1, (const byte*)"j", 1), STARB_BUFOVERFLOW);
+    CU_ASSERT_EQUAL(STARB_Table_GetReadSpans(&TBL, 1, spans), 1);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, ARENA + 2);
+    CU_ASSERT_EQUAL(spans[0].len, 4);
+    CU_ASSERT(memcmp(spans[0].ptr, "cghi", 4) == 0);
+
+    // Idle rings give their block back
+
+    CU_ASSERT_EQUAL(STARB_Table_Forward(&TBL, 4, 3), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(STARB_Table_Forward(&TBL, 4, 2), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_ParkIdle(&TBL), 1);
+    CU_ASSERT_EQUAL(OFFSETS[4], STARB_TABLE_COLD);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 2, (const byte*)"xy", 2), STARB_OK);
+    CU_ASSERT_EQUAL(OFFSETS[2], 2 * RING_CAP);
+
+    CU_ASSERT_EQUAL(STARB_Table_Park(&TBL, 1), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Table_ReadItems(&TBL, 1, result, RING_CAP), STARB_OK);
+    CU_ASSERT(memcmp(result, "cghi", RING_CAP) == 0);
+    CU_ASSERT_EQUAL(STARB_Table_Park(&TBL, 1), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_Park(&TBL, 1), STARB_OK);
+    CU_ASSERT_EQUAL(TBL.freeblocks, 1);
+    CU_ASSERT_EQUAL(STARB_Table_NextReady(&TBL, 0), 2);
+
+    // Mirror-less blocks: a wrapped ring comes as 2 spans
+
+    rc = STARB_Table_Init(&TBL, ARENA, ARENA_SIZE, RING_CAP, STARB_MODE_NOMIRROR, RING_COUNT, OFFSETS, RPOS, USED);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(TBL.freeblocks, 6);
+
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 3, (const byte*)"abc", 3), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_ReadItems(&TBL, 3, result, 2), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_WriteItems(&TBL, 3, (const byte*)"def", 3), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Table_GetReadSpans(&TBL, 3, spans), 2);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, ARENA + 2);
+    CU_ASSERT_EQUAL(spans[0].len, 2);
+    CU_ASSERT_PTR_EQUAL(spans[1].ptr, ARENA);
+    CU_ASSERT_EQUAL(spans[1].len, 2);
+    CU_ASSERT_EQUAL(STARB_Table_ReadItems(&TBL, 3, result, RING_CAP), STARB_OK);
+    CU_ASSERT(memcmp(result, "cdef", RING_CAP) == 0);
+    CU_ASSERT_EQUAL(RPOS[3], 0);
+
+EXIT:
+    return;
+}
@@ -0,0 +1,20 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0009_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0009_H
+
+#define TS_0009_Identifier "TS_0009: STARB_Arena"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0009_Setup(void);
+    int TS_0009_Cleanup(void);
+
+    void TC0022_STARB_Arena_Provision(void);
+    void TC0023_STARB_Arena_Numa(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0009_H
@@ -0,0 +1,143 @@
+﻿#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0009.h"
+#include "StaticRingBuf_Arena.h"
+#include "TS_0001_TestData.h"
+
+#define ARENA_SIZE      (64 * 1024)
+#define RING_SIZE       (2 * 4096)
+#define STATIC_SIZE     256
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Arena ARENA = { 0 };                   // Arena instance
+static StaticRingBuf RBUF0 = { 0 };                 // Ring with arena storage
+static StaticRingBuf RBUF1 = { 0 };                 // Ring with arena storage
+static byte STATICBUF[STATIC_SIZE] = { 0 };         // Buffer for the attached arena
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0009_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0009_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0022_STARB_Arena_Provision(void)
+{
+    byte* src = Get_ByteArray0();
+    byte result[RB_LENGTH] = { 0 };
+
+    CU_ASSERT_EQUAL(STARB_Arena_Create(&ARENA, 0, STARB_ARENA_DEFAULT), STARB_PARAMOUTRANGE);
+
+    // OS mapped arena: whatever backing is available, the requested size is there
+
+    uint8_t rc = STARB_Arena_Create(&ARENA, ARENA_SIZE, STARB_ARENA_HUGEPAGE | STARB_ARENA_PREFAULT | STARB_ARENA_LOCK);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_PTR_NOT_NULL(ARENA.base);
+    CU_ASSERT(ARENA.size >= ARENA_SIZE);
+    CU_ASSERT(ARENA.pagesize > 0);
+    CU_ASSERT(ARENA.flags & STARB_ARENA_PREFAULT);
+    CU_ASSERT(ARENA.flags & STARB_ARENA_OWNED);
+
+    rc = STARB_Arena_InitRing(&ARENA, &RBUF0, RING_SIZE, STARB_MODE_DEFAULT);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = STARB_Arena_InitRing(&ARENA, &RBUF1, RING_SIZE, STARB_MODE_NOMIRROR);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(RBUF0.capacity, RING_SIZE / 2);
+    CU_ASSERT_EQUAL(RBUF1.capacity, RING_SIZE);
+    CU_ASSERT_EQUAL((uintptr_t)RBUF1.buffer % STARB_CACHELINE, 0);
+    CU_ASSERT(RBUF1.buffer >= RBUF0.buffer + RING_SIZE);
+
+    rc = StaticRingBuf_WriteItems(&RBUF1, src, RB_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    rc = StaticRingBuf_ReadItems(&RBUF1, result, RB_LENGTH);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(memcmp(result, src, RB_LENGTH) == 0);
+
+    rc = STARB_Arena_InitRing(&ARENA, &RBUF0, 1, STARB_MODE_DEFAULT);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    CU_ASSERT_PTR_NULL(STARB_Arena_Alloc(&ARENA, ARENA.size));
+
+    STARB_Arena_Destroy(&ARENA);
+    CU_ASSERT_PTR_NULL(ARENA.base);
+
+    // Attached buffer: cache line aligned blocks until it runs out
+
+    rc = STARB_Arena_Attach(&ARENA, STATICBUF, STATIC_SIZE);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(ARENA.flags, 0);
+
+    byte* block = STARB_Arena_Alloc(&ARENA, 10);
+    CU_ASSERT_PTR_NOT_NULL(block);
+    CU_ASSERT_EQUAL((uintptr_t)block % STARB_CACHELINE, 0);
+    block = STARB_Arena_Alloc(&ARENA, 10);
+    CU_ASSERT_EQUAL((uintptr_t)block % STARB_CACHELINE, 0);
+    CU_ASSERT_PTR_NULL(STARB_Arena_Alloc(&ARENA, STATIC_SIZE));
+
+    STARB_Arena_Reset(&ARENA);
+    rc = STARB_Arena_InitRing(&ARENA, &RBUF0, 2 * RB_LENGTH, STARB_MODE_DEFAULT);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT(RBUF0.buffer >= STATICBUF && RBUF0.buffer < STATICBUF + STATIC_SIZE);
+    STARB_Arena_Destroy(&ARENA);
+
+EXIT:
+    return;
+}
+
+void TC0023_STARB_Arena_Numa(void)
+{
+    byte* src = Get_ByteArray0();
+    byte result[RB_LENGTH] = { 0 };
+    uint32_t node = STARB_Arena_CurrentNode();
+
+    uint8_t rc = STARB_Arena_CreateOnNode(&ARENA, ARENA_SIZE, STARB_ARENA_DEFAULT, STARB_NUMA_INTERLEAVE + 1, node);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+
+    // Every policy maps; placement is applied, or a no-op on a single node
+
+    for (uint8_t policy = STARB_NUMA_NONE; policy <= STARB_NUMA_INTERLEAVE; policy++)
+    {
+        rc = STARB_Arena_CreateOnNode(&ARENA, ARENA_SIZE, STARB_ARENA_PREFAULT, policy, node);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        if (rc != STARB_OK)
+        {
+            continue;
+        }
+
+        CU_ASSERT(ARENA.numa == policy || ARENA.numa == STARB_NUMA_NONE);
+
+        rc = STARB_Arena_InitRing(&ARENA, &RBUF0, RING_SIZE, STARB_MODE_DEFAULT);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        rc = StaticRingBuf_WriteItems(&RBUF0, src, RB_LENGTH);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        rc = StaticRingBuf_ReadItems(&RBUF0, result, RB_LENGTH);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        CU_ASSERT(memcmp(result, src, RB_LENGTH) == 0);
+
+        STARB_Arena_Destroy(&ARENA);
+    }
+
+    // A node outside the allowed set falls back to the OS default
+
+    rc = STARB_Arena_CreateOnNode(&ARENA, ARENA_SIZE, STARB_ARENA_DEFAULT, STARB_NUMA_CONSUMER, 0xFFFF);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(ARENA.numa, STARB_NUMA_NONE);
+    STARB_Arena_Destroy(&ARENA);
+}
\ No newline at end of file
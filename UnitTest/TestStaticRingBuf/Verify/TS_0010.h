@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0010_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0010_H
+
+#define TS_0010_Identifier "TS_0010: STARB_Timed"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0010_Setup(void);
+    int TS_0010_Cleanup(void);
+
+    void TC0024_STARB_Timed_Window(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0010_H
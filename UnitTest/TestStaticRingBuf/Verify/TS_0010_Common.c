@@ -0,0 +1,139 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0010.h"
+#include "StaticRingBuf_Timed.h"
+
+#define TIMED_CAP       64
+#define MARK_COUNT      2
+#define MARK_STRIDE     2
+#define TIMED_WINDOW    100
+#define RECORD_SIZE     (STARB_TIMED_HDRSIZE + 2)
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Timed TIMED = { 0 };                   // Time-indexed ring instance
+static byte STOBUF[2 * TIMED_CAP] = { 0 };          // Record storage buffer
+static STARB_TimedMark MARKS[MARK_COUNT] = { 0 };   // Sparse index
+static uint32_t LostCount = 0;                      // Dropped records logged
+static STARB_CAPTYPE LostBytes = 0;                 // Dropped bytes logged
+
+/** @par Private (Static) functions declaration
+ */
+
+static void Log_Timed_Dropped(STARB_Lostdata* log);
+static uint8_t Write_Sample(const uint64_t ts);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0010_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0010_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0024_STARB_Timed_Window(void)
+{
+    uint32_t cursor = 0;
+    uint32_t stale = 0;
+    uint64_t ts = 0;
+    STARB_Span payload;
+
+    uint8_t rc = STARB_Timed_Init(&TIMED, 2 * STARB_TIMED_HDRSIZE, STOBUF, MARKS, MARK_COUNT, MARK_STRIDE, TIMED_WINDOW, Log_Timed_Dropped);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Timed_Init(&TIMED, 2 * TIMED_CAP, STOBUF, MARKS, MARK_COUNT, MARK_STRIDE, TIMED_WINDOW, Log_Timed_Dropped);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 0, &cursor), STARB_NOENOUGHDAT);
+
+    // 5 records fill 60 of 64 bytes; marks on every 2nd record, the oldest mark gives way
+
+    for (uint64_t t = 0; t <= 40; t += 10)
+    {
+        CU_ASSERT_EQUAL(Write_Sample(t), STARB_OK);
+    }
+
+    CU_ASSERT_EQUAL(TIMED.records, 5);
+    CU_ASSERT_EQUAL(TIMED.marknum, MARK_COUNT);
+    CU_ASSERT_EQUAL(STARB_Timed_Write(&TIMED, 40, STOBUF, TIMED_CAP), STARB_PARAMOUTRANGE);
+
+    // No room: the oldest record is dropped, like a forced write
+
+    CU_ASSERT_EQUAL(Write_Sample(50), STARB_OK);
+    CU_ASSERT_EQUAL(TIMED.records, 5);
+    CU_ASSERT_EQUAL(TIMED.dropped, 1);
+    CU_ASSERT_EQUAL(LostCount, 1);
+    CU_ASSERT_EQUAL(LostBytes, RECORD_SIZE);
+
+    // Seek through the sparse index
+
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 25, &cursor), STARB_OK);
+    CU_ASSERT_EQUAL(cursor, 3 * RECORD_SIZE);
+    for (uint64_t t = 30; t <= 50; t += 10)
+    {
+        CU_ASSERT_EQUAL(STARB_Timed_Next(&TIMED, &cursor, &ts, &payload), STARB_OK);
+        CU_ASSERT_EQUAL(ts, t);
+        CU_ASSERT_EQUAL(payload.len, 2);
+        CU_ASSERT_EQUAL(payload.ptr[0], 't');
+        CU_ASSERT_EQUAL(payload.ptr[1], (byte)t);
+    }
+    CU_ASSERT_EQUAL(STARB_Timed_Next(&TIMED, &cursor, &ts, &payload), STARB_NOENOUGHDAT);
+
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 5, &stale), STARB_OK);
+    CU_ASSERT_EQUAL(stale, RECORD_SIZE);
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 40, &cursor), STARB_OK);
+    CU_ASSERT_EQUAL(cursor, 4 * RECORD_SIZE);
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 51, &cursor), STARB_NOENOUGHDAT);
+
+    // Age drives retention: everything older than 150 - 100 goes
+
+    CU_ASSERT_EQUAL(Write_Sample(150), STARB_OK);
+    CU_ASSERT_EQUAL(TIMED.records, 2);
+    CU_ASSERT_EQUAL(TIMED.dropped, 5);
+    CU_ASSERT_EQUAL(LostCount, 5);
+    CU_ASSERT_EQUAL(STARB_Timed_Next(&TIMED, &stale, &ts, &payload), STARB_DATAINVALID);
+    CU_ASSERT_EQUAL(Write_Sample(140), STARB_PARAMOUTRANGE);
+
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 0, &cursor), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Timed_Next(&TIMED, &cursor, &ts, &payload), STARB_OK);
+    CU_ASSERT_EQUAL(ts, 50);
+
+    CU_ASSERT_EQUAL(STARB_Timed_Trim(&TIMED, 240), 1);
+    CU_ASSERT_EQUAL(STARB_Timed_Trim(&TIMED, 300), 1);
+    CU_ASSERT_EQUAL(TIMED.records, 0);
+    CU_ASSERT_EQUAL(TIMED.marknum, 0);
+    CU_ASSERT_EQUAL(STARB_Timed_Seek(&TIMED, 0, &cursor), STARB_NOENOUGHDAT);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Count the dropped records. */
+static void Log_Timed_Dropped(STARB_Lostdata* log)
+{
+    LostCount++;
+    LostBytes = log->count;
+}
+
+/** @brief Write a 2-byte sample record: 't', low byte of the timestamp. */
+static uint8_t Write_Sample(const uint64_t ts)
+{
+    byte sample[2] = { 't', (byte)ts };
+    return STARB_Timed_Write(&TIMED, ts, sample, sizeof(sample));
+}
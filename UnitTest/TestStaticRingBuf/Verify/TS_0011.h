@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0011_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0011_H
+
+#define TS_0011_Identifier "TS_0011: STARB_Prio"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0011_Setup(void);
+    int TS_0011_Cleanup(void);
+
+    void TC0025_STARB_Prio_Lanes(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0011_H
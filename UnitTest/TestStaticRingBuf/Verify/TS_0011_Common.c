@@ -0,0 +1,112 @@
+﻿#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0011.h"
+#include "StaticRingBuf_Prio.h"
+
+#define LANE_COUNT      4
+#define LANE_CAP        8
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Prio PRIO = { 0 };                             // Priority ring set instance
+static StaticRingBuf LANES[LANE_COUNT] = { 0 };             // Lane rings
+static byte STOBUF[LANE_COUNT][2 * LANE_CAP] = { 0 };       // Lane storage buffers
+static const uint16_t WEIGHTS[LANE_COUNT] = { 0, 3, 1, 0 }; // Lanes 0, 3 strict; 1, 2 shared 3:1
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0011_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0011_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0025_STARB_Prio_Lanes(void)
+{
+    const uint32_t expected[] = { 1, 1, 0, 3, 1, 2, 1, 1, 1, 2, 2, 2 };
+    byte bulk[] = { 'A', 'A', 'A', 'A', 'A', 'A' };
+    byte result[LANE_CAP] = { 0 };
+    STARB_CAPTYPE readcount = 0;
+    uint32_t lane = 0;
+    uint8_t rc = STARB_OK;
+
+    for (uint32_t i = 0; i < LANE_COUNT; i++)
+    {
+        rc = StaticRingBuf_Init(&LANES[i], 2 * LANE_CAP, STOBUF[i]);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+    }
+
+    rc = STARB_Prio_Init(&PRIO, LANES, STARB_PRIO_MAXLANES + 1, WEIGHTS);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Prio_Init(&PRIO, LANES, LANE_COUNT, WEIGHTS);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(STARB_Prio_Read(&PRIO, result, 1, &readcount, &lane), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, LANE_COUNT, bulk, 1), STARB_PARAMOUTRANGE);
+
+    // Bulk on the shared lanes, 3:1; strict lanes cut in as soon as they have data
+
+    CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, 1, bulk, sizeof(bulk)), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, 2, (byte*)"BBBB", 4), STARB_OK);
+    CU_ASSERT_EQUAL(PRIO.ready, 0x06);
+
+    // An empty read is rejected before a lane is charged
+
+    CU_ASSERT_EQUAL(STARB_Prio_Read(&PRIO, result, 0, &readcount, &lane), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(PRIO.credit, 0);
+
+    for (uint32_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        if (i == 2)
+        {
+            CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, 3, (byte*)"D", 1), STARB_OK);
+            CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, 0, (byte*)"C", 1), STARB_OK);
+        }
+
+        rc = STARB_Prio_Read(&PRIO, result, 1, &readcount, &lane);
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        CU_ASSERT_EQUAL(readcount, 1);
+        CU_ASSERT_EQUAL(lane, expected[i]);
+        CU_ASSERT_EQUAL(result[0], (byte)"CABD"[lane]);
+    }
+
+    CU_ASSERT_EQUAL(PRIO.ready, 0);
+    CU_ASSERT_EQUAL(STARB_Prio_Read(&PRIO, result, 1, &readcount, &lane), STARB_NOENOUGHDAT);
+
+    // Strict priority only: the lower lane waits until the higher one is empty
+
+    rc = STARB_Prio_Init(&PRIO, LANES, LANE_COUNT, NULL);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, 2, (byte*)"BB", 2), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Prio_Write(&PRIO, 1, bulk, 3), STARB_OK);
+
+    rc = STARB_Prio_Read(&PRIO, result, LANE_CAP, &readcount, &lane);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    CU_ASSERT_EQUAL(lane, 1);
+    CU_ASSERT_EQUAL(readcount, 3);
+
+    // Zero-copy: select, consume on the lane ring, refresh
+
+    CU_ASSERT_EQUAL(STARB_Prio_Select(&PRIO), 2);
+    CU_ASSERT_EQUAL(StaticRingBuf_Forward(&LANES[2], 2), STARB_OK);
+    STARB_Prio_Refresh(&PRIO, 2);
+    CU_ASSERT_EQUAL(PRIO.ready, 0);
+    CU_ASSERT_EQUAL(STARB_Prio_Select(&PRIO), LANE_COUNT);
+
+EXIT:
+    return;
+}
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0012_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0012_H
+
+#define TS_0012_Identifier "TS_0012: STARB_Lz"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0012_Setup(void);
+    int TS_0012_Cleanup(void);
+
+    void TC0026_STARB_Lz_Blocks(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0012_H
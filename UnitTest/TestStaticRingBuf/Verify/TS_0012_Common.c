@@ -0,0 +1,162 @@
+﻿#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0012.h"
+#include "StaticRingBuf_Lz.h"
+
+#define LZ_CAP          256
+#define BLOCK_COUNT     4
+#define BLOCK_MAX       200
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Lz LZ = { 0 };                         // Compressed block ring instance
+static byte STOBUF[2 * LZ_CAP] = { 0 };             // Compressed storage buffer
+static STARB_LzBlock BLOCKS[BLOCK_COUNT] = { 0 };   // Block index
+static byte SCRATCH[BLOCK_MAX] = { 0 };             // Compression scratch
+
+/** @par Private (Static) functions declaration
+ */
+
+static void Make_Telemetry(byte* block, const int seed);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0012_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0012_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0026_STARB_Lz_Blocks(void)
+{
+    byte raw[BLOCK_MAX] = { 0 };
+    byte packed[BLOCK_MAX] = { 0 };
+    byte result[BLOCK_MAX] = { 0 };
+    STARB_CAPTYPE rawlen = 0;
+
+    // Codec round trip; repetitive telemetry shrinks well
+
+    Make_Telemetry(raw, 0);
+    STARB_CAPTYPE clen = STARB_Lz_Compress(raw, BLOCK_MAX, packed, BLOCK_MAX, LZ.table);
+    CU_ASSERT(clen > 0 && clen < BLOCK_MAX / 3);
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(packed, clen, result, BLOCK_MAX), BLOCK_MAX);
+    CU_ASSERT(memcmp(result, raw, BLOCK_MAX) == 0);
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(packed, clen, result, BLOCK_MAX - 1), 0);
+    CU_ASSERT_EQUAL(STARB_Lz_Compress(raw, BLOCK_MAX, packed, clen - 1, LZ.table), 0);
+
+    // Hand-made block: "abcd", match (offset 4, length 4), "e"
+
+    byte crafted[] = { 0x40, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x10, 'e' };
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(crafted, sizeof(crafted), result, BLOCK_MAX), 9);
+    CU_ASSERT(memcmp(result, "abcdabcde", 9) == 0);
+
+    // Corrupt offset: refused, not followed outside the output
+
+    crafted[5] = 0x05;
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(crafted, sizeof(crafted), result, BLOCK_MAX), 0);
+    crafted[5] = 0x00;
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(crafted, sizeof(crafted), result, BLOCK_MAX), 0);
+    crafted[5] = 0x04;
+
+    // Truncated input: inside the literals, inside the offset, after the match
+
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(crafted, 3, result, BLOCK_MAX), 0);
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(crafted, 6, result, BLOCK_MAX), 0);
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(crafted, 7, result, BLOCK_MAX), 0);
+    CU_ASSERT_EQUAL(STARB_Lz_Decompress(packed, clen - 1, result, BLOCK_MAX), 0);
+
+    // Compressed ring: 3 x 200 raw bytes held in 256 bytes of storage
+
+    uint8_t rc = STARB_Lz_Init(&LZ, 2 * LZ_CAP, STOBUF, BLOCKS, BLOCK_COUNT, SCRATCH, LZ_CAP + 1, STARB_LZ_DEFAULT);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Lz_Init(&LZ, 2 * LZ_CAP, STOBUF, BLOCKS, BLOCK_COUNT, SCRATCH, BLOCK_MAX, STARB_LZ_DEFAULT);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        Make_Telemetry(raw, i);
+        CU_ASSERT_EQUAL(STARB_Lz_Write(&LZ, raw, BLOCK_MAX), STARB_OK);
+    }
+    CU_ASSERT_EQUAL(LZ.rawbytes, 3 * BLOCK_MAX);
+    CU_ASSERT(StaticRingBuf_GetReadCapacity(&LZ.rbuf) < LZ_CAP / 2);
+
+    // Incompressible block is stored as it is
+
+    for (int i = 0; i < BLOCK_MAX; i++)
+    {
+        raw[i] = (byte)(i * 151 + (i >> 3) * 77);
+    }
+    CU_ASSERT_EQUAL(STARB_Lz_Write(&LZ, raw, 40), STARB_OK);
+    CU_ASSERT_EQUAL(BLOCKS[3].clen, 40);
+    CU_ASSERT_EQUAL(STARB_Lz_Write(&LZ, raw, 10), STARB_BUFOVERFLOW);
+    CU_ASSERT_EQUAL(STARB_Lz_Write(&LZ, raw, BLOCK_MAX + 1), STARB_PARAMOUTRANGE);
+
+    // Skip a whole block without decoding, then read the next ones back
+
+    CU_ASSERT_EQUAL(STARB_Lz_Skip(&LZ, 1), 1);
+    CU_ASSERT_EQUAL(STARB_Lz_PeekRawLen(&LZ), BLOCK_MAX);
+    CU_ASSERT_EQUAL(STARB_Lz_Read(&LZ, result, BLOCK_MAX - 1, &rawlen), STARB_PARAMOUTRANGE);
+    for (int i = 1; i < 3; i++)
+    {
+        Make_Telemetry(packed, i);
+        CU_ASSERT_EQUAL(STARB_Lz_Read(&LZ, result, BLOCK_MAX, &rawlen), STARB_OK);
+        CU_ASSERT_EQUAL(rawlen, BLOCK_MAX);
+        CU_ASSERT(memcmp(result, packed, BLOCK_MAX) == 0);
+    }
+    CU_ASSERT_EQUAL(STARB_Lz_Read(&LZ, result, BLOCK_MAX, &rawlen), STARB_OK);
+    CU_ASSERT_EQUAL(rawlen, 40);
+    CU_ASSERT(memcmp(result, raw, 40) == 0);
+    CU_ASSERT_EQUAL(STARB_Lz_Read(&LZ, result, BLOCK_MAX, &rawlen), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(LZ.rawbytes, 0);
+
+    // Overwrite mode: the newest blocks are kept
+
+    rc = STARB_Lz_Init(&LZ, 2 * LZ_CAP, STOBUF, BLOCKS, BLOCK_COUNT, SCRATCH, BLOCK_MAX, STARB_LZ_OVERWRITE);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    for (int i = 0; i < 6; i++)
+    {
+        Make_Telemetry(raw, i);
+        CU_ASSERT_EQUAL(STARB_Lz_Write(&LZ, raw, BLOCK_MAX), STARB_OK);
+    }
+    CU_ASSERT_EQUAL(LZ.num, BLOCK_COUNT);
+    Make_Telemetry(raw, 2);
+    CU_ASSERT_EQUAL(STARB_Lz_Read(&LZ, result, BLOCK_MAX, &rawlen), STARB_OK);
+    CU_ASSERT(memcmp(result, raw, BLOCK_MAX) == 0);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Fill a block with sensor lines, slowly changing values. */
+static void Make_Telemetry(byte* block, const int seed)
+{
+    char line[32];
+    int pos = 0;
+
+    for (int i = 0; pos < BLOCK_MAX; i++)
+    {
+        int len = snprintf(line, sizeof(line), "T=21.%d;H=4%d;P=1013\n", (seed + i / 4) % 10, seed % 3);
+        for (int j = 0; j < len && pos < BLOCK_MAX; j++)
+        {
+            block[pos++] = (byte)line[j];
+        }
+    }
+}
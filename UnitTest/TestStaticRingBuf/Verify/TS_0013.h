@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0013_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0013_H
+
+#define TS_0013_Identifier "TS_0013: STARB_Delta"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0013_Setup(void);
+    int TS_0013_Cleanup(void);
+
+    void TC0027_STARB_Delta_Samples(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0013_H
@@ -0,0 +1,124 @@
+﻿#include <stdint.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0013.h"
+#include "StaticRingBuf_Delta.h"
+
+#define DELTA_CAP       512
+#define KEY_COUNT       4
+#define KEY_INTERVAL    32
+#define SAMPLE_COUNT    200
+
+/** @par Private (Static) data declaration
+ */
+
+static STARB_Delta DELTA = { 0 };                   // Delta sample stream instance
+static byte STOBUF[2 * DELTA_CAP] = { 0 };          // Encoded storage buffer
+static STARB_DeltaKey KEYS[KEY_COUNT] = { 0 };      // Keyframe index
+
+/** @par Private (Static) functions declaration
+ */
+
+static int32_t Make_Sample(const int index);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0013_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0013_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0027_STARB_Delta_Samples(void)
+{
+    int32_t samples[SAMPLE_COUNT] = { 0 };
+    int32_t result[SAMPLE_COUNT] = { 0 };
+    uint32_t written = 0;
+    uint32_t readcount = 0;
+
+    uint8_t rc = STARB_Delta_Init(&DELTA, 2 * DELTA_CAP, STOBUF, 2, KEY_INTERVAL, KEYS, KEY_COUNT);
+    CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+    rc = STARB_Delta_Init(&DELTA, 2 * DELTA_CAP, STOBUF, STARB_DELTA_I32, KEY_INTERVAL, KEYS, KEY_COUNT);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    // Slowly changing samples take about 1 byte each
+
+    for (int i = 0; i < SAMPLE_COUNT; i++)
+    {
+        samples[i] = Make_Sample(i);
+    }
+    CU_ASSERT_EQUAL(STARB_Delta_Write(&DELTA, samples, SAMPLE_COUNT, &written), STARB_OK);
+    CU_ASSERT_EQUAL(written, SAMPLE_COUNT);
+    CU_ASSERT(StaticRingBuf_GetReadCapacity(&DELTA.rbuf) < SAMPLE_COUNT + 7 * 3);
+    CU_ASSERT_EQUAL(STARB_Delta_GetSampleCount(&DELTA), SAMPLE_COUNT);
+    CU_ASSERT_EQUAL(DELTA.keynum, KEY_COUNT);
+
+    // Bulk decode across keyframes, in uneven batches
+
+    CU_ASSERT_EQUAL(STARB_Delta_Read(&DELTA, result, 5, &readcount), STARB_OK);
+    CU_ASSERT_EQUAL(readcount, 5);
+    CU_ASSERT_EQUAL(STARB_Delta_Read(&DELTA, result + 5, 90, &readcount), STARB_OK);
+    CU_ASSERT_EQUAL(readcount, 90);
+    CU_ASSERT(memcmp(result, samples, 95 * sizeof(int32_t)) == 0);
+
+    // Random access: jump to the keyframe at 128, then decode on to 150
+
+    CU_ASSERT_EQUAL(STARB_Delta_Seek(&DELTA, 94), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Delta_Seek(&DELTA, SAMPLE_COUNT + 1), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Delta_Seek(&DELTA, 150), STARB_OK);
+    CU_ASSERT_EQUAL(DELTA.keys[DELTA.keyfirst].seq, 160);
+    CU_ASSERT_EQUAL(STARB_Delta_Read(&DELTA, result, SAMPLE_COUNT, &readcount), STARB_OK);
+    CU_ASSERT_EQUAL(readcount, SAMPLE_COUNT - 150);
+    CU_ASSERT(memcmp(result, samples + 150, readcount * sizeof(int32_t)) == 0);
+    CU_ASSERT_EQUAL(STARB_Delta_Read(&DELTA, result, 1, &readcount), STARB_NOENOUGHDAT);
+
+    // Extremes: full range jumps are multi-byte varints
+
+    samples[0] = INT32_MAX;
+    samples[1] = INT32_MIN;
+    samples[2] = 0;
+    samples[3] = -1;
+    CU_ASSERT_EQUAL(STARB_Delta_Write(&DELTA, samples, 4, &written), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Delta_Read(&DELTA, result, 4, &readcount), STARB_OK);
+    CU_ASSERT(memcmp(result, samples, 4 * sizeof(int32_t)) == 0);
+
+    // 64-bit samples; a full ring takes what fits
+
+    int64_t wide[SAMPLE_COUNT] = { 0 };
+    int64_t wideresult[SAMPLE_COUNT] = { 0 };
+    rc = STARB_Delta_Init(&DELTA, 2 * DELTA_CAP, STOBUF, STARB_DELTA_I64, KEY_INTERVAL, KEYS, KEY_COUNT);
+    CU_ASSERT_EQUAL(rc, STARB_OK);
+    for (int i = 0; i < SAMPLE_COUNT; i++)
+    {
+        wide[i] = (i & 1) ? INT64_MIN + i : INT64_MAX - i * 1000003;
+    }
+    CU_ASSERT_EQUAL(STARB_Delta_Write(&DELTA, wide, SAMPLE_COUNT, &written), STARB_BUFOVERFLOW);
+    CU_ASSERT(written > 0 && written < SAMPLE_COUNT);
+    CU_ASSERT_EQUAL(STARB_Delta_Read(&DELTA, wideresult, SAMPLE_COUNT, &readcount), STARB_OK);
+    CU_ASSERT_EQUAL(readcount, written);
+    CU_ASSERT(memcmp(wideresult, wide, written * sizeof(int64_t)) == 0);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Slowly drifting sensor value with a step every 50 samples. */
+static int32_t Make_Sample(const int index)
+{
+    return 20000 + (index % 13) * 3 - (index / 50) * 400;
+}
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0014_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0014_H
+
+#define TS_0014_Identifier "TS_0014: STARB_Stats"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0014_Setup(void);
+    int TS_0014_Cleanup(void);
+
+    void TC0030_STARB_Stats_Window(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0014_H
@@ -0,0 +1,174 @@
+﻿#include <stdint.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0014.h"
+#include "StaticRingBuf_Stats.h"
+#include "StaticRingBuf_Inline.h"
+
+#define STATS_CAP       64
+#define QUEUE_COUNT     (STATS_CAP / 2 + 1)
+
+/** @par Private (Static) data declaration
+ */
+
+static StaticRingBuf RBUF = { 0 };                  // Observed ring instance
+static byte STOBUF[2 * STATS_CAP] = { 0 };          // Ring storage buffer
+static STARB_Stats STATS = { 0 };                   // Statistics instance
+static STARB_StatsEntry MINQ[QUEUE_COUNT] = { 0 };  // Min candidates
+static STARB_StatsEntry MAXQ[QUEUE_COUNT] = { 0 };  // Max candidates
+
+/** @par Private (Static) functions declaration
+ */
+
+static bool Verify_Stats(void);
+static void Log_Ignore(STARB_Lostdata* log);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0014_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0014_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0030_STARB_Stats_Window(void)
+{
+    int16_t samples[STATS_CAP / 2] = { 0 };
+    byte scratch[STATS_CAP] = { 0 };
+    STARB_StatsResult result = { 0 };
+    STARB_Lostdata lost = { 0 };
+    uint32_t seed = 12345;
+    uint32_t mismatches = 0;
+
+    uint8_t rc = StaticRingBuf_Init(&RBUF, 2 * STATS_CAP, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    // Samples already buffered are counted at init
+
+    samples[0] = -7;
+    samples[1] = 300;
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, (byte*)samples, 4), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stats_Init(&STATS, &RBUF, STARB_STATS_I16, MINQ, MAXQ, QUEUE_COUNT - 1), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Stats_Init(&STATS, &RBUF, 0x83, MINQ, MAXQ, QUEUE_COUNT), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Stats_Init(&STATS, &RBUF, STARB_STATS_I16, MINQ, MAXQ, QUEUE_COUNT), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stats_Get(&STATS, &result), STARB_OK);
+    CU_ASSERT_EQUAL(result.count, 2);
+    CU_ASSERT_EQUAL(result.sum, 293);
+    CU_ASSERT_EQUAL(result.min, -7);
+    CU_ASSERT_EQUAL(result.max, 300);
+    CU_ASSERT_EQUAL(result.mean, 146);
+
+    // Random traffic through every path; compare with a full recomputation
+
+    for (int step = 0; step < 3000; step++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t op = (seed >> 16) % 6;
+        STARB_CAPTYPE n = (STARB_CAPTYPE)(2 * (1 + (seed >> 8) % 8));
+        for (STARB_CAPTYPE idx = 0; idx < n / 2; idx++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            samples[idx] = (int16_t)((seed >> 12) % 2001) - 1000;
+        }
+
+        switch (op)
+        {
+        case 0:
+            StaticRingBuf_WriteItems(&RBUF, (byte*)samples, n);
+            break;
+        case 1:
+            /* One sample split over two byte writes */
+            if (StaticRingBuf_GetWriteCapacity(&RBUF) >= 2)
+            {
+                StaticRingBuf_Write(&RBUF, ((byte*)samples)[0]);
+                StaticRingBuf_Write(&RBUF, ((byte*)samples)[1]);
+            }
+            break;
+        case 2:
+            StaticRingBuf_ForceWriteItemsWithLog(&RBUF, (byte*)samples, n, &lost, Log_Ignore);
+            break;
+        case 3:
+            StaticRingBuf_ReadItems(&RBUF, scratch, n);
+            break;
+        case 4:
+            StaticRingBuf_Forward(&RBUF, n);
+            break;
+        default:
+            /* Inline API: falls back to the checked path while observed */
+            if (StaticRingBuf_GetWriteCapacity(&RBUF) >= 2)
+            {
+                StaticRingBuf_TryPushByte(&RBUF, ((byte*)samples)[0]);
+                StaticRingBuf_TryPushByte(&RBUF, ((byte*)samples)[1]);
+            }
+            break;
+        }
+
+        if (!Verify_Stats())
+        {
+            mismatches++;
+        }
+    }
+    CU_ASSERT_EQUAL(mismatches, 0);
+
+    // Empty ring; detached statistics no longer follow the ring
+
+    StaticRingBuf_Forward(&RBUF, StaticRingBuf_GetReadCapacity(&RBUF));
+    CU_ASSERT_EQUAL(STARB_Stats_Get(&STATS, &result), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(result.count, 0);
+    CU_ASSERT_EQUAL(STARB_Stats_Detach(&STATS), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stats_Detach(&STATS), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, (byte*)samples, 4), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Stats_Get(&STATS, &result), STARB_NOENOUGHDAT);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Recompute the statistics over the ring contents and compare. */
+static bool Verify_Stats(void)
+{
+    int16_t samples[STATS_CAP / 2] = { 0 };
+    STARB_StatsResult result = { 0 };
+    STARB_CAPTYPE count = StaticRingBuf_GetReadCapacity(&RBUF) / 2;
+    count = (count < STATS_CAP / 2) ? count : STATS_CAP / 2;
+    int64_t sum = 0;
+    int64_t min = INT64_MAX;
+    int64_t max = INT64_MIN;
+
+    StaticRingBuf_PeekItems(&RBUF, (byte*)samples, (STARB_CAPTYPE)(count * 2));
+    for (STARB_CAPTYPE idx = 0; idx < count; idx++)
+    {
+        sum += samples[idx];
+        min = (samples[idx] < min) ? samples[idx] : min;
+        max = (samples[idx] > max) ? samples[idx] : max;
+    }
+
+    if (STARB_Stats_Get(&STATS, &result) != STARB_OK)
+    {
+        return count == 0;
+    }
+
+    return result.count == count && result.sum == sum && result.min == min && result.max == max &&
+        result.mean == sum / (int64_t)count;
+}
+
+/** @brief Lost data log callback: overwritten samples are accounted by the observer. */
+static void Log_Ignore(STARB_Lostdata* log)
+{
+    (void)log;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0015_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0015_H
+
+#define TS_0015_Identifier "TS_0015: STARB_Chunk"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0015_Setup(void);
+    int TS_0015_Cleanup(void);
+
+    void TC0031_STARB_Chunk_Boundaries(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0015_H
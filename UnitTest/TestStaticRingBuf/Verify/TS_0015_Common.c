@@ -0,0 +1,215 @@
+﻿#include <stdint.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0015.h"
+#include "StaticRingBuf_Chunk.h"
+
+#define CHUNK_CAP       2048
+#define CHUNK_MIN       64
+#define CHUNK_AVG       256
+#define CHUNK_MAX       1024
+#define CUT_COUNT       (CHUNK_CAP / CHUNK_MIN + 1)
+#define STREAM_LEN      20000
+#define CHUNK_LIMIT     (STREAM_LEN / CHUNK_MIN + 2)
+
+/** @par Private (Static) data declaration
+ */
+
+static StaticRingBuf RBUF = { 0 };                  // Observed ring instance
+static byte STOBUF[2 * CHUNK_CAP] = { 0 };          // Ring storage buffer
+static STARB_Chunk CHUNK = { 0 };                   // Chunker instance
+static uint32_t CUTS[CUT_COUNT] = { 0 };            // Boundary queue
+static byte STREAM[STREAM_LEN + 1] = { 0 };         // Source stream (+1: shifted copy)
+static uint32_t LENGTHS_A[CHUNK_LIMIT] = { 0 };     // Chunk lengths, run A
+static uint32_t LENGTHS_B[CHUNK_LIMIT] = { 0 };     // Chunk lengths, run B
+
+/** @par Private (Static) functions declaration
+ */
+
+static uint32_t Run_Chunker(const uint8_t mode, const byte* stream, const uint32_t len,
+    uint32_t seed, uint32_t* lengths, uint32_t* chunkcount);
+static uint32_t Count_Shared_Ends(const uint32_t* lengths_a, const uint32_t count_a,
+    const uint32_t* lengths_b, const uint32_t count_b, const uint32_t shift);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0015_Setup(void)
+{
+    uint32_t seed = 2026;
+
+    for (uint32_t idx = 0; idx < STREAM_LEN; idx++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        STREAM[idx] = (byte)(seed >> 16);
+    }
+
+    return CUE_SUCCESS;
+}
+
+int TS_0015_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0031_STARB_Chunk_Boundaries(void)
+{
+    byte scratch[16] = { 0 };
+    STARB_Span spans[2];
+    STARB_CAPTYPE offset = 0;
+    STARB_CAPTYPE before = 0;
+    uint32_t count_a = 0;
+    uint32_t count_b = 0;
+
+    uint8_t rc = StaticRingBuf_Init(&RBUF, 2 * CHUNK_CAP, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    // Parameter checks
+
+    CU_ASSERT_EQUAL(STARB_Chunk_Init(&CHUNK, &RBUF, CHUNK_MIN, 300, CHUNK_MAX, CUTS, CUT_COUNT), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Chunk_Init(&CHUNK, &RBUF, 0, CHUNK_AVG, CHUNK_MAX, CUTS, CUT_COUNT), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Chunk_Init(&CHUNK, &RBUF, CHUNK_MIN, CHUNK_AVG, CHUNK_CAP + 1, CUTS, CUT_COUNT), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Chunk_Init(&CHUNK, &RBUF, CHUNK_MIN, CHUNK_AVG, CHUNK_MAX, CUTS, CUT_COUNT - 1), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Chunk_Init(&CHUNK, &RBUF, CHUNK_MIN, CHUNK_AVG, CHUNK_MAX, NULL, CUT_COUNT), STARB_PARAM_NULL);
+
+    // Bytes already buffered are chunked at init; offsets follow the read position
+
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, STREAM, CHUNK_CAP), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Chunk_Init(&CHUNK, &RBUF, CHUNK_MIN, CHUNK_AVG, CHUNK_MAX, CUTS, CUT_COUNT), STARB_OK);
+    CU_ASSERT(STARB_Chunk_GetCount(&CHUNK) > 0);
+    CU_ASSERT_EQUAL(STARB_Chunk_GetBoundary(&CHUNK, STARB_Chunk_GetCount(&CHUNK), &offset), STARB_NOENOUGHDAT);
+    CU_ASSERT_EQUAL(STARB_Chunk_GetBoundary(&CHUNK, 0, &before), STARB_OK);
+    CU_ASSERT(before >= CHUNK_MIN && before <= CHUNK_MAX);
+    CU_ASSERT_EQUAL(StaticRingBuf_ReadItems(&RBUF, scratch, sizeof(scratch)), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Chunk_GetBoundary(&CHUNK, 0, &offset), STARB_OK);
+    CU_ASSERT_EQUAL(offset, before - sizeof(scratch));
+    CU_ASSERT_EQUAL(STARB_Chunk_Acquire(&CHUNK, spans), 1);
+    CU_ASSERT_PTR_EQUAL(spans[0].ptr, StaticRingBuf_GetReadPtr(&RBUF));
+    CU_ASSERT_EQUAL(spans[0].len, offset);
+    CU_ASSERT_EQUAL(STARB_Chunk_Release(&CHUNK), STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&RBUF), CHUNK_CAP - before);
+    CU_ASSERT_EQUAL(STARB_Chunk_Detach(&CHUNK), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Chunk_Detach(&CHUNK), STARB_PARAMOUTRANGE);
+
+    // Same stream, different write sizes, ring sizes and storage modes: same chunks
+
+    CU_ASSERT_EQUAL(Run_Chunker(STARB_MODE_DEFAULT, STREAM, STREAM_LEN, 1, LENGTHS_A, &count_a), 0);
+    CU_ASSERT_EQUAL(Run_Chunker(STARB_MODE_NOMIRROR, STREAM, STREAM_LEN, 7, LENGTHS_B, &count_b), 0);
+    CU_ASSERT(count_a > STREAM_LEN / CHUNK_MAX);
+    CU_ASSERT_EQUAL(count_a, count_b);
+    CU_ASSERT(memcmp(LENGTHS_A, LENGTHS_B, count_a * sizeof(uint32_t)) == 0);
+
+    // One byte inserted at the front: boundaries resynchronize after a few chunks
+
+    memmove(STREAM + 1, STREAM, STREAM_LEN);
+    STREAM[0] = 0x5A;
+    CU_ASSERT_EQUAL(Run_Chunker(STARB_MODE_DEFAULT, STREAM, STREAM_LEN + 1, 3, LENGTHS_B, &count_b), 0);
+    CU_ASSERT(Count_Shared_Ends(LENGTHS_A, count_a, LENGTHS_B, count_b, 1) + 3 >= count_a);
+    memmove(STREAM, STREAM + 1, STREAM_LEN);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief   Stream `stream` through a chunked ring in random write sizes.
+ *  @details Complete chunks are acquired, checked against the source and
+ *           released; the tail is flushed at the end.
+ *  @return Count of failed checks
+ */
+static uint32_t Run_Chunker(const uint8_t mode, const byte* stream, const uint32_t len,
+    uint32_t seed, uint32_t* lengths, uint32_t* chunkcount)
+{
+    STARB_Span spans[2];
+    uint32_t written = 0;
+    uint32_t consumed = 0;
+    uint32_t failures = 0;
+    uint8_t count;
+
+    *chunkcount = 0;
+
+    /* NOMIRROR: a 1500 bytes ring, so chunks wrap at varying places */
+    if (mode == STARB_MODE_NOMIRROR)
+    {
+        failures += StaticRingBuf_InitMode(&RBUF, 1500, STOBUF, STARB_MODE_NOMIRROR) != STARB_OK;
+    }
+    else
+    {
+        failures += StaticRingBuf_Init(&RBUF, 2 * CHUNK_CAP, STOBUF) != STARB_OK;
+    }
+    failures += STARB_Chunk_Init(&CHUNK, &RBUF, CHUNK_MIN, CHUNK_AVG, CHUNK_MAX, CUTS, CUT_COUNT) != STARB_OK;
+
+    while (consumed < len && failures == 0)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t n = 1 + (seed >> 16) % 300;
+        n = (n < len - written) ? n : len - written;
+        n = (n < StaticRingBuf_GetWriteCapacity(&RBUF)) ? n : StaticRingBuf_GetWriteCapacity(&RBUF);
+        if (n > 0)
+        {
+            failures += StaticRingBuf_WriteItems(&RBUF, (byte*)stream + written, (STARB_CAPTYPE)n) != STARB_OK;
+            written += n;
+        }
+
+        if (written == len)
+        {
+            failures += STARB_Chunk_Flush(&CHUNK) != STARB_OK;
+        }
+
+        while ((count = STARB_Chunk_Acquire(&CHUNK, spans)) > 0)
+        {
+            uint32_t length = 0;
+            for (uint8_t idx = 0; idx < count; idx++)
+            {
+                failures += memcmp(spans[idx].ptr, stream + consumed + length, spans[idx].len) != 0;
+                length += spans[idx].len;
+            }
+
+            /* Every chunk but the flushed tail respects the size limits */
+            if (consumed + length < len)
+            {
+                failures += length < CHUNK_MIN || length > CHUNK_MAX;
+            }
+
+            lengths[(*chunkcount)++] = length;
+            consumed += length;
+            failures += STARB_Chunk_Release(&CHUNK) != STARB_OK;
+        }
+    }
+
+    failures += consumed != len;
+    failures += STARB_Chunk_Detach(&CHUNK) != STARB_OK;
+
+    return failures;
+}
+
+/** @brief Count the chunk ends of run A found in run B (positions shifted by `shift`). */
+static uint32_t Count_Shared_Ends(const uint32_t* lengths_a, const uint32_t count_a,
+    const uint32_t* lengths_b, const uint32_t count_b, const uint32_t shift)
+{
+    uint32_t end_a = 0;
+    uint32_t end_b = 0;
+    uint32_t idx_b = 0;
+    uint32_t shared = 0;
+
+    for (uint32_t idx_a = 0; idx_a < count_a; idx_a++)
+    {
+        end_a += lengths_a[idx_a];
+        while (idx_b < count_b && end_b < end_a + shift)
+        {
+            end_b += lengths_b[idx_b++];
+        }
+        shared += (end_b == end_a + shift);
+    }
+
+    return shared;
+}
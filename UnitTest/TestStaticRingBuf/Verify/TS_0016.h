@@ -0,0 +1,20 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0016_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0016_H
+
+#define TS_0016_Identifier "TS_0016: starb::Ring"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0016_Setup(void);
+    int TS_0016_Cleanup(void);
+
+    void TC0032_STARB_Coro_Streams(void);
+    void TC0037_STARB_Coro_Bypass(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0016_H
@@ -0,0 +1,257 @@
+﻿#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include "CUnit/CUnit.h"
+#include "TS_0016.h"
+#include "StaticRingBuf.hpp"
+
+#define CORO_CAP        64
+#define CORO_MESSAGES   300
+#define STREAM_COUNT    200
+#define STREAM_CAP      32
+
+/** @par Private (Static) data declaration
+ */
+
+/** @brief Fire-and-forget coroutine: runs at once, frees its frame when done */
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() noexcept { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+    };
+};
+
+static std::deque<std::coroutine_handle<>> READY;   // Executor run queue
+static uint32_t POSTED = 0;                         // Count of posted resumptions
+static uint32_t DONE = 0;                           // Count of finished coroutines
+static uint32_t FAILURES = 0;                       // Count of failed checks
+
+static StaticRingBuf RBUF = {};                     // Single stream ring
+static byte STOBUF[2 * CORO_CAP] = { 0 };           // Single stream storage
+static StaticRingBuf STREAMS[STREAM_COUNT];         // Many small rings
+static byte STREAMBUF[STREAM_COUNT][2 * STREAM_CAP]; // Their storage
+
+/** @par Private (Static) functions declaration
+ */
+
+static void Post(void* context, std::coroutine_handle<> handle);
+static void Run_Executor(void);
+static uint32_t Message_Size(const uint32_t seq);
+static byte Message_Byte(const uint32_t seq, const uint32_t idx);
+static Task Producer(starb::Ring* ring, uint32_t messages);
+static Task Consumer(starb::Ring* ring, uint32_t messages);
+static Task Read_Once(starb::Ring* ring, byte* outbuf, uint32_t size, uint8_t* rc);
+static Task Write_Once(starb::Ring* ring, const byte* srcbuf, uint32_t size, uint8_t* rc);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0016_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0016_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0032_STARB_Coro_Streams(void)
+{
+    byte message[CORO_CAP + 1] = { 0 };
+    byte filler[9] = { 0 };
+    uint8_t rc = STARB_OK;
+
+    // One stream: messages larger than half the ring force both sides to suspend
+
+    CU_ASSERT_EQUAL(StaticRingBuf_Init(&RBUF, sizeof(STOBUF), STOBUF), STARB_OK);
+    {
+        starb::Ring ring(RBUF, Post, nullptr);
+
+        POSTED = DONE = FAILURES = 0;
+        Consumer(&ring, CORO_MESSAGES);
+        Producer(&ring, CORO_MESSAGES);
+        Run_Executor();
+        CU_ASSERT_EQUAL(DONE, 2);
+        CU_ASSERT_EQUAL(FAILURES, 0);
+        CU_ASSERT(POSTED > CORO_MESSAGES / 4);
+        CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&RBUF), 0);
+
+        // A transfer that can never fit resumes at once
+
+        Read_Once(&ring, message, CORO_CAP + 1, &rc);
+        CU_ASSERT_EQUAL(rc, STARB_PARAMOUTRANGE);
+
+        // A commit through the C API resumes a suspended reader
+
+        rc = 0;
+        Read_Once(&ring, message, 10, &rc);
+        CU_ASSERT_EQUAL(rc, 0);
+        CU_ASSERT(READY.empty());
+        CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, filler, sizeof(filler)), STARB_OK);
+        CU_ASSERT(READY.empty());
+        CU_ASSERT_EQUAL(StaticRingBuf_Write(&RBUF, 0x5A), STARB_OK);
+        CU_ASSERT_EQUAL(READY.size(), 1);
+        CU_ASSERT_EQUAL(rc, 0);
+        Run_Executor();
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        CU_ASSERT_EQUAL(message[9], 0x5A);
+    }
+    CU_ASSERT_PTR_NULL(RBUF.observer);
+
+    // Many streams share one executor thread
+
+    {
+        std::deque<starb::Ring> rings;
+
+        POSTED = DONE = FAILURES = 0;
+        for (uint32_t idx = 0; idx < STREAM_COUNT; idx++)
+        {
+            StaticRingBuf_Init(&STREAMS[idx], 2 * STREAM_CAP, STREAMBUF[idx]);
+            rings.emplace_back(STREAMS[idx], Post, nullptr);
+            Consumer(&rings.back(), 20);
+            Producer(&rings.back(), 20);
+        }
+        Run_Executor();
+        CU_ASSERT_EQUAL(DONE, 2 * STREAM_COUNT);
+        CU_ASSERT_EQUAL(FAILURES, 0);
+        rings.clear();
+    }
+}
+
+void TC0037_STARB_Coro_Bypass(void)
+{
+    byte message[CORO_CAP] = { 0 };
+    byte other[CORO_CAP] = { 0 };
+    uint8_t first = 0;
+    uint8_t second = 0;
+
+    CU_ASSERT_EQUAL(StaticRingBuf_Init(&RBUF, sizeof(STOBUF), STOBUF), STARB_OK);
+    {
+        starb::Ring ring(RBUF, Post, nullptr);
+
+        // Reader side: a C API read takes the bytes reserved for a posted reader
+
+        Read_Once(&ring, message, 10, &first);
+        Read_Once(&ring, other, 3, &second);
+        CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, message, 10), STARB_OK);
+        CU_ASSERT_EQUAL(READY.size(), 1);
+        CU_ASSERT_EQUAL(StaticRingBuf_ReadItems(&RBUF, message, 5), STARB_OK);
+        CU_ASSERT_EQUAL(READY.size(), 1);
+        Run_Executor();
+        CU_ASSERT_EQUAL(first, STARB_NOENOUGHDAT);
+        CU_ASSERT_EQUAL(second, STARB_OK);
+        CU_ASSERT_EQUAL(StaticRingBuf_GetReadCapacity(&RBUF), 2);
+
+        // Writer side: a C API write takes the space reserved for a posted writer
+
+        first = second = 0;
+        CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, message, CORO_CAP - 2), STARB_OK);
+        Write_Once(&ring, message, 10, &first);
+        Write_Once(&ring, other, 3, &second);
+        CU_ASSERT_EQUAL(StaticRingBuf_ReadItems(&RBUF, message, 10), STARB_OK);
+        CU_ASSERT_EQUAL(READY.size(), 1);
+        CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, message, 5), STARB_OK);
+        CU_ASSERT_EQUAL(READY.size(), 1);
+        Run_Executor();
+        CU_ASSERT_EQUAL(first, STARB_BUFOVERFLOW);
+        CU_ASSERT_EQUAL(second, STARB_OK);
+        CU_ASSERT_EQUAL(StaticRingBuf_GetWriteCapacity(&RBUF), 2);
+    }
+    CU_ASSERT_PTR_NULL(RBUF.observer);
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Executor hook: queue the handle. */
+static void Post(void* context, std::coroutine_handle<> handle)
+{
+    (void)context;
+    POSTED++;
+    READY.push_back(handle);
+}
+
+/** @brief Resume queued coroutines until none is left. */
+static void Run_Executor(void)
+{
+    while (!READY.empty())
+    {
+        std::coroutine_handle<> handle = READY.front();
+        READY.pop_front();
+        handle.resume();
+    }
+}
+
+/** @brief Size of message `seq` (1 ~ 48 bytes, clamped to the ring capacity by the callers). */
+static uint32_t Message_Size(const uint32_t seq)
+{
+    return 1 + (seq * 37 + 11) % 48;
+}
+
+/** @brief Content of byte `idx` of message `seq`. */
+static byte Message_Byte(const uint32_t seq, const uint32_t idx)
+{
+    return static_cast<byte>(seq * 31 + idx * 7);
+}
+
+/** @brief Write `messages` messages, clamped to the ring capacity. */
+static Task Producer(starb::Ring* ring, uint32_t messages)
+{
+    byte message[CORO_CAP] = { 0 };
+
+    for (uint32_t seq = 0; seq < messages; seq++)
+    {
+        uint32_t size = Message_Size(seq);
+        size = (size < ring->native().capacity) ? size : ring->native().capacity;
+        for (uint32_t idx = 0; idx < size; idx++)
+        {
+            message[idx] = Message_Byte(seq, idx);
+        }
+
+        FAILURES += (co_await ring->write(std::span<const byte>(message, size))) != STARB_OK;
+    }
+
+    DONE++;
+}
+
+/** @brief Read `messages` messages and check their contents. */
+static Task Consumer(starb::Ring* ring, uint32_t messages)
+{
+    byte message[CORO_CAP] = { 0 };
+
+    for (uint32_t seq = 0; seq < messages; seq++)
+    {
+        uint32_t size = Message_Size(seq);
+        size = (size < ring->native().capacity) ? size : ring->native().capacity;
+
+        FAILURES += (co_await ring->read(std::span<byte>(message, size))) != STARB_OK;
+        for (uint32_t idx = 0; idx < size; idx++)
+        {
+            FAILURES += message[idx] != Message_Byte(seq, idx);
+        }
+    }
+
+    DONE++;
+}
+
+/** @brief Read `size` bytes once and store the status. */
+static Task Read_Once(starb::Ring* ring, byte* outbuf, uint32_t size, uint8_t* rc)
+{
+    *rc = co_await ring->read(std::span<byte>(outbuf, size));
+}
+
+/** @brief Write `size` bytes once and store the status. */
+static Task Write_Once(starb::Ring* ring, const byte* srcbuf, uint32_t size, uint8_t* rc)
+{
+    *rc = co_await ring->write(std::span<const byte>(srcbuf, size));
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+﻿#ifndef _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0017_H
+#define _INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0017_H
+
+#define TS_0017_Identifier "TS_0017: STARB_Watermark"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    int TS_0017_Setup(void);
+    int TS_0017_Cleanup(void);
+
+    void TC0033_STARB_Watermark_Edges(void);
+
+#ifdef __cplusplus
+} // ! extern "C"
+#endif
+
+#endif // !_INC_UNITTETST_TESTSTATICRINGBUF_VERIFY_TS_0017_H
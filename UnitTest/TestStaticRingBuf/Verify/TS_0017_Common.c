@@ -0,0 +1,164 @@
+﻿#include <stdint.h>
+#include <string.h>
+#include "CUnit/CUnit.h"
+#include "TS_0017.h"
+#include "StaticRingBuf_Watermark.h"
+
+#define WM_CAP          64
+#define WM_LOW          16
+#define WM_HIGH         48
+
+/** @par Private (Static) data declaration
+ */
+
+static StaticRingBuf RBUF = { 0 };                  // Observed ring instance
+static byte STOBUF[2 * WM_CAP] = { 0 };             // Ring storage buffer
+static STARB_Watermark WATERMARK = { 0 };           // Watermark instance
+static uint32_t HIGH_COUNT = 0;                     // Count of HIGH callbacks
+static uint32_t LOW_COUNT = 0;                      // Count of LOW callbacks
+
+/** @par Private (Static) functions declaration
+ */
+
+static void On_Watermark(STARB_Watermark* watermark, const uint8_t event, void* context);
+static void Log_Ignore(STARB_Lostdata* log);
+
+/** @par Public functions implementation: Test Suite
+ */
+
+int TS_0017_Setup(void)
+{
+    return CUE_SUCCESS;
+}
+
+int TS_0017_Cleanup(void)
+{
+    return CUE_SUCCESS;
+}
+
+/** @par Public functions implementation: Test Cases
+ */
+
+void TC0033_STARB_Watermark_Edges(void)
+{
+    byte scratch[WM_CAP] = { 0 };
+    STARB_Lostdata lost = { 0 };
+    uint32_t seed = 4242;
+    uint32_t mismatches = 0;
+    bool above = false;
+
+    uint8_t rc = StaticRingBuf_Init(&RBUF, 2 * WM_CAP, STOBUF);
+    if (rc != STARB_OK)
+    {
+        CU_ASSERT_EQUAL(rc, STARB_OK);
+        goto EXIT;
+    }
+
+    CU_ASSERT_EQUAL(STARB_Watermark_Init(&WATERMARK, &RBUF, WM_HIGH, WM_HIGH, On_Watermark, NULL), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Watermark_Init(&WATERMARK, &RBUF, WM_LOW, WM_CAP + 1, On_Watermark, NULL), STARB_PARAMOUTRANGE);
+    CU_ASSERT_EQUAL(STARB_Watermark_Init(&WATERMARK, &RBUF, WM_LOW, WM_HIGH, On_Watermark, &HIGH_COUNT), STARB_OK);
+
+    // Edges fire once; nothing fires between the watermarks
+
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, scratch, WM_HIGH - 1), STARB_OK);
+    CU_ASSERT_EQUAL(HIGH_COUNT, 0);
+    CU_ASSERT_EQUAL(StaticRingBuf_Write(&RBUF, 0x01), STARB_OK);
+    CU_ASSERT_EQUAL(HIGH_COUNT, 1);
+    CU_ASSERT(STARB_Watermark_IsAbove(&WATERMARK));
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, scratch, 8), STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_ReadItems(&RBUF, scratch, 8), STARB_OK);
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, scratch, 8), STARB_OK);
+    CU_ASSERT_EQUAL(HIGH_COUNT, 1);
+    CU_ASSERT_EQUAL(StaticRingBuf_Forward(&RBUF, WM_HIGH + 8 - WM_LOW - 1), STARB_OK);
+    CU_ASSERT_EQUAL(LOW_COUNT, 0);
+    CU_ASSERT_EQUAL(StaticRingBuf_Read(&RBUF, scratch), STARB_OK);
+    CU_ASSERT_EQUAL(LOW_COUNT, 1);
+    CU_ASSERT(!STARB_Watermark_IsAbove(&WATERMARK));
+    CU_ASSERT_EQUAL(StaticRingBuf_Forward(&RBUF, WM_LOW), STARB_OK);
+    CU_ASSERT_EQUAL(LOW_COUNT, 1);
+    CU_ASSERT_EQUAL(STARB_Watermark_TakeEvents(&WATERMARK), STARB_WATERMARK_HIGH | STARB_WATERMARK_LOW);
+    CU_ASSERT_EQUAL(STARB_Watermark_TakeEvents(&WATERMARK), 0);
+
+    // Random traffic: edges match a model evaluated after every call
+
+    HIGH_COUNT = LOW_COUNT = 0;
+    for (int step = 0; step < 3000; step++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        uint32_t op = (seed >> 16) % 5;
+        STARB_CAPTYPE n = (STARB_CAPTYPE)(1 + (seed >> 8) % 12);
+        uint32_t high_before = HIGH_COUNT;
+        uint32_t low_before = LOW_COUNT;
+
+        switch (op)
+        {
+        case 0:
+            StaticRingBuf_WriteItems(&RBUF, scratch, n);
+            break;
+        case 1:
+            StaticRingBuf_ForceWriteItemsWithLog(&RBUF, scratch, n, &lost, Log_Ignore);
+            break;
+        case 2:
+            StaticRingBuf_ReadItems(&RBUF, scratch, n);
+            break;
+        case 3:
+            StaticRingBuf_Forward(&RBUF, n);
+            break;
+        default:
+            StaticRingBuf_Write(&RBUF, 0x01);
+            break;
+        }
+
+        STARB_CAPTYPE occupancy = StaticRingBuf_GetReadCapacity(&RBUF);
+        bool rise = !above && occupancy >= WM_HIGH;
+        bool fall = above && occupancy <= WM_LOW;
+        above = rise ? true : (fall ? false : above);
+
+        mismatches += (HIGH_COUNT - high_before) != (uint32_t)rise;
+        mismatches += (LOW_COUNT - low_before) != (uint32_t)fall;
+        mismatches += STARB_Watermark_IsAbove(&WATERMARK) != above;
+    }
+    CU_ASSERT_EQUAL(mismatches, 0);
+    CU_ASSERT(HIGH_COUNT > 10);
+    CU_ASSERT(LOW_COUNT + 1 >= HIGH_COUNT);
+
+    // Flag bits only; a ring already above `high` starts above
+
+    CU_ASSERT_EQUAL(STARB_Watermark_Detach(&WATERMARK), STARB_OK);
+    StaticRingBuf_Forward(&RBUF, StaticRingBuf_GetReadCapacity(&RBUF));
+    CU_ASSERT_EQUAL(StaticRingBuf_WriteItems(&RBUF, scratch, WM_CAP), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Watermark_Init(&WATERMARK, &RBUF, WM_LOW, WM_HIGH, NULL, NULL), STARB_OK);
+    CU_ASSERT(STARB_Watermark_IsAbove(&WATERMARK));
+    CU_ASSERT_EQUAL(StaticRingBuf_ReadItems(&RBUF, scratch, WM_CAP - WM_LOW), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Watermark_TakeEvents(&WATERMARK), STARB_WATERMARK_LOW);
+    CU_ASSERT_EQUAL(STARB_Watermark_Detach(&WATERMARK), STARB_OK);
+    CU_ASSERT_EQUAL(STARB_Watermark_Detach(&WATERMARK), STARB_PARAMOUTRANGE);
+
+EXIT:
+    return;
+}
+
+/** @par Private (Static) functions implementation
+ */
+
+/** @brief Watermark callback: count the edges. */
+static void On_Watermark(STARB_Watermark* watermark, const uint8_t event, void* context)
+{
+    CU_ASSERT_PTR_EQUAL(watermark, &WATERMARK);
+    CU_ASSERT_PTR_EQUAL(context, &HIGH_COUNT);
+
+    if (event == STARB_WATERMARK_HIGH)
+    {
+        HIGH_COUNT++;
+    }
+    else
+    {
+        LOW_COUNT++;
+    }
+}
+
+/** @brief Lost data log callback: overwrites are not checked here. */
+static void Log_Ignore(STARB_Lostdata* log)
+{
+    (void)log;
+}